@@ -50,6 +50,15 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const PreferenceFlag AUTOMATIC_CHASE("Automatic chase");
+	const PreferenceFlag DAMAGED_FIGHTERS_RETREAT("Damaged fighters retreat");
+	const PreferenceFlag ESCORTS_EXPEND_AMMO("Escorts expend ammo");
+	const PreferenceFlag ESCORTS_USE_AMMO_FRUGALLY("Escorts use ammo frugally");
+	const PreferenceFlag FIGHTERS_TRANSFER_CARGO("Fighters transfer cargo");
+	const PreferenceFlag SHOW_BUTTONS_ON_MAP("Show buttons on map");
+	const PreferenceFlag TARGET_ASTEROID_BASED_ON("Target asteroid based on");
+	const PreferenceFlag TURRETS_FOCUS_FIRE("Turrets focus fire");
+
 	// If the player issues any of those commands, then any autopilot actions for the player get cancelled.
 	const Command &AutopilotCancelCommands()
 	{
@@ -376,8 +385,8 @@ void AI::IssueMoveTarget(const PlayerInfo &player, const Point &target, const Sy
 // Commands issued via the keyboard (mostly, to the flagship).
 void AI::UpdateKeys(PlayerInfo &player, Command &activeCommands)
 {
-	escortsUseAmmo = Preferences::Has("Escorts expend ammo");
-	escortsAreFrugal = Preferences::Has("Escorts use ammo frugally");
+	escortsUseAmmo = ESCORTS_EXPEND_AMMO.Has();
+	escortsAreFrugal = ESCORTS_USE_AMMO_FRUGALLY.Has();
 
 	autoPilot |= activeCommands;
 	if(activeCommands.Has(AutopilotCancelCommands()))
@@ -578,8 +587,8 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 	int targetTurn = 0;
 	int minerCount = 0;
 	const int maxMinerCount = minables.empty() ? 0 : 9;
-	bool opportunisticEscorts = !Preferences::Has("Turrets focus fire");
-	bool fightersRetreat = Preferences::Has("Damaged fighters retreat");
+	bool opportunisticEscorts = !TURRETS_FOCUS_FIRE.Has();
+	bool fightersRetreat = DAMAGED_FIGHTERS_RETREAT.Has();
 	const int npcMaxMiningTime = GameData::GetGamerules().NPCMaxMiningTime();
 	for(const auto &it : ships)
 	{
@@ -1998,7 +2007,7 @@ bool AI::ShouldDock(const Ship &ship, const Ship &parent, const System *playerSy
 	// If a carried ship has repair abilities, avoid having it get stuck oscillating between
 	// retreating and attacking when at exactly 50% health by adding hysteresis to the check.
 	double minHealth = RETREAT_HEALTH + .25 + .25 * !ship.Commands().Has(Command::DEPLOY);
-	if(ship.Health() < minHealth && (!ship.IsYours() || Preferences::Has("Damaged fighters retreat")))
+	if(ship.Health() < minHealth && (!ship.IsYours() || DAMAGED_FIGHTERS_RETREAT.Has()))
 		return true;
 
 	// If a fighter is armed with only ammo-using weapons, but no longer has the ammunition
@@ -2033,7 +2042,7 @@ bool AI::ShouldDock(const Ship &ship, const Ship &parent, const System *playerSy
 
 	// NPC ships should always transfer cargo. Player ships should only
 	// transfer cargo if the player has the AI preference set for it.
-	if(!ship.IsYours() || Preferences::Has("Fighters transfer cargo"))
+	if(!ship.IsYours() || FIGHTERS_TRANSFER_CARGO.Has())
 	{
 		// If an out-of-combat carried ship is carrying a significant cargo
 		// load and can transfer some of it to the parent, it should do so.
@@ -3662,7 +3671,7 @@ bool AI::TargetMinable(Ship &ship) const
 	double scanRangeMetric = 10000. * ship.Attributes().Get("asteroid scan power");
 	if(!scanRangeMetric)
 		return false;
-	const bool findClosest = Preferences::Has("Target asteroid based on");
+	const bool findClosest = TARGET_ASTEROID_BASED_ON.Has();
 	auto bestMinable = ship.GetTargetAsteroid();
 	double bestScore = findClosest ? numeric_limits<double>::max() : 0.;
 	auto GetDistanceMetric = [&ship](const Minable &minable) -> double {
@@ -4141,7 +4150,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 	else if(activeCommands.Has(Command::SCAN))
 	{
 		command |= Command::SCAN;
-		if(Preferences::Has("Automatic chase"))
+		if(AUTOMATIC_CHASE.Has())
 		{
 			// On android, chase the target if they get too far away while the
 			// user is holding the scan button.
@@ -4188,7 +4197,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 	}
 
 	const shared_ptr<const Ship> target = ship.GetTargetShip();
-	AimTurrets(ship, firingCommands, !Preferences::Has("Turrets focus fire"));
+	AimTurrets(ship, firingCommands, !TURRETS_FOCUS_FIRE.Has());
 	if(Preferences::GetAutoFire() != Preferences::AutoFire::OFF && !ship.IsBoarding()
 			&& !(autoPilot | activeCommands).Has(Command::LAND | Command::JUMP | Command::FLEET_JUMP | Command::BOARD)
 			&& (!target || target->GetGovernment()->IsEnemy() || activeCommands.Has(Command::FIGHT)))
@@ -4254,7 +4263,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 				}
 				++index;
 			}
-			if(Preferences::Has("Automatic chase"))
+			if(AUTOMATIC_CHASE.Has())
 			{
 				// On android, chase the target if they get too far away while the
 				// user is holding the fire button.
@@ -4415,7 +4424,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 	if(ship.HasBays() && HasDeployments(ship))
 	{
 		command |= Command::DEPLOY;
-		Deploy(ship, !Preferences::Has("Damaged fighters retreat"));
+		Deploy(ship, !DAMAGED_FIGHTERS_RETREAT.Has());
 	}
 	if(isCloaking)
 		command |= Command::CLOAK;
@@ -4573,7 +4582,7 @@ void AI::IssueOrders(const PlayerInfo &player, const Orders &newOrders, const st
 			if (it.get() == player.Flagship())
 			{
 				// For touchscreen targets, apply fight commands to the flagship too.
-				if (!(Preferences::Has("Show buttons on map") &&
+				if (!(SHOW_BUTTONS_ON_MAP.Has() &&
 					 (newOrders.type == Orders::FINISH_OFF || newOrders.type == Orders::ATTACK)))
 				{
 					continue;
@@ -24,6 +24,7 @@ public:
 		m_current = current;
 	}
 	void Reset() { m_steps = 0; }
+	bool IsAnimating() const { return m_steps > 0; }
 	void Step(const VarT& target)
 	{
 		if(m_steps <= 0)
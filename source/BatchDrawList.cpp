@@ -20,11 +20,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Screen.h"
 #include "Sprite.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
 
 namespace {
+	// Each quad is six vertices of six floats each.
+	const size_t QUAD_VERTICES = 6;
+	const size_t QUAD_SIZE = QUAD_VERTICES * 6;
+
 	void Push(vector<float> &v, const Point &pos, float s, float t, float frame, float alpha)
 	{
 		v.push_back(pos.X());
@@ -42,6 +47,8 @@ namespace {
 void BatchDrawList::Clear(int step, double zoom)
 {
 	data.clear();
+	sprites.clear();
+	textures.clear();
 	this->step = step;
 	this->zoom = zoom;
 	isHighDPI = (Screen::IsHighResolution() ? zoom > .5 : zoom > 1.);
@@ -85,10 +92,16 @@ bool BatchDrawList::AddVisual(const Body &visual)
 // Draw all the items in this list.
 void BatchDrawList::Draw() const
 {
+	if(data.empty())
+		return;
+
+	Sort();
+
 	BatchShader::Bind();
 
-	for(const pair<const Sprite * const, vector<float>> &it : data)
-		BatchShader::Add(it.first, isHighDPI, it.second);
+	BatchShader::Upload(sorted);
+	for(const Run &run : runs)
+		BatchShader::Draw(run.sprite, isHighDPI, run.first * QUAD_VERTICES, run.count * QUAD_VERTICES);
 
 	BatchShader::Unbind();
 }
@@ -123,8 +136,9 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 	if(Cull(body, position))
 		return false;
 
-	// Get the data vector for this particular sprite.
-	vector<float> &v = data[body.GetSprite()];
+	const Sprite *sprite = body.GetSprite();
+	sprites.push_back(sprite);
+	textures.push_back(sprite->Texture(isHighDPI));
 	// The sprite frame is the same for every vertex.
 	float frame = body.GetFrame(step);
 
@@ -146,14 +160,75 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 
 	float alpha = body.Alpha();
 
+	// Get the texture coordinates of the corners, within the part of the
+	// texture that the sprite is in.
+	const float *uvRect = sprite->UVRect();
+	float left = uvRect[0];
+	float right = uvRect[0] + uvRect[2];
+	float top = uvRect[1] + uvRect[3];
+	float bottom = uvRect[1] + (1.f - clip) * uvRect[3];
+
 	// Push two copies of the first and last vertices to mark the break between
 	// the sprites.
-	Push(v, topLeft, 0.f, 1.f, frame, alpha);
-	Push(v, topLeft, 0.f, 1.f, frame, alpha);
-	Push(v, topRight, 1.f, 1.f, frame, alpha);
-	Push(v, bottomLeft, 0.f, 1.f - clip, frame, alpha);
-	Push(v, bottomRight, 1.f, 1.f - clip, frame, alpha);
-	Push(v, bottomRight, 1.f, 1.f - clip, frame, alpha);
+	Push(data, topLeft, left, top, frame, alpha);
+	Push(data, topLeft, left, top, frame, alpha);
+	Push(data, topRight, right, top, frame, alpha);
+	Push(data, bottomLeft, left, bottom, frame, alpha);
+	Push(data, bottomRight, right, bottom, frame, alpha);
+	Push(data, bottomRight, right, bottom, frame, alpha);
 
 	return true;
 }
+
+
+
+// Sort the quads by texture, so that all the quads of each sprite are next to
+// each other in the vertex data, and find the run of each sprite.
+void BatchDrawList::Sort() const
+{
+	// A least significant digit radix sort, one byte at a time. It is stable,
+	// so the quads of each sprite stay in the order they were added in. Digits
+	// that are the same for every texture need no pass at all, which for the
+	// small numbers OpenGL uses for texture names is most of them.
+	size_t count = textures.size();
+	order.resize(count);
+	scratch.resize(count);
+	for(size_t i = 0; i < count; ++i)
+		order[i] = i;
+	for(int shift = 0; shift < 32; shift += 8)
+	{
+		size_t offsets[256] = {};
+		for(uint32_t texture : textures)
+			++offsets[(texture >> shift) & 0xFF];
+		if(offsets[(textures.front() >> shift) & 0xFF] == count)
+			continue;
+
+		size_t total = 0;
+		for(size_t &offset : offsets)
+		{
+			size_t digitCount = offset;
+			offset = total;
+			total += digitCount;
+		}
+		for(uint32_t index : order)
+			scratch[offsets[(textures[index] >> shift) & 0xFF]++] = index;
+		order.swap(scratch);
+	}
+
+	// Copy the quads into one flat array in sorted order, and note where the
+	// quads of each texture start and end. Sprites that share a texture are in
+	// an atlas, and have a single frame, so they can be drawn together.
+	sorted.resize(data.size());
+	runs.clear();
+	float *out = sorted.data();
+	for(size_t i = 0; i < count; ++i)
+	{
+		uint32_t index = order[i];
+		const float *quad = data.data() + index * QUAD_SIZE;
+		out = copy(quad, quad + QUAD_SIZE, out);
+
+		if(runs.empty() || textures[order[runs.back().first]] != textures[index])
+			runs.push_back(Run{sprites[index], i, 0});
+		++runs.back().count;
+	}
+}
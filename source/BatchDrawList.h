@@ -18,7 +18,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Point.h"
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 class Body;
@@ -28,6 +29,7 @@ class Sprite;
 
 // This class collects a set of OpenGL draw commands to issue and groups them by
 // sprite, so all instances of each sprite can be drawn with a single command.
+// All the vertex data is uploaded to the GPU at once.
 class BatchDrawList {
 public:
 	// Clear the list, also setting the global time step for animation.
@@ -49,6 +51,10 @@ private:
 	// Add the given body at the given position.
 	bool Add(const Body &body, Point position, float clip);
 
+	// Sort the quads by texture, so that all the quads of each sprite are next
+	// to each other in the vertex data, and find the run of each sprite.
+	void Sort() const;
+
 
 private:
 	int step = 0;
@@ -59,8 +65,25 @@ private:
 	// Each sprite consists of six vertices (four vertices to form a quad and
 	// two dummy vertices to mark the break in between them). Each of those
 	// vertices has six attributes: (x, y) position in pixels, (s, t) texture
-	// coordinates, the index of the sprite frame, and the alpha value.
-	std::map<const Sprite *, std::vector<float>> data;
+	// coordinates, the index of the sprite frame, and the alpha value. The
+	// quads are stored in the order they were added, along with their sprites
+	// and the textures to sort them by.
+	std::vector<float> data;
+	std::vector<const Sprite *> sprites;
+	std::vector<uint32_t> textures;
+
+	// A run of consecutive quads in the sorted data that use the same sprite.
+	struct Run {
+		const Sprite *sprite;
+		size_t first;
+		size_t count;
+	};
+	// The sorted vertex data and the runs in it. These are only scratch space
+	// for drawing, kept to avoid allocating them every frame.
+	mutable std::vector<float> sorted;
+	mutable std::vector<Run> runs;
+	mutable std::vector<uint32_t> order;
+	mutable std::vector<uint32_t> scratch;
 };
 
 
@@ -65,7 +65,8 @@ void BatchShader::Init()
 		"uniform sampler2DArray tex;\n"
 		"uniform float frameCount;\n"
 
-		"in vec3 fragTexCoord;\n"
+		// Sprites in an atlas need more precision for their texture coordinates.
+		"in highp vec3 fragTexCoord;\n"
 		"in float fragAlpha;\n"
 
 		"out vec4 finalColor;\n"
@@ -136,10 +137,21 @@ void BatchShader::Bind()
 
 
 
-void BatchShader::Add(const Sprite *sprite, bool isHighDPI, const vector<float> &data)
+// Upload the vertex data to be drawn.
+void BatchShader::Upload(const vector<float> &data)
+{
+	// Respecifying the whole buffer lets the driver give it new storage,
+	// rather than waiting until the previous draw calls are done with it.
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * data.size(), data.data(), GL_STREAM_DRAW);
+}
+
+
+
+// Draw the given range of vertices of the uploaded data.
+void BatchShader::Draw(const Sprite *sprite, bool isHighDPI, size_t first, size_t count)
 {
 	// Do nothing if there are no sprites to draw.
-	if(data.empty())
+	if(!count)
 		return;
 
 	// First, bind the proper texture.
@@ -147,11 +159,9 @@ void BatchShader::Add(const Sprite *sprite, bool isHighDPI, const vector<float>
 	// The shader also needs to know how many frames the texture has.
 	glUniform1f(frameCountI, sprite->Frames());
 
-	// Upload the vertex data.
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * data.size(), data.data(), GL_STREAM_DRAW);
-
 	// Draw all the vertices.
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, data.size() / 6);
+	glDrawArrays(GL_TRIANGLE_STRIP, first, count);
+	OpenGL::CountDrawCall();
 }
 
 
@@ -18,19 +18,24 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 class Sprite;
 
+#include <cstddef>
 #include <vector>
 
 
 
-// Class for drawing sprites in a batch. The input to each draw command is a
-// sprite, whether it should be drawn high DPI, and the vertex data.
+// Class for drawing sprites in a batch. The vertex data of all the sprites is
+// uploaded at once, and then each draw command draws a range of it using one
+// sprite, which may be drawn high DPI.
 class BatchShader {
 public:
 	// Initialize the shaders.
 	static void Init();
 
 	static void Bind();
-	static void Add(const Sprite *sprite, bool isHighDPI, const std::vector<float> &data);
+	// Upload the vertex data to be drawn.
+	static void Upload(const std::vector<float> &data);
+	// Draw the given range of vertices of the uploaded data.
+	static void Draw(const Sprite *sprite, bool isHighDPI, size_t first, size_t count);
 	static void Unbind();
 };
 
@@ -43,6 +43,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef FAINT_COLOR("faint");
+	const ColorRef MEDIUM_COLOR("medium");
+	const ColorRef PANEL_BACKGROUND_COLOR("panel background");
+
+	const InterfaceRef BOARDING_INTERFACE("boarding");
+
 	// Format the given double with one decimal place.
 	string Round(double value)
 	{
@@ -124,11 +132,11 @@ void BoardingPanel::Draw()
 	DrawBackdrop();
 
 	// Draw the list of plunder.
-	const Color &opaque = *GameData::Colors().Get("panel background");
-	const Color &back = *GameData::Colors().Get("faint");
-	const Color &dim = *GameData::Colors().Get("dim");
-	const Color &medium = *GameData::Colors().Get("medium");
-	const Color &bright = *GameData::Colors().Get("bright");
+	const Color &opaque = *PANEL_BACKGROUND_COLOR;
+	const Color &back = *FAINT_COLOR;
+	const Color &dim = *DIM_COLOR;
+	const Color &medium = *MEDIUM_COLOR;
+	const Color &bright = *BRIGHT_COLOR;
 	FillShader::Fill(Point(-155., -60.), Point(360., 250.), opaque);
 
 	int index = (scroll - 10) / 20;
@@ -207,7 +215,7 @@ void BoardingPanel::Draw()
 			Round(defenseOdds.DefenderCasualties(vCrew, crew)));
 	}
 
-	const Interface *boarding = GameData::Interfaces().Get("boarding");
+	const Interface *boarding = BOARDING_INTERFACE.Get();
 	boarding->Draw(info, this);
 
 	// Draw the status messages from hand to hand combat.
@@ -0,0 +1,97 @@
+/* ColumnWriter.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ColumnWriter.h"
+
+#include <cstring>
+
+using namespace std;
+
+const uint8_t ColumnWriter::TEXT;
+const uint8_t ColumnWriter::NUMBER;
+
+
+
+// Begin a file that will hold the given number of tables.
+ColumnWriter::ColumnWriter(uint32_t tables)
+	: data("ESTABLE1")
+{
+	Write(tables);
+}
+
+
+
+// Begin a table. It must be followed by the given number of columns, each with
+// one value for each of the given number of rows.
+void ColumnWriter::BeginTable(const string &name, uint32_t rows, uint32_t columns)
+{
+	Write(name);
+	Write(rows);
+	Write(columns);
+}
+
+
+
+void ColumnWriter::WriteColumn(const string &name, const vector<string> &values)
+{
+	Write(name);
+	data += static_cast<char>(TEXT);
+	for(const string &value : values)
+		Write(value);
+}
+
+
+
+void ColumnWriter::WriteColumn(const string &name, const vector<double> &values)
+{
+	Write(name);
+	data += static_cast<char>(NUMBER);
+	for(double value : values)
+		Write(value);
+}
+
+
+
+// Get the contents of the file.
+const string &ColumnWriter::Data() const
+{
+	return data;
+}
+
+
+
+void ColumnWriter::Write(uint32_t value)
+{
+	for(int i = 0; i < 4; ++i)
+		data += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+
+
+void ColumnWriter::Write(double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	for(int i = 0; i < 8; ++i)
+		data += static_cast<char>((bits >> (8 * i)) & 0xFF);
+}
+
+
+
+void ColumnWriter::Write(const string &value)
+{
+	Write(static_cast<uint32_t>(value.size()));
+	data += value;
+}
@@ -0,0 +1,74 @@
+/* ColumnWriter.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef COLUMN_WRITER_H_
+#define COLUMN_WRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+// Class for building a file that holds a set of tables, stored column by
+// column, so that other programs can read it without parsing any text. This is
+// the format of the file that "--export" writes. All numbers are little-endian,
+// and the file is laid out as:
+//   8 bytes: "ESTABLE1"
+//   uint32: the number of tables
+// followed by each table:
+//   string: the table name
+//   uint32: the number of rows
+//   uint32: the number of columns
+// followed by each column of that table:
+//   string: the column name
+//   uint8: the column type, 0 for strings or 1 for float64
+//   one value of that type for each row
+// where a string is a uint32 byte count followed by that many bytes of UTF-8
+// text.
+class ColumnWriter {
+public:
+	// The column types, as they are stored in the file.
+	static const uint8_t TEXT = 0;
+	static const uint8_t NUMBER = 1;
+
+
+public:
+	// Begin a file that will hold the given number of tables.
+	explicit ColumnWriter(uint32_t tables);
+
+	// Begin a table. It must be followed by the given number of columns, each
+	// with one value for each of the given number of rows.
+	void BeginTable(const std::string &name, uint32_t rows, uint32_t columns);
+	void WriteColumn(const std::string &name, const std::vector<std::string> &values);
+	void WriteColumn(const std::string &name, const std::vector<double> &values);
+
+	// Get the contents of the file.
+	const std::string &Data() const;
+
+
+private:
+	void Write(uint32_t value);
+	void Write(double value);
+	void Write(const std::string &value);
+
+
+private:
+	std::string data;
+};
+
+
+
+#endif
@@ -66,6 +66,7 @@ ConversationPanel::ConversationPanel(PlayerInfo &player, const Conversation &con
 	: player(player), caller(caller), useTransactions(useTransactions), conversation(conversation),
 	scroll(0.), system(system), ship(ship)
 {
+	SetIsStatic(true);
 #if defined _WIN32
 	PATH_LENGTH = Files::Saves().size();
 #endif
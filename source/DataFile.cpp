@@ -15,7 +15,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DataFile.h"
 
-#include "Files.h"
+#include "GzipFile.h"
 #include "text/Utf8.h"
 
 using namespace std;
@@ -41,7 +41,7 @@ DataFile::DataFile(istream &in)
 // Load from a file path (in UTF-8).
 void DataFile::Load(const string &path)
 {
-	string data = Files::Read(path);
+	string data = GzipFile::Read(path);
 	if(data.empty())
 		return;
 
@@ -49,10 +49,7 @@ void DataFile::Load(const string &path)
 	if(data.back() != '\n')
 		data.push_back('\n');
 
-	// Note what file this node is in, so it will show up in error traces.
-	root.tokens.push_back("file");
-	root.tokens.push_back(path);
-
+	SetPath(path);
 	LoadData(data);
 }
 
@@ -96,9 +93,20 @@ list<DataNode>::const_iterator DataFile::end() const
 
 
 
-// Parse the given text.
-void DataFile::LoadData(const string &data)
+// Note what file the nodes are in, so it will show up in error traces.
+void DataFile::SetPath(const string &path)
 {
+	root.tokens = {"file", path};
+}
+
+
+
+// Parse the given text, replacing any nodes that were already parsed. Line
+// numbers in error messages are counted from the given line.
+void DataFile::LoadData(const string &data, size_t firstLine)
+{
+	root.children.clear();
+
 	// Keep track of the current stack of indentation levels and the most recent
 	// node at each level - that is, the node that will be the "parent" of any
 	// new node added at the next deeper indentation level.
@@ -106,7 +114,7 @@ void DataFile::LoadData(const string &data)
 	vector<int> separatorStack(1, -1);
 	bool fileIsTabs = false;
 	bool fileIsSpaces = false;
-	size_t lineNumber = 0;
+	size_t lineNumber = firstLine;
 
 	size_t end = data.length();
 	for(size_t pos = 0; pos < end; )
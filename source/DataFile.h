@@ -46,12 +46,18 @@ public:
 
 
 private:
-	void LoadData(const std::string &data);
+	// Note what file the nodes are in, so it will show up in error traces.
+	void SetPath(const std::string &path);
+	// Parse the given text, replacing any nodes that were already parsed. Line
+	// numbers in error messages are counted from the given line.
+	void LoadData(const std::string &data, size_t firstLine = 0);
 
 
 private:
 	// This is the container for all DataNodes in this file.
 	DataNode root;
+
+	friend class DataStream;
 };
 
 
@@ -0,0 +1,195 @@
+/* DataStream.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "DataStream.h"
+
+#include "DataNode.h"
+#include "GzipFile.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace {
+	// The file is read this many bytes at a time.
+	const size_t BLOCK_SIZE = 4096;
+
+	// Check if the given line is the first line of a top-level node, rather
+	// than a child of one, a comment, or an empty line.
+	bool IsTopLevel(const string &line)
+	{
+		return !line.empty() && static_cast<unsigned char>(line[0]) > ' ' && line[0] != '#';
+	}
+}
+
+
+
+DataStream::DataStream(const string &path)
+	: file(new GzipFile(path))
+{
+	nodes.SetPath(path);
+}
+
+
+
+// Read data that is already in memory. The text is not copied, so it must
+// remain valid as long as this stream is used.
+DataStream::DataStream(const char *text, size_t size)
+	: data(text), size(size)
+{
+}
+
+
+
+// The file must be closed here, where GzipFile is a complete type.
+DataStream::~DataStream()
+{
+}
+
+
+
+// Parse the next top-level node and all its children. Return false once
+// the end of the file has been reached.
+bool DataStream::Next()
+{
+	if(isParsed && ++it != nodes.end())
+		return true;
+
+	isParsed = false;
+	while(ReadText())
+	{
+		// The tokenizer expects every line to end in a newline.
+		if(text.back() != '\n')
+			text += '\n';
+		nodes.LoadData(text, textLine);
+		text.clear();
+
+		it = nodes.begin();
+		isParsed = (it != nodes.end());
+		if(isParsed)
+			return true;
+	}
+	return false;
+}
+
+
+
+// Get the node that was just parsed. It is only valid until the next call
+// to Next() or Skip().
+const DataNode &DataStream::Node() const
+{
+	return *it;
+}
+
+
+
+// If the next top-level node begins with the given token, skip it without
+// parsing it and return true.
+bool DataStream::Skip(const string &key)
+{
+	// If the last text held more than one node, the next one is already parsed.
+	if(isParsed && next(it) != nodes.end())
+		return false;
+	if(!ReadText() || text.compare(nodeStart, key.size(), key))
+		return false;
+	size_t end = nodeStart + key.size();
+	if(end < text.size() && static_cast<unsigned char>(text[end]) > ' ')
+		return false;
+
+	text.clear();
+	isParsed = false;
+	return true;
+}
+
+
+
+// Make sure the text of the next top-level node has been read. Return false
+// if there is nothing left in the file.
+bool DataStream::ReadText()
+{
+	if(!text.empty())
+		return true;
+
+	// If the first line of this node was already read, it was the last line
+	// to be counted.
+	text = std::move(pending);
+	pending.clear();
+	textLine = (text.empty() ? lineCount : lineCount - 1);
+	nodeStart = 0;
+	bool hasNode = !text.empty();
+
+	string line;
+	while(ReadLine(line))
+	{
+		++lineCount;
+		if(IsTopLevel(line))
+		{
+			if(hasNode)
+			{
+				pending = std::move(line);
+				break;
+			}
+			hasNode = true;
+			nodeStart = text.size();
+		}
+		text += line;
+	}
+	return !text.empty();
+}
+
+
+
+bool DataStream::ReadLine(string &line)
+{
+	while(true)
+	{
+		const void *newline = (pos < size ? memchr(data + pos, '\n', size - pos) : nullptr);
+		if(newline)
+		{
+			size_t end = static_cast<const char *>(newline) - data + 1;
+			line.assign(data + pos, end - pos);
+			pos = end;
+			return true;
+		}
+		if(!Fill())
+		{
+			// The last line of the file may not end with a newline.
+			line.assign(data + pos, size - pos);
+			pos = size;
+			return !line.empty();
+		}
+	}
+}
+
+
+
+// Read another block of the file. Return false if there is nothing left.
+bool DataStream::Fill()
+{
+	if(!file)
+		return false;
+
+	// Discard the lines that have already been read.
+	buffer.erase(0, pos);
+	pos = 0;
+	size_t kept = buffer.size();
+	buffer.resize(kept + BLOCK_SIZE);
+	size_t count = file->Read(&buffer[kept], BLOCK_SIZE);
+	buffer.resize(kept + count);
+
+	data = buffer.data();
+	size = buffer.size();
+	return count > 0;
+}
@@ -0,0 +1,90 @@
+/* DataStream.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DATA_STREAM_H_
+#define DATA_STREAM_H_
+
+#include "DataFile.h"
+
+#include <list>
+#include <memory>
+#include <string>
+
+class DataNode;
+class GzipFile;
+
+
+
+// Class for reading a data file one top-level node at a time, instead of
+// parsing the whole file into a DataFile first. Only the text of the current
+// node and the nodes parsed from it are held in memory, which matters for
+// large files such as saved games. The file is read a block at a time, and
+// may be compressed.
+class DataStream {
+public:
+	explicit DataStream(const std::string &path);
+	// Read data that is already in memory. The text is not copied, so it must
+	// remain valid as long as this stream is used.
+	DataStream(const char *text, size_t size);
+	DataStream(const DataStream &) = delete;
+	DataStream &operator=(const DataStream &) = delete;
+	~DataStream();
+
+	// Parse the next top-level node and all its children. Return false once
+	// the end of the file has been reached.
+	bool Next();
+	// Get the node that was just parsed. It is only valid until the next call
+	// to Next() or Skip().
+	const DataNode &Node() const;
+	// If the next top-level node begins with the given token, skip it without
+	// parsing it and return true.
+	bool Skip(const std::string &key);
+
+
+private:
+	// Make sure the text of the next top-level node has been read. Return false
+	// if there is nothing left in the file.
+	bool ReadText();
+	bool ReadLine(std::string &line);
+	// Read another block of the file. Return false if there is nothing left.
+	bool Fill();
+
+
+private:
+	std::unique_ptr<GzipFile> file;
+	std::string buffer;
+	const char *data = nullptr;
+	size_t size = 0;
+	size_t pos = 0;
+
+	// The text of the next top-level node, and the line it starts on.
+	std::string text;
+	size_t textLine = 0;
+	size_t lineCount = 0;
+	// Where in the text the node's own line begins, after any comments.
+	size_t nodeStart = 0;
+	// The first line of the node after that one, if it has been read.
+	std::string pending;
+
+	// The nodes parsed from the most recent text. This is normally just one,
+	// unless the file begins with indented lines.
+	DataFile nodes;
+	std::list<DataNode>::const_iterator it;
+	bool isParsed = false;
+};
+
+
+
+#endif
@@ -63,6 +63,14 @@ void DataWriter::SaveToPath(const std::string &filepath)
 
 
 
+// Get everything that has been written so far.
+string DataWriter::GetString() const
+{
+	return out.str();
+}
+
+
+
 // Write a DataNode with all its children.
 void DataWriter::Write(const DataNode &node)
 {
@@ -47,6 +47,8 @@ public:
 
 	// Save the contents to a file.
 	void SaveToPath(const std::string &path);
+	// Get everything that has been written so far.
+	std::string GetString() const;
 
 	// The Write() function can take any number of arguments. Each argument is
 	// converted to a token. Arguments may be strings or numeric values.
@@ -179,8 +179,11 @@ void Dialog::Draw()
 	font.Draw(okText, labelPos, isOkDisabled ? inactive : (okIsActive ? bright : dim));
 	AddZone(Rectangle(okPos, labelSize), [this]() { Click(okPos.X(), okPos.Y(), 1); });
 
-	// Draw the text.
+	// Draw the text. Scrolling it is animated, so keep drawing this dialog
+	// until the text has reached its new position.
 	text.Draw(textPos, dim);
+	if(text.IsScrolling())
+		Redraw();
 
 	// Draw the input, if any.
 	if(!isMission && (intFun || stringFun))
@@ -377,6 +380,7 @@ bool Dialog::Drag(double dx, double dy)
 void Dialog::Init(const string &message, Truncate truncate, bool canCancel, bool isMission)
 {
 	SetInterruptible(isMission);
+	SetIsStatic(true);
 
 	this->isMission = isMission;
 	this->canCancel = canCancel;
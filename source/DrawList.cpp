@@ -17,14 +17,52 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Body.h"
 #include "Preferences.h"
+#include "Rectangle.h"
 #include "Screen.h"
 #include "Sprite.h"
 #include "SpriteShader.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
 
+namespace {
+	const PreferenceFlag RENDER_MOTION_BLUR("Render motion blur");
+
+	// How many groups back an item may be moved to join a group that uses the
+	// same textures. Most items that share textures (asteroids, flotsam, and
+	// ships of the same model) are added close together.
+	const size_t MAX_LOOKBACK = 16;
+
+	// A run of items that will be drawn with a single instanced draw call.
+	struct Group {
+		const SpriteShader::Item *first;
+		vector<const SpriteShader::Item *> items;
+		Rectangle bounds;
+	};
+
+	// Get the area of the screen that an item may draw to.
+	Rectangle Bounds(const SpriteShader::Item &item)
+	{
+		// The blur stretches the sprite by up to twice the blur vector in each
+		// direction, in texture coordinates.
+		double scaleX = 1. + 2. * fabs(item.blur[0]);
+		double scaleY = 1. + 2. * fabs(item.blur[1]);
+		Point size(
+			fabs(item.transform[0]) * scaleX + fabs(item.transform[2]) * scaleY,
+			fabs(item.transform[1]) * scaleX + fabs(item.transform[3]) * scaleY);
+		return Rectangle(Point(item.position[0], item.position[1]), size);
+	}
+
+	Rectangle Union(const Rectangle &a, const Rectangle &b)
+	{
+		return Rectangle::WithCorners(
+			Point(min(a.Left(), b.Left()), min(a.Top(), b.Top())),
+			Point(max(a.Right(), b.Right()), max(a.Bottom(), b.Bottom())));
+	}
+}
+
 
 
 // Clear the list.
@@ -96,13 +134,53 @@ bool DrawList::AddSwizzled(const Body &body, int swizzle)
 // Draw all the items in this list.
 void DrawList::Draw() const
 {
-	SpriteShader::Bind();
-
-	bool withBlur = Preferences::Has("Render motion blur");
+	bool withBlur = RENDER_MOTION_BLUR.Has();
+	if(!SpriteShader::CanDrawInstanced())
+	{
+		SpriteShader::Bind();
+
+		for(const SpriteShader::Item &item : items)
+			SpriteShader::Add(item, withBlur);
+
+		SpriteShader::Unbind();
+		return;
+	}
+
+	// Gather the items that use the same textures into groups, so that each
+	// group can be drawn with one draw call. An item may only be moved into an
+	// earlier group if it does not overlap anything drawn after that group,
+	// so that the result looks the same as drawing the items in order.
+	vector<Group> groups;
 	for(const SpriteShader::Item &item : items)
-		SpriteShader::Add(item, withBlur);
-
-	SpriteShader::Unbind();
+	{
+		Rectangle bounds = Bounds(item);
+		Group *target = nullptr;
+		for(size_t i = groups.size(); i-- && groups.size() - i <= MAX_LOOKBACK; )
+		{
+			Group &group = groups[i];
+			if(group.first->texture == item.texture && group.first->swizzleMask == item.swizzleMask)
+			{
+				target = &group;
+				break;
+			}
+			if(group.bounds.Overlaps(bounds))
+				break;
+		}
+		if(target)
+		{
+			target->items.push_back(&item);
+			target->bounds = Union(target->bounds, bounds);
+		}
+		else
+			groups.push_back(Group{&item, {&item}, bounds});
+	}
+
+	sorted.clear();
+	sorted.reserve(items.size());
+	for(const Group &group : groups)
+		sorted.insert(sorted.end(), group.items.begin(), group.items.end());
+
+	SpriteShader::DrawInstanced(sorted, withBlur);
 }
 
 
@@ -138,6 +216,8 @@ void DrawList::Push(const Body &body, Point pos, Point blur, double cloak, int s
 	item.swizzleMask = body.GetSprite()->SwizzleMask(isHighDPI);
 	item.frame = body.GetFrame(step);
 	item.frameCount = body.GetSprite()->Frames();
+	const float *uvRect = body.GetSprite()->UVRect();
+	copy(uvRect, uvRect + 4, item.uvRect);
 
 	item.position[0] = static_cast<float>(pos.X() * zoom);
 	item.position[1] = static_cast<float>(pos.Y() * zoom);
@@ -64,6 +64,9 @@ private:
 	double zoom = 1.;
 	bool isHighDPI = false;
 	std::vector<SpriteShader::Item> items;
+	// The items in the order they are drawn, so that consecutive items that
+	// use the same textures can be drawn together.
+	mutable std::vector<const SpriteShader::Item *> sorted;
 
 	Point center;
 	Point centerVelocity;
@@ -52,6 +52,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "PointerShader.h"
 #include "Preferences.h"
 #include "Projectile.h"
+#include "RaidFleet.h"
 #include "Random.h"
 #include "RingShader.h"
 #include "Screen.h"
@@ -75,11 +76,57 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <set>
 #include <string>
 
 using namespace std;
 
 namespace {
+	const ColorRef FLAGSHIP_HIGHLIGHT_COLOR("flagship highlight");
+	const ColorRef MEDIUM_COLOR("medium");
+	const ColorRef MESSAGE_IMPORTANCE_DEFAULT_COLOR("message importance default");
+	const ColorRef MINABLE_TARGET_POINTER_SELECTED_COLOR("minable target pointer selected");
+	const ColorRef MINABLE_TARGET_POINTER_UNSELECTED_COLOR("minable target pointer unselected");
+	const ColorRef PLANET_TARGET_POINTER_DOMINATED_COLOR("planet target pointer dominated");
+	const ColorRef PLANET_TARGET_POINTER_FRIENDLY_COLOR("planet target pointer friendly");
+	const ColorRef PLANET_TARGET_POINTER_HOSTILE_COLOR("planet target pointer hostile");
+	const ColorRef PLANET_TARGET_POINTER_RESTRICTED_COLOR("planet target pointer restricted");
+	const ColorRef PLANET_TARGET_POINTER_UNFRIENDLY_COLOR("planet target pointer unfriendly");
+	const ColorRef SHIP_TARGET_OUTLINE_BLINK_COLOR("ship target outline blink");
+	const ColorRef SHIP_TARGET_OUTLINE_FRIENDLY_COLOR("ship target outline friendly");
+	const ColorRef SHIP_TARGET_OUTLINE_HOSTILE_COLOR("ship target outline hostile");
+	const ColorRef SHIP_TARGET_OUTLINE_INACTIVE_COLOR("ship target outline inactive");
+	const ColorRef SHIP_TARGET_OUTLINE_PLAYER_COLOR("ship target outline player");
+	const ColorRef SHIP_TARGET_OUTLINE_SPECIAL_COLOR("ship target outline special");
+	const ColorRef SHIP_TARGET_OUTLINE_UNFRIENDLY_COLOR("ship target outline unfriendly");
+	const ColorRef SHIP_TARGET_POINTER_BLINK_COLOR("ship target pointer blink");
+	const ColorRef SHIP_TARGET_POINTER_FRIENDLY_COLOR("ship target pointer friendly");
+	const ColorRef SHIP_TARGET_POINTER_HOSTILE_COLOR("ship target pointer hostile");
+	const ColorRef SHIP_TARGET_POINTER_INACTIVE_COLOR("ship target pointer inactive");
+	const ColorRef SHIP_TARGET_POINTER_PLAYER_COLOR("ship target pointer player");
+	const ColorRef SHIP_TARGET_POINTER_SPECIAL_COLOR("ship target pointer special");
+	const ColorRef SHIP_TARGET_POINTER_UNFRIENDLY_COLOR("ship target pointer unfriendly");
+
+	const InterfaceRef HUD_INTERFACE("hud");
+	const InterfaceRef MAIN_BUTTONS_INTERFACE("main buttons");
+
+	const PreferenceFlag CLICKABLE_RADAR_DISPLAY("Clickable radar display");
+	const PreferenceFlag CONTROL_SHIP_WITH_MOUSE("Control ship with mouse");
+	const PreferenceFlag DISABLE_VIEWPORT_ON_RADAR("Disable viewport on radar");
+	const PreferenceFlag EXTENDED_JUMP_EFFECTS("Extended jump effects");
+	const PreferenceFlag HIGHLIGHT_PLAYERS_FLAGSHIP("Highlight player's flagship");
+	const PreferenceFlag LANDING_ZOOM("Landing zoom");
+	const PreferenceFlag ONSCREEN_JOYSTICK("Onscreen Joystick");
+	const PreferenceFlag RENDER_MOTION_BLUR("Render motion blur");
+	const PreferenceFlag ROTATE_FLAGSHIP_IN_HUD("Rotate flagship in HUD");
+	const PreferenceFlag SHOW_ASTEROID_SCANNER_OVERLAY("Show asteroid scanner overlay");
+	const PreferenceFlag SHOW_BUTTONS_ON_MAP("Show buttons on map");
+	const PreferenceFlag SHOW_CPU_GPU_LOAD("Show CPU / GPU load");
+	const PreferenceFlag SHOW_HYPERSPACE_FLASH("Show hyperspace flash");
+	const PreferenceFlag SHOW_MINI_MAP("Show mini-map");
+	const PreferenceFlag SHOW_MISSILE_OVERLAYS("Show missile overlays");
+	const PreferenceFlag SHOW_PLANET_LABELS("Show planet labels");
+
 	int RadarType(const Ship &ship, int step)
 	{
 		if(ship.GetPersonality().IsTarget() && !ship.IsDestroyed())
@@ -180,19 +227,19 @@ namespace {
 	const Color &GetTargetOutlineColor(int type)
 	{
 		if(type == Radar::PLAYER)
-			return *GameData::Colors().Get("ship target outline player");
+			return *SHIP_TARGET_OUTLINE_PLAYER_COLOR;
 		else if(type == Radar::FRIENDLY)
-			return *GameData::Colors().Get("ship target outline friendly");
+			return *SHIP_TARGET_OUTLINE_FRIENDLY_COLOR;
 		else if(type == Radar::UNFRIENDLY)
-			return *GameData::Colors().Get("ship target outline unfriendly");
+			return *SHIP_TARGET_OUTLINE_UNFRIENDLY_COLOR;
 		else if(type == Radar::HOSTILE)
-			return *GameData::Colors().Get("ship target outline hostile");
+			return *SHIP_TARGET_OUTLINE_HOSTILE_COLOR;
 		else if(type == Radar::SPECIAL)
-			return *GameData::Colors().Get("ship target outline special");
+			return *SHIP_TARGET_OUTLINE_SPECIAL_COLOR;
 		else if(type == Radar::BLINK)
-			return *GameData::Colors().Get("ship target outline blink");
+			return *SHIP_TARGET_OUTLINE_BLINK_COLOR;
 		else
-			return *GameData::Colors().Get("ship target outline inactive");
+			return *SHIP_TARGET_OUTLINE_INACTIVE_COLOR;
 	}
 
 	const Color &GetPlanetTargetPointerColor(const Planet &planet)
@@ -200,40 +247,63 @@ namespace {
 		switch(planet.GetFriendliness())
 		{
 			case Planet::Friendliness::FRIENDLY:
-				return *GameData::Colors().Get("planet target pointer friendly");
+				return *PLANET_TARGET_POINTER_FRIENDLY_COLOR;
 			case Planet::Friendliness::RESTRICTED:
-				return *GameData::Colors().Get("planet target pointer restricted");
+				return *PLANET_TARGET_POINTER_RESTRICTED_COLOR;
 			case Planet::Friendliness::HOSTILE:
-				return *GameData::Colors().Get("planet target pointer hostile");
+				return *PLANET_TARGET_POINTER_HOSTILE_COLOR;
 			case Planet::Friendliness::DOMINATED:
-				return *GameData::Colors().Get("planet target pointer dominated");
+				return *PLANET_TARGET_POINTER_DOMINATED_COLOR;
 		}
-		return *GameData::Colors().Get("planet target pointer unfriendly");
+		return *PLANET_TARGET_POINTER_UNFRIENDLY_COLOR;
 	}
 
 	const Color &GetShipTargetPointerColor(int type)
 	{
 		if(type == Radar::PLAYER)
-			return *GameData::Colors().Get("ship target pointer player");
+			return *SHIP_TARGET_POINTER_PLAYER_COLOR;
 		else if(type == Radar::FRIENDLY)
-			return *GameData::Colors().Get("ship target pointer friendly");
+			return *SHIP_TARGET_POINTER_FRIENDLY_COLOR;
 		else if(type == Radar::UNFRIENDLY)
-			return *GameData::Colors().Get("ship target pointer unfriendly");
+			return *SHIP_TARGET_POINTER_UNFRIENDLY_COLOR;
 		else if(type == Radar::HOSTILE)
-			return *GameData::Colors().Get("ship target pointer hostile");
+			return *SHIP_TARGET_POINTER_HOSTILE_COLOR;
 		else if(type == Radar::SPECIAL)
-			return *GameData::Colors().Get("ship target pointer special");
+			return *SHIP_TARGET_POINTER_SPECIAL_COLOR;
 		else if(type == Radar::BLINK)
-			return *GameData::Colors().Get("ship target pointer blink");
+			return *SHIP_TARGET_POINTER_BLINK_COLOR;
 		else
-			return *GameData::Colors().Get("ship target pointer inactive");
+			return *SHIP_TARGET_POINTER_INACTIVE_COLOR;
 	}
 
 	const Color &GetMinablePointerColor(bool selected)
 	{
 		if(selected)
-			return *GameData::Colors().Get("minable target pointer selected");
-		return *GameData::Colors().Get("minable target pointer unselected");
+			return *MINABLE_TARGET_POINTER_SELECTED_COLOR;
+		return *MINABLE_TARGET_POINTER_UNSELECTED_COLOR;
+	}
+
+	// Start loading the sprites that may be seen in the given system: its
+	// stellar objects and their landscapes, its haze, and the ships of the
+	// fleets that may spawn there.
+	void PrefetchSprites(const System &system)
+	{
+		set<const Sprite *> sprites;
+		for(const StellarObject &object : system.Objects())
+		{
+			if(object.HasSprite())
+				sprites.insert(object.GetSprite());
+			if(object.HasValidPlanet())
+				sprites.insert(object.GetPlanet()->Landscape());
+		}
+		sprites.insert(system.Haze());
+		for(const auto &fleet : system.Fleets())
+			fleet.Get()->GetSprites(sprites);
+		for(const RaidFleet &raid : system.RaidFleets())
+			raid.GetFleet()->GetSprites(sprites);
+
+		for(const Sprite *sprite : sprites)
+			GameData::Prefetch(sprite);
 	}
 
 	const double RADAR_SCALE = .025;
@@ -247,7 +317,7 @@ Engine::Engine(PlayerInfo &player)
 	ammoDisplay(player), shipCollisions(256u, 32u)
 {
 	baseZoom = Preferences::ViewZoom();
-	zoomMod = Preferences::Has("Landing zoom") ? 2. : 1.;
+	zoomMod = LANDING_ZOOM.Has() ? 2. : 1.;
 	zoom = baseZoom * zoomMod;
 
 	// Start the thread for doing calculations.
@@ -506,7 +576,7 @@ void Engine::Step(bool isActive)
 	{
 		center = flagship->Position();
 		centerVelocity = flagship->Velocity();
-		if(flagship->IsHyperspacing() && Preferences::Has("Extended jump effects"))
+		if(flagship->IsHyperspacing() && EXTENDED_JUMP_EFFECTS.Has())
 			centerVelocity *= 1. + pow(flagship->GetHyperspacePercentage() / 20., 2);
 		if(doEnterLabels)
 		{
@@ -536,6 +606,15 @@ void Engine::Step(bool isActive)
 		}
 		else if(jumpCount > 0)
 			--jumpCount;
+
+		// As soon as the next system on the route is known, start loading its
+		// sprites in the background, so that they are ready when we arrive.
+		const System *next = player.HasTravelPlan() ? player.TravelPlan().back() : flagship->GetTargetSystem();
+		if(next && next != prefetchedSystem)
+		{
+			prefetchedSystem = next;
+			PrefetchSprites(*next);
+		}
 	}
 	ai.UpdateEvents(events);
 	if(isActive)
@@ -592,10 +671,10 @@ void Engine::Step(bool isActive)
 				nextZoom = max(zoomTarget, baseZoom * (1. / (1. + zoomRatio)));
 		}
 	}
-	zoom = Preferences::Has("Landing zoom") ? baseZoom * (1 + pow(zoomMod - 1, 2)) : baseZoom;
+	zoom = LANDING_ZOOM.Has() ? baseZoom * (1 + pow(zoomMod - 1, 2)) : baseZoom;
 
 	// Draw a highlight to distinguish the flagship from other ships.
-	if(flagship && !flagship->IsDestroyed() && Preferences::Has("Highlight player's flagship"))
+	if(flagship && !flagship->IsDestroyed() && HIGHLIGHT_PLAYERS_FLAGSHIP.Has())
 	{
 		highlightSprite = flagship->GetSprite();
 		highlightUnit = flagship->Unit() * zoom;
@@ -686,7 +765,7 @@ void Engine::Step(bool isActive)
 		// Create the status overlays.
 		CreateStatusOverlays();
 		// Create missile overlays.
-		if(Preferences::Has("Show missile overlays"))
+		if(SHOW_MISSILE_OVERLAYS.Has())
 			for(const Projectile &projectile : projectiles)
 			{
 				Point pos = projectile.Position() - center;
@@ -707,7 +786,7 @@ void Engine::Step(bool isActive)
 	if(flagship && flagship->Hull())
 	{
 		Point shipFacingUnit(0., -1.);
-		if(Preferences::Has("Rotate flagship in HUD"))
+		if(ROTATE_FLAGSHIP_IN_HUD.Has())
 			shipFacingUnit = flagship->Facing().Unit();
 
 		info.SetSprite("player sprite", flagship->GetSprite(), shipFacingUnit, flagship->GetFrame(step));
@@ -927,13 +1006,13 @@ void Engine::Step(bool isActive)
 				ship->Position() - center,
 				Angle(45.) + ship->Facing(),
 				size,
-				*GameData::Colors().Get("ship target pointer player"),
+				*SHIP_TARGET_POINTER_PLAYER_COLOR,
 				4});
 		}
 	}
 
 	// Draw crosshairs on any minables in range of the flagship's scanners.
-	bool shouldShowAsteroidOverlay = Preferences::Has("Show asteroid scanner overlay");
+	bool shouldShowAsteroidOverlay = SHOW_ASTEROID_SCANNER_OVERLAY.Has();
 	// Decide before looping whether or not to catalog asteroids. This
 	// results in cataloging in-range asteroids roughly 3 times a second.
 	bool shouldCatalogAsteroids = (!isAsteroidCatalogComplete && !Random::Int(20));
@@ -1015,13 +1094,13 @@ list<ShipEvent> &Engine::Events()
 // Draw a frame.
 void Engine::Draw() const
 {
-	GameData::Background().Draw(center, Preferences::Has("Render motion blur") ? centerVelocity : Point(),
+	GameData::Background().Draw(center, RENDER_MOTION_BLUR.Has() ? centerVelocity : Point(),
 		zoom, (player.Flagship() ? player.Flagship()->GetSystem() : player.GetSystem()));
 	static const Set<Color> &colors = GameData::Colors();
-	const Interface *hud = GameData::Interfaces().Get("hud");
+	const Interface *hud = HUD_INTERFACE.Get();
 
 	// Draw any active planet labels.
-	if(Preferences::Has("Show planet labels"))
+	if(SHOW_PLANET_LABELS.Has())
 		for(const PlanetLabel &label : labels)
 			label.Draw();
 
@@ -1065,7 +1144,7 @@ void Engine::Draw() const
 	if(highlightSprite)
 	{
 		Point size(highlightSprite->Width(), highlightSprite->Height());
-		const Color &color = *colors.Get("flagship highlight");
+		const Color &color = *FLAGSHIP_HIGHLIGHT_COLOR;
 		// The flagship is always in the dead center of the screen.
 		OutlineShader::Draw(highlightSprite, Point(), size, color, highlightUnit, highlightFrame);
 	}
@@ -1106,7 +1185,7 @@ void Engine::Draw() const
 				break;
 		}
 		if(!color)
-			color = GameData::Colors().Get("message importance default");
+			color = MESSAGE_IMPORTANCE_DEFAULT_COLOR.Get();
 		messageLine.Draw(messagePoint, color->Additive(alpha));
 	}
 
@@ -1154,11 +1233,11 @@ void Engine::Draw() const
 		for(int i = 0; i < 2; ++i)
 			SpriteShader::Draw(mark[i], center + Point(dx[i], 0.), 1., targetSwizzle);
 	}
-	if(jumpCount && Preferences::Has("Show mini-map"))
+	if(jumpCount && SHOW_MINI_MAP.Has())
 		MapPanel::DrawMiniMap(player, .5f * min(1.f, jumpCount / 30.f), jumpInProgress, step);
 
 	// map buttons cover up these icons, and provide their own version anyways.
-	if (!Preferences::Has("Show buttons on map"))
+	if (!SHOW_BUTTONS_ON_MAP.Has())
 	{
 		// Draw ammo status.
 		double ammoIconWidth = hud->GetValue("ammo icon width");
@@ -1169,14 +1248,10 @@ void Engine::Draw() const
 	// Draw escort status.
 	escorts.Draw(hud->GetBox("escorts"));
 
-	// Upload any preloaded sprites that are now available. This is to avoid
-	// filling the entire backlog of sprites before landing on a planet.
-	GameData::ProcessSprites();
-
 	// Draw a onscreen joystick in the bottom left corner, if enabled
-	if(Preferences::Has("Onscreen Joystick"))
+	if(ONSCREEN_JOYSTICK.Has())
 	{
-		const Interface *mapButtonUi = GameData::Interfaces().Get("main buttons");
+		const Interface *mapButtonUi = MAIN_BUTTONS_INTERFACE.Get();
 		Rectangle bounds = mapButtonUi->GetBox("onscreen joystick");
 		const char* colorStr = "faint";
 		bool joystickMax = touchMoveVector.LengthSquared() > 1;
@@ -1192,10 +1267,10 @@ void Engine::Draw() const
 		}
 	}
 
-	if(Preferences::Has("Show CPU / GPU load"))
+	if(SHOW_CPU_GPU_LOAD.Has())
 	{
 		string loadString = to_string(lround(load * 100.)) + "% CPU";
-		Color color = *colors.Get("medium");
+		Color color = *MEDIUM_COLOR;
 		font.Draw(loadString,
 			Point(-10 - font.Width(loadString), Screen::Height() * -.5 + 5.), color);
 	}
@@ -1221,10 +1296,10 @@ void Engine::Click(const Point &from, const Point &to, bool hasShift, bool hasCo
 	isRightClick = false;
 
 	// Determine if the left-click was within the radar display.
-	const Interface *hud = GameData::Interfaces().Get("hud");
+	const Interface *hud = HUD_INTERFACE.Get();
 	Point radarCenter = hud->GetPoint("radar");
 	double radarRadius = hud->GetValue("radar radius");
-	if(Preferences::Has("Clickable radar display") && (from - radarCenter).Length() <= radarRadius)
+	if(CLICKABLE_RADAR_DISPLAY.Has() && (from - radarCenter).Length() <= radarRadius)
 		isRadarClick = true;
 	else
 		isRadarClick = false;
@@ -1248,10 +1323,10 @@ void Engine::RClick(const Point &point)
 	isRightClick = true;
 
 	// Determine if the right-click was within the radar display, and if so, rescale.
-	const Interface *hud = GameData::Interfaces().Get("hud");
+	const Interface *hud = HUD_INTERFACE.Get();
 	Point radarCenter = hud->GetPoint("radar");
 	double radarRadius = hud->GetValue("radar radius");
-	if(Preferences::Has("Clickable radar display") && (point - radarCenter).Length() <= radarRadius)
+	if(CLICKABLE_RADAR_DISPLAY.Has() && (point - radarCenter).Length() <= radarRadius)
 		clickPoint = (point - radarCenter) / RADAR_SCALE;
 	else
 		clickPoint = point / zoom;
@@ -1299,10 +1374,10 @@ bool Engine::FingerUp(const Point &p, int fid)
 		isDoubleTap = false;
 
 		// Determine if the point was within the radar display.
-		const Interface *hud = GameData::Interfaces().Get("hud");
+		const Interface *hud = HUD_INTERFACE.Get();
 		Point radarCenter = hud->GetPoint("radar");
 		double radarRadius = hud->GetValue("radar radius");
-		if(Preferences::Has("Clickable radar display") && (p - radarCenter).Length() <= radarRadius)
+		if(CLICKABLE_RADAR_DISPLAY.Has() && (p - radarCenter).Length() <= radarRadius)
 			isRadarClick = true;
 		else
 			isRadarClick = false;
@@ -1329,10 +1404,10 @@ bool Engine::FingerMove(const Point &p, int fid)
 		isTouch = true;
 
 		// Determine if the left-click was within the radar display.
-		const Interface *hud = GameData::Interfaces().Get("hud");
+		const Interface *hud = HUD_INTERFACE.Get();
 		Point radarCenter = hud->GetPoint("radar");
 		double radarRadius = hud->GetValue("radar radius");
-		if(Preferences::Has("Clickable radar display") && (p - radarCenter).Length() <= radarRadius)
+		if(CLICKABLE_RADAR_DISPLAY.Has() && (p - radarCenter).Length() <= radarRadius)
 			isRadarClick = true;
 		else
 			isRadarClick = false;
@@ -1607,7 +1682,7 @@ void Engine::CalculateStep()
 		player.SetSystemEntry(wormholeEntry ? SystemEntry::WORMHOLE :
 			flagship->IsUsingJumpDrive() ? SystemEntry::JUMP :
 			SystemEntry::HYPERDRIVE);
-		doFlash = Preferences::Has("Show hyperspace flash");
+		doFlash = SHOW_HYPERSPACE_FLASH.Has();
 		playerSystem = flagship->GetSystem();
 		player.SetSystem(*playerSystem);
 		EnterSystem();
@@ -2262,9 +2337,9 @@ void Engine::HandleMouseClicks()
 
 void Engine::HandleTouchEvents()
 {
-	if(Preferences::Has("Onscreen Joystick"))
+	if(ONSCREEN_JOYSTICK.Has())
 	{
-		const Interface *mapButtonUi = GameData::Interfaces().Get("main buttons");
+		const Interface *mapButtonUi = MAIN_BUTTONS_INTERFACE.Get();
 		Rectangle bounds = mapButtonUi->GetBox("onscreen joystick");
 
 		bool doubleRadius = touchMoveActive;
@@ -2311,7 +2386,7 @@ void Engine::HandleTouchEvents()
 void Engine::HandleMouseInput(Command &activeCommands)
 {
 	isMouseHoldEnabled = activeCommands.Has(Command::MOUSE_TURNING_HOLD);
-	bool isMouseToggleEnabled = Preferences::Has("Control ship with mouse");
+	bool isMouseToggleEnabled = CONTROL_SHIP_WITH_MOUSE.Has();
 
 	// XOR mouse hold and mouse toggle. If mouse toggle is OFF, then mouse hold
 	// will temporarily turn ON mouse control. If mouse toggle is ON, then mouse
@@ -2651,7 +2726,7 @@ void Engine::FillRadar()
 	}
 
 	// Add viewport brackets.
-	if(!Preferences::Has("Disable viewport on radar"))
+	if(!DISABLE_VIEWPORT_ON_RADAR.Has())
 	{
 		radar[calcTickTock].AddViewportBoundary(Screen::TopLeft() / zoom);
 		radar[calcTickTock].AddViewportBoundary(Screen::TopRight() / zoom);
@@ -31,13 +31,17 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 using namespace std;
 
+namespace {
+	const InterfaceRef ESCORT_ELEMENT_INTERFACE("escort element");
+}
+
 
 
 void EscortDisplay::Clear()
 {
 	icons.clear();
 
-	element = GameData::Interfaces().Get("escort element");
+	element = ESCORT_ELEMENT_INTERFACE.Get();
 	basicHeight = element->GetValue("basic height");
 	systemLabelHeight = element->GetValue("system label height");
 }
@@ -1,4 +1,4 @@
-/* ExclusiveItem.h
+/* Etc2RGBA.h
 Copyright (c) 2023 by Rian Shelley
 
 Endless Sky is free software: you can redistribute it and/or modify it under the
@@ -15,51 +15,100 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #ifndef ETC2RGBA_H
 #define ETC2RGBA_H
 
+#include <algorithm>
 #include <cstdint>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 class Etc2RGBA
 {
 public:
    Etc2RGBA(const void* data, int width, int height):
+      m_width(width), m_height(height),
       m_block_width((width+3)/4), m_block_height((height+3)/4),
       m_data(reinterpret_cast<const uint64_t*>(data)) {}
 
    // TODO: do we need the ability to read the color? the alpha is encoded separately
 
-   uint8_t Alpha(int frame, int x, int y)
+   uint8_t Alpha(int frame, int x, int y) const
    {
       // NOTE: this is the same as the R11 format used for red-only textures
+      uint64_t alpha = AlphaBlock(frame, x/4, y/4);
 
+      // alpha represents a 4x4 block of pixels. Get the one we actually want
+      uint8_t palette[8];
+      Palette(alpha, palette);
+      return palette[Index(alpha, x & 3, y & 3)];
+   }
+
+   // Decode the alpha channel of a whole frame into out, which must hold
+   // width * height bytes, stored row by row. Each block is only byteswapped
+   // and has its eight possible values computed once, instead of once for
+   // every one of its sixteen pixels.
+   void AlphaPlane(int frame, uint8_t* out) const
+   {
+      uint8_t palette[8];
+      for (int by = 0; by < m_block_height; ++by)
+      {
+         // the last row and column of blocks may be partially outside the image
+         int rows = std::min(4, m_height - by * 4);
+         for (int bx = 0; bx < m_block_width; ++bx)
+         {
+            int columns = std::min(4, m_width - bx * 4);
+            uint64_t alpha = AlphaBlock(frame, bx, by);
+            Palette(alpha, palette);
+
+            uint8_t* block_out = out + (by * 4) * m_width + bx * 4;
+            for (int y = 0; y < rows; ++y, block_out += m_width)
+               for (int x = 0; x < columns; ++x)
+                  block_out[x] = palette[Index(alpha, x, y)];
+         }
+      }
+   }
+
+private:
+   // Retrieve the alpha block for the given 4x4 block of pixels.
+   uint64_t AlphaBlock(int frame, int bx, int by) const
+   {
       // pixels are encoded in 4x4 blocks, 8 bytes for alpha, followed by 8
-      // bytes for rgba. Retrieve the alpha block.
+      // bytes for rgba.
       uint64_t alpha = *(m_data + (m_block_width * m_block_height * 2 * frame) +
-                                  (m_block_width * 2 * (y/4)) + (x/4) * 2);
+                                  (m_block_width * 2 * by) + bx * 2);
 
       // in big endian format, need to byteswap
       // TODO: is this defined anywhere for us? as-is, this gets converted by
       // gcc into a bswap on x86, and a rev on arm64
-      alpha = (alpha & 0xff00000000000000) >> 56
-            | (alpha & 0x00ff000000000000) >> 40
-            | (alpha & 0x0000ff0000000000) >> 24
-            | (alpha & 0x000000ff00000000) >>  8
-            | (alpha & 0x00000000ff000000) <<  8
-            | (alpha & 0x0000000000ff0000) << 24
-            | (alpha & 0x000000000000ff00) << 40
-            | (alpha & 0x00000000000000ff) << 56;
-
+      return (alpha & 0xff00000000000000) >> 56
+           | (alpha & 0x00ff000000000000) >> 40
+           | (alpha & 0x0000ff0000000000) >> 24
+           | (alpha & 0x000000ff00000000) >>  8
+           | (alpha & 0x00000000ff000000) <<  8
+           | (alpha & 0x0000000000ff0000) << 24
+           | (alpha & 0x000000000000ff00) << 40
+           | (alpha & 0x00000000000000ff) << 56;
+   }
 
-      // alpha represents a 4x4 block of pixels. Get the one we actually want
-      int idx = ((x & 3) << 2) | (y & 3);
-      uint8_t base_codeword = alpha >> 56;
-      uint8_t multiplier = (alpha >> 52) & 0xf;
-      uint8_t table_idx = (alpha >> 48) & 0xf;
+   // Get the 3 bit palette index of the pixel at the given position within
+   // a block. Pixels are stored column by column, from most significant to
+   // least significant.
+   static int Index(uint64_t alpha, int x, int y)
+   {
+      int idx = (x << 2) | y;
+      return (alpha >> ((15 - idx) * 3)) & 7;
+   }
 
-      // pixels are 3 bits each, encoded from most significant to least
-      // significant.
-      int value_index = (alpha >> ((15 - idx) * 3)) & 7;
+   // Compute the eight alpha values that the pixels of a block can select from.
+   static void Palette(uint64_t alpha, uint8_t palette[8])
+   {
+      int base_codeword = alpha >> 56;
+      int multiplier = (alpha >> 52) & 0xf;
+      int table_idx = (alpha >> 48) & 0xf;
 
-      // now we can compute the actual pixel
-      static const int modifier_table[][8] = {
+      static const int16_t modifier_table[][8] = {
          { -3,  -6,  -9, -15,  2,  5,  8, 14 },
          { -3,  -7, -10, -13,  2,  6,  9, 12 },
          { -2,  -5,  -8, -13,  1,  4,  7, 12 },
@@ -77,16 +126,35 @@ public:
          { -4,  -6,  -8,  -9,  3,  5,  7,  8 },
          { -3,  -5,  -7,  -9,  2,  4,  6,  8 },
       };
-      int value = base_codeword + modifier_table[table_idx][value_index] * multiplier;
-      if (value < 0) value = 0;
-      else if (value > 255) value = 255;
-      return value;
+      const int16_t* modifiers = modifier_table[table_idx];
+
+      // value = base + modifier * multiplier, clamped to [0, 255]. All eight
+      // values fit in one vector of 16 bit lanes, and packing them down to
+      // bytes with unsigned saturation does the clamping.
+#if defined(__SSE2__)
+      __m128i value = _mm_add_epi16(_mm_set1_epi16(base_codeword),
+         _mm_mullo_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(modifiers)),
+            _mm_set1_epi16(multiplier)));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(palette), _mm_packus_epi16(value, value));
+#elif defined(__ARM_NEON)
+      int16x8_t value = vmlaq_n_s16(vdupq_n_s16(base_codeword), vld1q_s16(modifiers), multiplier);
+      vst1_u8(palette, vqmovun_s16(value));
+#else
+      for (int i = 0; i < 8; ++i)
+      {
+         int value = base_codeword + modifiers[i] * multiplier;
+         if (value < 0) value = 0;
+         else if (value > 255) value = 255;
+         palette[i] = value;
+      }
+#endif
    }
 
-private:
+   const int m_width;
+   const int m_height;
    const int m_block_width;
    const int m_block_height;
    const uint64_t* const m_data;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -26,8 +26,10 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #define STRICT
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <sys/utime.h>
 #else
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <utime.h>
@@ -599,6 +601,34 @@ time_t Files::Timestamp(const string &filePath)
 
 
 
+// Set the modification time of the given file to the current time.
+void Files::Touch(const string &filePath)
+{
+#if defined _WIN32
+	_wutime(Utf8::ToUTF16(filePath).c_str(), nullptr);
+#else
+	utime(filePath.c_str(), nullptr);
+#endif
+}
+
+
+
+size_t Files::Size(const string &filePath)
+{
+#if defined _WIN32
+	struct _stat buf;
+	if(_wstat(Utf8::ToUTF16(filePath).c_str(), &buf))
+		return 0;
+#else
+	struct stat buf;
+	if(stat(filePath.c_str(), &buf))
+		return 0;
+#endif
+	return buf.st_size;
+}
+
+
+
 void Files::Copy(const string &from, const string &to)
 {
 #if defined _WIN32
@@ -701,20 +731,50 @@ string Files::Read(struct SDL_RWops *file)
 
 
 
-void Files::Write(const string &path, const string &data)
+// Return false if the data could not all be written.
+bool Files::Write(const string &path, const string &data)
 {
-	File file(path, true);
-	Write(file, data);
+	SDL_RWops *file = Open(path, true);
+	if(!file)
+		return false;
+
+	// Data may still be buffered until the file is closed, so closing it can
+	// fail too.
+	bool written = Write(file, data);
+	return !SDL_RWclose(file) && written;
 }
 
 
 
-void Files::Write(struct SDL_RWops *file, const string &data)
+bool Files::Write(struct SDL_RWops *file, const string &data)
 {
 	if(!file)
-		return;
+		return false;
+
+	return SDL_RWwrite(file, data.data(), 1, data.size()) == data.size();
+}
 
-	SDL_RWwrite(file, data.data(), 1, data.size());
+
+
+// Make sure everything written to the given file has reached the disk.
+bool Files::Sync(const string &path)
+{
+#if defined _WIN32
+	HANDLE handle = CreateFileW(Utf8::ToUTF16(path).c_str(), GENERIC_WRITE, 0, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(handle == INVALID_HANDLE_VALUE)
+		return false;
+	bool synced = FlushFileBuffers(handle);
+	CloseHandle(handle);
+	return synced;
+#else
+	int descriptor = open(path.c_str(), O_RDONLY);
+	if(descriptor < 0)
+		return false;
+	bool synced = !fsync(descriptor);
+	close(descriptor);
+	return synced;
+#endif
 }
 
 
@@ -55,6 +55,9 @@ public:
 
 	static bool Exists(const std::string &filePath);
 	static std::time_t Timestamp(const std::string &filePath);
+	// Set the modification time of the given file to the current time.
+	static void Touch(const std::string &filePath);
+	static size_t Size(const std::string &filePath);
 	static void Copy(const std::string &from, const std::string &to);
 	static void Move(const std::string &from, const std::string &to);
 	static void Delete(const std::string &filePath);
@@ -69,8 +72,11 @@ public:
 	static void Close(struct SDL_RWops* ops);
 	static std::string Read(const std::string &path);
 	static std::string Read(struct SDL_RWops *file);
-	static void Write(const std::string &path, const std::string &data);
-	static void Write(struct SDL_RWops *file, const std::string &data);
+	// Return false if the data could not all be written.
+	static bool Write(const std::string &path, const std::string &data);
+	static bool Write(struct SDL_RWops *file, const std::string &data);
+	// Make sure everything written to the given file has reached the disk.
+	static bool Sync(const std::string &path);
 	static void CreateFolder(const std::string &path);
 
 	// Open this user's plugins directory in their native file explorer.
@@ -111,6 +111,7 @@ void FillShader::Fill(const Point &center, const Point &size, const Color &color
 	glUniform4fv(colorI, 1, color.Get());
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	OpenGL::CountDrawCall();
 
 	glBindVertexArray(0);
 	glUseProgram(0);
@@ -486,6 +486,17 @@ int64_t Fleet::Strength() const
 
 
 
+// Add the sprites of all the ships this fleet may spawn to the given set.
+void Fleet::GetSprites(set<const Sprite *> &sprites) const
+{
+	for(const Variant &variant : variants)
+		for(const Ship *ship : variant.Ships())
+			if(ship->HasSprite())
+				sprites.insert(ship->GetSprite());
+}
+
+
+
 // Obtain a positional reference and the radius of the object at that position (e.g. a planet).
 // Spaceport status can be modified during normal gameplay, so this information is not cached.
 pair<Point, double> Fleet::ChooseCenter(const System &system)
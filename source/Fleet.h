@@ -35,6 +35,7 @@ class Outfit;
 class Phrase;
 class Planet;
 class Ship;
+class Sprite;
 class System;
 
 
@@ -75,6 +76,9 @@ public:
 
 	int64_t Strength() const;
 
+	// Add the sprites of all the ships this fleet may spawn to the given set.
+	void GetSprites(std::set<const Sprite *> &sprites) const;
+
 
 private:
 	static std::pair<Point, double> ChooseCenter(const System &system);
@@ -245,6 +245,7 @@ void FogShader::Draw(const Point &center, double zoom, const PlayerInfo &player)
 
 	// Call the shader program to draw the image.
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	OpenGL::CountDrawCall();
 
 	// Clean up.
 	glBindVertexArray(0);
@@ -310,6 +310,9 @@ const vector<ShipManager> &GameAction::Ships() const noexcept
 // Perform the specified tasks.
 void GameAction::Do(PlayerInfo &player, UI *ui, const Mission *caller) const
 {
+	if(!isEmpty)
+		player.BeforeChange();
+
 	if(!logText.empty())
 		player.AddLogEntry(logText);
 	for(auto &&it : specialLogText)
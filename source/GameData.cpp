@@ -37,9 +37,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "GameEvent.h"
 #include "Government.h"
 #include "Hazard.h"
+#include "ImageCache.h"
 #include "ImageSet.h"
 #include "Interface.h"
 #include "LineShader.h"
+#include "MapGeometry.h"
 #include "MaskManager.h"
 #include "Minable.h"
 #include "Mission.h"
@@ -53,6 +55,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Plugins.h"
 #include "PointerShader.h"
 #include "Politics.h"
+#include "Preferences.h"
 #include "RingShader.h"
 #include "Ship.h"
 #include "Sprite.h"
@@ -64,11 +67,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "System.h"
 #include "Test.h"
 #include "TestData.h"
+#include "TextureBudget.h"
 #include "UniverseObjects.h"
 #include "UiRectShader.h"
 
 #include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -86,6 +92,22 @@ namespace {
 	Set<Wormhole> defaultWormholes;
 	TextReplacements defaultSubstitutions;
 
+	// Names of objects that are not reverted, but which may be named by
+	// CheckReferences() when a saved game refers to them.
+	set<string> storedOutfits;
+	set<string> storedShips;
+	set<string> storedEffects;
+	set<string> storedEvents;
+	set<string> storedFormations;
+
+	template <class Type>
+	void StoreNames(const Set<Type> &objects, set<string> &names)
+	{
+		names.clear();
+		for(const auto &it : objects)
+			names.insert(it.first);
+	}
+
 	Politics politics;
 
 	StarField background;
@@ -95,14 +117,101 @@ namespace {
 	vector<string> sources;
 	map<const Sprite *, shared_ptr<ImageSet>> deferred;
 	map<const Sprite *, int> preloaded;
+	// The image sets of the sprites that can be unloaded when they use too much
+	// GPU memory, and the sprites that have been, which must be loaded again
+	// before they can be drawn.
+	map<const Sprite *, shared_ptr<ImageSet>> evictable;
+	set<const Sprite *> evicted;
+	mutex evictedMutex;
+	// The time, in milliseconds, spent uploading sprites each frame while the
+	// game is starting up.
+	constexpr double LOADING_UPLOAD_BUDGET = 12.;
 
 	MaskManager maskManager;
+	TextureBudget textureBudget;
 
 	const Government *playerGovernment = nullptr;
 	map<const System *, map<string, int>> purchases;
 
 	ConditionsStore globalConditions;
 
+	// Whether the checks that require all of the initial sprites or sounds to be
+	// loaded have been done.
+	bool checkedSprites = false;
+	bool checkedSounds = false;
+
+	// Once the initial sprites and sounds have finished loading in the background,
+	// look for invalid file paths and create the scaled collision masks.
+	void CheckInitialLoad()
+	{
+		// The mask scales are registered while loading the game data.
+		if(!GameData::IsCriticalLoaded())
+			return;
+
+		if(!checkedSprites && spriteQueue.GetProgress() == 1.)
+		{
+			checkedSprites = true;
+			// Now that we have finished loading all the basic sprites, we can look for invalid file paths,
+			// e.g. due to capitalization errors or other typos.
+			SpriteSet::CheckReferences();
+			// All sprites with collision masks should also have their 1x scaled versions, so create
+			// any additional scaled masks from the default one.
+			maskManager.ScaleMasks();
+			// The image cache now holds every image that the game needs at
+			// startup, so any space beyond that can be reclaimed.
+			ImageCache::Prune();
+		}
+		if(!checkedSounds && Audio::GetProgress() == 1.)
+		{
+			checkedSounds = true;
+			Audio::CheckReferences();
+		}
+	}
+
+	// Begin loading a deferred sprite with the given priority, unless it is
+	// already loaded or being loaded.
+	void LoadDeferred(const Sprite *sprite, SpriteQueue::Priority priority)
+	{
+		// Make sure this sprite actually is one that uses deferred loading.
+		auto dit = deferred.find(sprite);
+		if(!sprite || dit == deferred.end())
+			return;
+
+		// If this sprite is one of the currently loaded ones, there is no need to
+		// load it again. But, make note of the fact that it is the most recently
+		// asked-for sprite.
+		map<const Sprite *, int>::iterator pit = preloaded.find(sprite);
+		if(pit != preloaded.end())
+		{
+			for(pair<const Sprite * const, int> &it : preloaded)
+				if(it.second < pit->second)
+					++it.second;
+
+			pit->second = 0;
+			return;
+		}
+
+		// This sprite is not currently preloaded. Check to see whether we already
+		// have the maximum number of sprites loaded, in which case the oldest one
+		// must be unloaded to make room for this one.
+		pit = preloaded.begin();
+		while(pit != preloaded.end())
+		{
+			++pit->second;
+			if(pit->second >= 20)
+			{
+				spriteQueue.Unload(pit->first->Name());
+				pit = preloaded.erase(pit);
+			}
+			else
+				++pit;
+		}
+
+		// Now, load all the files for this sprite.
+		preloaded[sprite] = 0;
+		spriteQueue.Add(dit->second, priority);
+	}
+
 	void LoadPlugin(const string &path)
 	{
 		const auto *plugin = Plugins::Load(path);
@@ -160,8 +269,13 @@ future<void> GameData::BeginLoad(bool onlyLoadData, bool debugMode)
 			// For landscapes, remember all the source files but don't load them yet.
 			if(ImageSet::IsDeferred(it.first))
 				deferred[SpriteSet::Get(it.first)] = it.second;
+			else if(ImageSet::IsCritical(it.first))
+				spriteQueue.Add(it.second, SpriteQueue::CRITICAL);
 			else
+			{
 				spriteQueue.Add(it.second);
+				evictable[SpriteSet::Get(it.first)] = it.second;
+			}
 		}
 
 		// Generate a catalog of music files.
@@ -185,6 +299,16 @@ void GameData::FinishLoading()
 	defaultOutfitSales = objects.outfitSales;
 	defaultSubstitutions = objects.substitutions;
 	defaultWormholes = objects.wormholes;
+	// From now on, only events change these objects, so keep track of which
+	// ones they change to make reverting them cheap.
+	objects.fleets.TrackChanges();
+	objects.governments.TrackChanges();
+	objects.planets.TrackChanges();
+	objects.systems.TrackChanges();
+	objects.galaxies.TrackChanges();
+	objects.shipSales.TrackChanges();
+	objects.outfitSales.TrackChanges();
+	objects.wormholes.TrackChanges();
 	playerGovernment = objects.governments.Get("Escort");
 
 	politics.Reset();
@@ -237,11 +361,13 @@ void GameData::LoadShaders()
 	FillShader::Init();
 	FogShader::Init();
 	LineShader::Init();
+	MapGeometry::Init();
 	OutlineShader::Init();
 	PointerShader::Init();
 	RingShader::Init();
 	SpriteShader::Init();
 	BatchShader::Init();
+	Sprite::CreatePlaceholder();
 	
 	UiRectShader::Init(
 		*GameData::Colors().Get("medium"),
@@ -279,56 +405,107 @@ bool GameData::IsLoaded()
 
 
 
+// Get the loading progress of only what is needed to show the main menu:
+// the game data and the sprites used by the menus and the HUD.
+double GameData::GetCriticalProgress()
+{
+	static bool criticalLoaded = false;
+	if(criticalLoaded)
+		return 1.;
+
+	double val = min(spriteQueue.GetProgress(SpriteQueue::CRITICAL), objects.GetProgress());
+	if(val >= 1.)
+		criticalLoaded = true;
+	return val;
+}
+
+
+
+// Whether the main menu can be shown. The remaining sprites continue to
+// load in the background.
+bool GameData::IsCriticalLoaded()
+{
+	return GetCriticalProgress() == 1.;
+}
+
+
+
 // Begin loading a sprite that was previously deferred. Currently this is
 // done with all landscapes to speed up the program's startup.
 void GameData::Preload(const Sprite *sprite)
 {
-	// Make sure this sprite actually is one that uses deferred loading.
-	auto dit = deferred.find(sprite);
-	if(!sprite || dit == deferred.end())
-		return;
+	LoadDeferred(sprite, SpriteQueue::NORMAL);
+}
+
 
-	// If this sprite is one of the currently loaded ones, there is no need to
-	// load it again. But, make note of the fact that it is the most recently
-	// asked-for sprite.
-	map<const Sprite *, int>::iterator pit = preloaded.find(sprite);
-	if(pit != preloaded.end())
-	{
-		for(pair<const Sprite * const, int> &it : preloaded)
-			if(it.second < pit->second)
-				++it.second;
 
-		pit->second = 0;
+// Begin loading a sprite that may be needed soon, after all the sprites
+// that are needed now, if it is a landscape that has not been preloaded or
+// a sprite that was unloaded to save memory.
+void GameData::Prefetch(const Sprite *sprite)
+{
+	if(!sprite)
 		return;
+
+	if(deferred.count(sprite))
+		LoadDeferred(sprite, SpriteQueue::LOW);
+	else
+	{
+		lock_guard<mutex> lock(evictedMutex);
+		if(evicted.erase(sprite))
+			spriteQueue.Add(evictable.find(sprite)->second, SpriteQueue::LOW);
 	}
+}
+
+
+
+// Load the given sprite next, if it is still waiting to be loaded. Return
+// false if it is not waiting, so promoting it did nothing.
+bool GameData::Promote(const Sprite *sprite)
+{
+	if(!sprite)
+		return false;
 
-	// This sprite is not currently preloaded. Check to see whether we already
-	// have the maximum number of sprites loaded, in which case the oldest one
-	// must be unloaded to make room for this one.
-	const string &name = sprite->Name();
-	pit = preloaded.begin();
-	while(pit != preloaded.end())
+	// If this sprite was unloaded to save GPU memory, load it again as soon
+	// as possible.
 	{
-		++pit->second;
-		if(pit->second >= 20)
+		lock_guard<mutex> lock(evictedMutex);
+		if(evicted.erase(sprite))
 		{
-			spriteQueue.Unload(name);
-			pit = preloaded.erase(pit);
+			spriteQueue.Add(evictable.find(sprite)->second, SpriteQueue::CRITICAL);
+			return true;
 		}
-		else
-			++pit;
 	}
-
-	// Now, load all the files for this sprite.
-	preloaded[sprite] = 0;
-	spriteQueue.Add(dit->second);
+	return spriteQueue.Promote(sprite->Name());
 }
 
 
 
-void GameData::ProcessSprites()
+// Upload sprites for part of this frame. Return true if any sprites were
+// still waiting to be loaded, since they may change what is drawn.
+bool GameData::ProcessSprites()
 {
-	spriteQueue.UploadSprites();
+	bool isLoading = spriteQueue.GetProgress(SpriteQueue::LOW) < 1.;
+	// Until the main menu can be shown, only the loading screen is drawn, so
+	// most of each frame can be spent uploading sprites.
+	spriteQueue.UploadSprites(IsCriticalLoaded() ? Preferences::UploadBudget() : LOADING_UPLOAD_BUDGET);
+	CheckInitialLoad();
+
+	// Once all the sprites have been loaded, unload the ones that have not
+	// been drawn for the longest time if the textures use too much memory.
+	if(!checkedSprites)
+		return isLoading;
+	auto canEvict = [](const Sprite *sprite) -> bool { return evictable.count(sprite); };
+	auto lastUse = [](const Sprite *sprite) -> uint64_t { return sprite->LastUse(); };
+	for(const Sprite *sprite : textureBudget.Evict(canEvict, lastUse))
+	{
+		{
+			lock_guard<mutex> lock(evictedMutex);
+			evicted.insert(sprite);
+		}
+		spriteQueue.Unload(sprite->Name());
+	}
+	return isLoading;
 }
 
 
@@ -337,6 +514,7 @@ void GameData::ProcessSprites()
 void GameData::FinishLoadingSprites()
 {
 	spriteQueue.Finish();
+	CheckInitialLoad();
 }
 
 
@@ -360,15 +538,26 @@ UniverseObjects &GameData::Objects()
 // Revert any changes that have been made to the universe.
 void GameData::Revert()
 {
+	// Changing one system updates the neighbors of all the others, and the
+	// wormholes that are generated from planets are changed without going
+	// through their set. In either case it is simplest to restore them all.
+	bool systemsChanged = objects.systems.HasChanges();
+	bool wormholesChanged = systemsChanged || objects.planets.HasChanges();
+
 	objects.fleets.Revert(defaultFleets);
 	objects.governments.Revert(defaultGovernments);
 	objects.planets.Revert(defaultPlanets);
-	objects.systems.Revert(defaultSystems);
+	objects.systems.Revert(defaultSystems, systemsChanged);
 	objects.galaxies.Revert(defaultGalaxies);
 	objects.shipSales.Revert(defaultShipSales);
 	objects.outfitSales.Revert(defaultOutfitSales);
 	objects.substitutions.Revert(defaultSubstitutions);
-	objects.wormholes.Revert(defaultWormholes);
+	objects.wormholes.Revert(defaultWormholes, wormholesChanged);
+	// The economy does not count as a change to a system, so it must be reset
+	// separately for any system that was not reverted.
+	if(!systemsChanged)
+		for(auto &it : objects.systems)
+			it.second.ResetTrade();
 	for(auto &it : objects.persons)
 		it.second.Restore();
 
@@ -378,6 +567,31 @@ void GameData::Revert()
 
 
 
+// Remember which outfits, ships, effects, events, and formations exist now.
+void GameData::StoreReferences()
+{
+	StoreNames(objects.outfits, storedOutfits);
+	StoreNames(objects.ships, storedShips);
+	StoreNames(objects.effects, storedEffects);
+	StoreNames(objects.events, storedEvents);
+	StoreNames(objects.formations, storedFormations);
+}
+
+
+
+// Remove any of those that have only been referred to since. The universe must
+// have been reverted first, so that nothing still points to them.
+void GameData::ForgetNewReferences()
+{
+	objects.outfits.Retain(storedOutfits);
+	objects.ships.Retain(storedShips);
+	objects.effects.Retain(storedEffects);
+	objects.events.Retain(storedEvents);
+	objects.formations.Retain(storedFormations);
+}
+
+
+
 void GameData::SetDate(const Date &date)
 {
 	for(auto &it : objects.systems)
@@ -409,11 +623,15 @@ void GameData::ReadEconomy(const DataNode &node)
 		}
 		else
 		{
-			System &system = *objects.systems.Get(child.Token(0));
+			// Supplies are reset by Revert() for every system, so setting them
+			// does not need to mark the system as changed.
+			System *system = objects.systems.FindUntracked(child.Token(0));
+			if(!system)
+				continue;
 
 			int index = 0;
 			for(const string &commodity : headings)
-				system.SetSupply(commodity, child.Value(++index));
+				system->SetSupply(commodity, child.Value(++index));
 		}
 	}
 }
@@ -873,6 +1091,13 @@ MaskManager &GameData::GetMaskManager()
 
 
 
+TextureBudget &GameData::GetTextureBudget()
+{
+	return textureBudget;
+}
+
+
+
 const TextReplacements &GameData::GetTextReplacements()
 {
 	return objects.substitutions;
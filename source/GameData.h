@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "CategoryTypes.h"
 #include "Sale.h"
 #include "Set.h"
+#include "SetRef.h"
 #include "Trade.h"
 
 #include <future>
@@ -62,6 +63,7 @@ class System;
 class Test;
 class TestData;
 class TextReplacements;
+class TextureBudget;
 class UniverseObjects;
 class Wormhole;
 
@@ -83,10 +85,25 @@ public:
 	static double GetProgress();
 	// Whether initial game loading is complete (data, sprites and audio are loaded).
 	static bool IsLoaded();
+	// Get the loading progress of only what is needed to show the main menu:
+	// the game data and the sprites used by the menus and the HUD.
+	static double GetCriticalProgress();
+	// Whether the main menu can be shown. The remaining sprites continue to
+	// load in the background.
+	static bool IsCriticalLoaded();
 	// Begin loading a sprite that was previously deferred. Currently this is
 	// done with all landscapes to speed up the program's startup.
 	static void Preload(const Sprite *sprite);
-	static void ProcessSprites();
+	// Begin loading a sprite that may be needed soon, after all the sprites
+	// that are needed now, if it is a landscape that has not been preloaded or
+	// a sprite that was unloaded to save memory.
+	static void Prefetch(const Sprite *sprite);
+	// Load the given sprite next, if it is still waiting to be loaded. Return
+	// false if it is not waiting, so promoting it did nothing.
+	static bool Promote(const Sprite *sprite);
+	// Upload sprites for part of this frame. Return true if any sprites were
+	// still waiting to be loaded, since they may change what is drawn.
+	static bool ProcessSprites();
 	// Wait until all pending sprite uploads are completed.
 	static void FinishLoadingSprites();
 
@@ -98,6 +115,12 @@ public:
 
 	// Revert any changes that have been made to the universe.
 	static void Revert();
+	// Remember which outfits, ships, effects, events, and formations exist now.
+	// ForgetNewReferences() removes any that have only been referred to since,
+	// so that they are reported as undefined again if they are referred to by
+	// the next saved game that is checked.
+	static void StoreReferences();
+	static void ForgetNewReferences();
 	static void SetDate(const Date &date);
 	// Functions for the dynamic economy.
 	static void ReadEconomy(const DataNode &node);
@@ -171,6 +194,7 @@ public:
 	static const std::map<std::string, std::string> &HelpTemplates();
 
 	static MaskManager &GetMaskManager();
+	static TextureBudget &GetTextureBudget();
 
 	static const TextReplacements &GetTextReplacements();
 
@@ -187,4 +211,11 @@ private:
 
 
 
+// Handles to the colors and interfaces that are drawn every frame, so that
+// they are only looked up by name once.
+using ColorRef = SetRef<Color, &GameData::Colors>;
+using InterfaceRef = SetRef<Interface, &GameData::Interfaces>;
+
+
+
 #endif
@@ -16,20 +16,17 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "GameLoadingPanel.h"
 
 #include "Angle.h"
-#include "Audio.h"
 #include "Conversation.h"
 #include "ConversationPanel.h"
 #include "CrashState.h"
 #include "Dialog.h"
 #include "GameData.h"
-#include "MaskManager.h"
 #include "MenuAnimationPanel.h"
 #include "MenuPanel.h"
 #include "PlayerInfo.h"
 #include "Point.h"
 #include "PointerShader.h"
 #include "Ship.h"
-#include "SpriteSet.h"
 #include "StarField.h"
 #include "System.h"
 #include "UI.h"
@@ -50,19 +47,15 @@ GameLoadingPanel::GameLoadingPanel(PlayerInfo &player, const Conversation &conve
 
 void GameLoadingPanel::Step()
 {
-	progress = static_cast<int>(GameData::GetProgress() * MAX_TICKS);
+	progress = static_cast<int>(GameData::GetCriticalProgress() * MAX_TICKS);
 
 	// While the game is loading, upload sprites to the GPU.
 	GameData::ProcessSprites();
-	if(GameData::IsLoaded())
+	// The menus can be shown as soon as their sprites are loaded. The rest of
+	// the sprites will continue to load in the background, and the game loop
+	// makes sure they are all done before the player can start flying.
+	if(GameData::IsCriticalLoaded())
 	{
-		// Now that we have finished loading all the basic sprites and sounds, we can look for invalid file paths,
-		// e.g. due to capitalization errors or other typos.
-		SpriteSet::CheckReferences();
-		Audio::CheckReferences();
-		// All sprites with collision masks should also have their 1x scaled versions, so create
-		// any additional scaled masks from the default one.
-		GameData::GetMaskManager().ScaleMasks();
 		// Set the game's initial internal state.
 		GameData::FinishLoading();
 
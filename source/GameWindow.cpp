@@ -271,6 +271,7 @@ void GameWindow::Quit()
 void GameWindow::Step()
 {
 	SDL_GL_SwapWindow(mainWindow);
+	OpenGL::EndFrame();
 }
 
 
@@ -0,0 +1,162 @@
+/* GzipFile.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "GzipFile.h"
+
+#include "Files.h"
+#include "Logger.h"
+
+#include <SDL2/SDL_rwops.h>
+#include <zlib.h>
+
+using namespace std;
+
+namespace {
+	// Data is compressed or decompressed this many bytes at a time.
+	const size_t BLOCK_SIZE = 1 << 16;
+	// Adding 16 to the window size makes zlib read and write gzip headers
+	// instead of zlib headers.
+	const int GZIP_WINDOW_BITS = 15 + 16;
+}
+
+
+
+// Read the whole file, decompressing it if necessary.
+string GzipFile::Read(const string &path)
+{
+	GzipFile file(path);
+	// If the file is not compressed, read it all at once.
+	if(!file.stream)
+		return Files::Read(file.file);
+
+	string result;
+	size_t count = 0;
+	do {
+		size_t size = result.size();
+		result.resize(size + BLOCK_SIZE);
+		count = file.Read(&result[size], BLOCK_SIZE);
+		result.resize(size + count);
+	} while(count);
+	return result;
+}
+
+
+
+// Compress the given data, a block at a time, and write it to the given path.
+// Return false if the file could not be completely written.
+bool GzipFile::Write(const string &path, const string &data)
+{
+	File file(path, true);
+	if(!file)
+		return false;
+
+	z_stream stream = {};
+	if(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+
+	// This is safe: zlib never writes to its input.
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+	stream.avail_in = data.size();
+
+	vector<unsigned char> output(BLOCK_SIZE);
+	int result = Z_OK;
+	while(result == Z_OK)
+	{
+		stream.next_out = output.data();
+		stream.avail_out = output.size();
+		result = deflate(&stream, Z_FINISH);
+
+		size_t count = output.size() - stream.avail_out;
+		if(SDL_RWwrite(file, output.data(), 1, count) != count)
+			break;
+	}
+	deflateEnd(&stream);
+
+	if(result != Z_STREAM_END)
+		Logger::LogError("Error: Unable to write compressed file \"" + path + "\".");
+	return (result == Z_STREAM_END);
+}
+
+
+
+GzipFile::GzipFile(const string &path)
+	: path(path), file(path)
+{
+	if(!file)
+		return;
+
+	// Compressed files are recognized by the two bytes that every gzip file
+	// begins with. Anything else is read as it is.
+	unsigned char magic[2] = {0, 0};
+	size_t count = SDL_RWread(file, magic, 1, 2);
+	SDL_RWseek(file, 0, RW_SEEK_SET);
+	if(count != 2 || magic[0] != 0x1f || magic[1] != 0x8b)
+		return;
+
+	stream.reset(new z_stream());
+	if(inflateInit2(stream.get(), GZIP_WINDOW_BITS) != Z_OK)
+	{
+		Logger::LogError("Error: Unable to decompress \"" + path + "\".");
+		isDone = true;
+	}
+	input.resize(BLOCK_SIZE);
+}
+
+
+
+GzipFile::~GzipFile()
+{
+	if(stream)
+		inflateEnd(stream.get());
+}
+
+
+
+// Read up to the given number of bytes, decompressing them if necessary.
+// Return the number of bytes read, which is zero at the end of the file.
+size_t GzipFile::Read(char *buffer, size_t size)
+{
+	if(!file)
+		return 0;
+	if(!stream)
+		return SDL_RWread(file, buffer, 1, size);
+
+	stream->next_out = reinterpret_cast<Bytef *>(buffer);
+	stream->avail_out = size;
+	while(stream->avail_out && !isDone)
+	{
+		if(!stream->avail_in)
+		{
+			stream->next_in = input.data();
+			stream->avail_in = SDL_RWread(file, input.data(), 1, input.size());
+			if(!stream->avail_in)
+			{
+				Logger::LogError("Warning: Compressed file \"" + path + "\" is truncated.");
+				isDone = true;
+				break;
+			}
+		}
+
+		int result = inflate(stream.get(), Z_NO_FLUSH);
+		if(result == Z_STREAM_END)
+			isDone = true;
+		else if(result != Z_OK)
+		{
+			Logger::LogError("Error: Compressed file \"" + path + "\" is corrupted.");
+			isDone = true;
+		}
+	}
+	return size - stream->avail_out;
+}
@@ -0,0 +1,65 @@
+/* GzipFile.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef GZIP_FILE_H_
+#define GZIP_FILE_H_
+
+#include "File.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct z_stream_s;
+
+
+
+// Class for reading files that may or may not be compressed with gzip. The file
+// is decompressed a block at a time as it is read, so the compressed data never
+// needs to be held in memory. Whether a file is compressed is decided by its
+// contents, not its name, so plain and compressed files can be used in the same
+// places.
+class GzipFile {
+public:
+	// Read the whole file, decompressing it if necessary.
+	static std::string Read(const std::string &path);
+	// Compress the given data, a block at a time, and write it to the given path.
+	// Return false if the file could not be completely written.
+	static bool Write(const std::string &path, const std::string &data);
+
+
+public:
+	explicit GzipFile(const std::string &path);
+	GzipFile(const GzipFile &) = delete;
+	GzipFile &operator=(const GzipFile &) = delete;
+	~GzipFile();
+
+	// Read up to the given number of bytes, decompressing them if necessary.
+	// Return the number of bytes read, which is zero at the end of the file.
+	size_t Read(char *buffer, size_t size);
+
+
+private:
+	std::string path;
+	File file;
+	// These are only used if the file is compressed.
+	std::unique_ptr<z_stream_s> stream;
+	std::vector<unsigned char> input;
+	bool isDone = false;
+};
+
+
+
+#endif
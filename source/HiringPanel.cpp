@@ -31,6 +31,7 @@ HiringPanel::HiringPanel(PlayerInfo &player)
 	: player(player), maxHire(0), maxFire(0)
 {
 	SetTrapAllEvents(false);
+	SetIsStatic(true);
 }
 
 
@@ -16,11 +16,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "ImageBuffer.h"
 
 #include "Etc2RGBA.h"
-#include "File.h"
 #include "Files.h"
+#include "ImageCache.h"
 #include "KtxFile.h"
 #include "Logger.h"
 
+#include <algorithm>
 #include <cassert>
 #include <jpeglib.h>
 #include <png.h>
@@ -33,9 +34,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
-	bool ReadPNG(const string &path, ImageBuffer &buffer, int frame);
-	bool ReadJPG(const string &path, ImageBuffer &buffer, int frame);
-	bool ReadKTX(const string &path, ImageBuffer &buffer);
+	bool ReadPNG(const string &path, const string &data, ImageBuffer &buffer, int frame);
+	bool ReadJPG(const string &path, string &data, ImageBuffer &buffer, int frame);
+	bool ReadKTX(const string &data, ImageBuffer &buffer);
 	void Premultiply(ImageBuffer &buffer, int frame, int additive);
 }
 
@@ -61,6 +62,12 @@ void ImageBuffer::Clear(int frames)
 	delete [] pixels;
 	pixels = nullptr;
 	this->frames = frames;
+	hash = 0;
+	compressed_format = 0;
+	compressed_size = 0;
+	compressed_levels = 1;
+	compressed_levels_size = 0;
+	mask_data.clear();
 }
 
 
@@ -81,15 +88,19 @@ void ImageBuffer::Allocate(int width, int height)
 
 
 
-void ImageBuffer::Assign(const void* data, size_t size, int width, int height, uint32_t compressed_format)
+void ImageBuffer::Assign(const void* data, size_t size, int width, int height, uint32_t compressed_format,
+	int levels, size_t allLevelsSize)
 {
 	if(pixels || !size || !width || !height || !frames)
 		return;
 
-	pixels = new uint32_t[(size + 3) / 4 * 4];
-	memcpy(pixels, data, size);
+	allLevelsSize = max(size, allLevelsSize);
+	pixels = new uint32_t[(allLevelsSize + 3) / 4];
+	memcpy(pixels, data, allLevelsSize);
 	this->compressed_format = compressed_format;
 	this->compressed_size = size;
+	this->compressed_levels = levels;
+	this->compressed_levels_size = allLevelsSize;
 	this->display_width = this->width = width;
 	this->display_height = this->height = height;
 }
@@ -190,9 +201,63 @@ uint8_t ImageBuffer::GetAlpha(int frame, int x, int y) const
 
 
 
+// Decode the alpha component of an entire frame into a plane of
+// width * height bytes, stored row by row.
+void ImageBuffer::GetAlphaPlane(int frame, vector<uint8_t> &plane) const
+{
+	plane.resize(width * height);
+	if(compressed_format == 0)
+	{
+		const uint32_t *it = Begin(0, frame);
+		for(uint8_t &alpha : plane)
+			alpha = *it++ >> 24;
+	}
+	else if(compressed_format == 0x9278    // ETC2 RGBA
+	     || compressed_format == 0x9279)   // ETC2 SRGBA
+	{
+		Etc2RGBA etc(pixels, width, height);
+		etc.AlphaPlane(frame, plane.data());
+	}
+	else
+		fill(plane.begin(), plane.end(), 255);
+}
+
+
+
+// Check whether the image can be reduced to half its size. Compressed
+// textures can only be reduced if they have another mipmap level.
+bool ImageBuffer::CanShrinkToHalfSize() const
+{
+	return pixels && (!compressed_format || compressed_levels > 1);
+}
+
+
+
 void ImageBuffer::ShrinkToHalfSize()
 {
-	assert(!compressed_format);
+	if(compressed_format)
+	{
+		// Drop the first mipmap level. The next one starts after the padding
+		// at the end of this one, preceded by its size.
+		assert(compressed_levels > 1);
+		const char *next = reinterpret_cast<const char *>(pixels) + (compressed_size + 3) / 4 * 4;
+		uint32_t nextSize;
+		memcpy(&nextSize, next, sizeof(nextSize));
+		next += sizeof(nextSize);
+		size_t remaining = compressed_levels_size - (next - reinterpret_cast<const char *>(pixels));
+
+		uint32_t *result = new uint32_t[(remaining + 3) / 4];
+		memcpy(result, next, remaining);
+		delete [] pixels;
+		pixels = result;
+		compressed_size = nextSize;
+		compressed_levels_size = remaining;
+		--compressed_levels;
+		width = max(1, width / 2);
+		height = max(1, height / 2);
+		return;
+	}
+
 	ImageBuffer result(frames);
 	result.Allocate(width / 2, height / 2);
 
@@ -231,45 +296,66 @@ bool ImageBuffer::Read(const string &path, int frame)
 	if(!isPNG && !isJPG && !isKTX)
 		return false;
 
-	if(isPNG && !ReadPNG(path, *this, frame))
-		return false;
-	if(isJPG && !ReadJPG(path, *this, frame))
-		return false;
-	if (isKTX && !ReadKTX(path, *this))
+	// Check if the sprite uses additive blending. Start by getting the index of
+	// the last character before the frame number (if one is specified).
+	int pos = path.length() - 4;
+	if(pos > 3 && !path.compare(pos - 3, 3, "@2x"))
+		pos -= 3;
+	while(--pos)
+		if(path[pos] < '0' || path[pos] > '9')
+			break;
+	// Special case: if the image is already in premultiplied alpha format,
+	// there is no need to apply premultiplication here.
+	int additive = (path[pos] == '+') ? 2 : (path[pos] == '~') ? 1 : 0;
+	bool premultiply = (path[pos] != '=') && (isPNG || additive == 2);
+
+	string data = Files::Read(path);
+	if(data.empty())
 		return false;
 
-	if (!isKTX) // KTX files are always pre-multiplied
+	if(isKTX)
 	{
-		// Check if the sprite uses additive blending. Start by getting the index of
-		// the last character before the frame number (if one is specified).
-		int pos = path.length() - 4;
-		if(pos > 3 && !path.compare(pos - 3, 3, "@2x"))
-			pos -= 3;
-		while(--pos)
-			if(path[pos] < '0' || path[pos] > '9')
-				break;
-		// Special case: if the image is already in premultiplied alpha format,
-		// there is no need to apply premultiplication here.
-		if(path[pos] != '=')
-		{
-			int additive = (path[pos] == '+') ? 2 : (path[pos] == '~') ? 1 : 0;
-			if(isPNG || (isJPG && additive == 2))
-				Premultiply(*this, frame, additive);
-		}
+		// KTX files are always pre-multiplied.
+		if(!ReadKTX(data, *this))
+			return false;
+		hash = ImageCache::Key(data, 0);
+		return true;
 	}
+
+	// If this exact image has been decoded before, there is no need to decode
+	// and premultiply it again.
+	uint64_t key = ImageCache::Key(data, premultiply ? additive : -1);
+	// Combine the keys of all the frames, in the order they are read.
+	hash = (hash ^ key) * 1099511628211ull;
+	if(ImageCache::Read(key, *this, frame))
+		return true;
+
+	if(isPNG && !ReadPNG(path, data, *this, frame))
+		return false;
+	if(isJPG && !ReadJPG(path, data, *this, frame))
+		return false;
+
+	if(premultiply)
+		Premultiply(*this, frame, additive);
+
+	ImageCache::Write(key, *this, frame);
 	return true;
 }
 
 
 
+// Get a hash of the contents of all the image files that have been read
+// into this buffer since it was last cleared.
+uint64_t ImageBuffer::Hash() const
+{
+	return hash;
+}
+
+
+
 namespace {
-	bool ReadPNG(const string &path, ImageBuffer &buffer, int frame)
+	bool ReadPNG(const string &path, const string &data, ImageBuffer &buffer, int frame)
 	{
-		// Open the file, and make sure it really is a PNG.
-		File file(path);
-		if(!file)
-			return false;
-
 		// Set up libpng.
 		png_struct *png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
 		if(!png)
@@ -293,10 +379,10 @@ namespace {
 
 		// Not using SDLRW_ops directly here, because of preprocessor conflicts with libjpeg on windows.
 		struct MemBuffer {
-			std::string data;
+			const std::string &data;
 			size_t pos;
 		} pngData {
-			Files::Read(file),
+			data,
 			0
 		};
 		png_set_read_fn(png, &pngData, [](png_struct* png, png_bytep data, size_t length) {
@@ -380,12 +466,8 @@ namespace {
 
 
 
-	bool ReadJPG(const string &path, ImageBuffer &buffer, int frame)
+	bool ReadJPG(const string &path, string &data, ImageBuffer &buffer, int frame)
 	{
-		File file(path);
-		if(!file)
-			return false;
-
 		jpeg_decompress_struct cinfo;
 		struct jpeg_error_mgr jerr;
 		cinfo.err = jpeg_std_error(&jerr);
@@ -394,8 +476,7 @@ namespace {
 		jpeg_create_decompress(&cinfo);
 #pragma GCC diagnostic pop
 
-		std::string jpg_data = Files::Read(file);
-		jpeg_mem_src(&cinfo, reinterpret_cast<unsigned char*>(&jpg_data[0]), jpg_data.size());
+		jpeg_mem_src(&cinfo, reinterpret_cast<unsigned char*>(&data[0]), data.size());
 		jpeg_read_header(&cinfo, true);
 		cinfo.out_color_space = JCS_EXT_RGBA;
 
@@ -443,22 +524,18 @@ namespace {
 
 
 
-	bool ReadKTX(const string &path, ImageBuffer &buffer)
+	bool ReadKTX(const string &data, ImageBuffer &buffer)
 	{
-		File file(path);
-		if(!file)
-			return false;
-
-		std::string ktx_data = Files::Read(file);
-
-		KtxFile ktx(ktx_data);
+		KtxFile ktx(data);
 		if (!ktx.Valid())
 			return false;
 
 		// frames are stored in ktx file together.
 		buffer.Clear(ktx.Frames());
-		buffer.Assign(ktx.Data(), ktx.Size(), ktx.Width(), ktx.Height(), ktx.InternalFormat());
+		buffer.Assign(ktx.Data(), ktx.Size(), ktx.Width(), ktx.Height(), ktx.InternalFormat(),
+			ktx.Levels(), ktx.AllLevelsSize());
 		buffer.SetDisplaySize(ktx.OriginalWidth(), ktx.OriginalHeight());
+		buffer.SetMaskData(ktx.MaskData());
 		return true;
 	}
 
@@ -18,6 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 
 
@@ -43,8 +44,11 @@ public:
 	// image buffer; subsequent calls will be ignored.
 	void Allocate(int width, int height);
 
-	// Assign the internal buffer all at once
-	void Assign(const void* data, size_t size, int width, int height, uint32_t compressed_format);
+	// Assign the internal buffer all at once. For compressed textures with
+	// mipmaps, allLevelsSize covers the data of all the levels, each after the
+	// first preceded by its size.
+	void Assign(const void* data, size_t size, int width, int height, uint32_t compressed_format,
+		int levels = 1, size_t allLevelsSize = 0);
 	void SetDisplaySize(int dw, int dh);
 
 	int Width() const;
@@ -61,17 +65,31 @@ public:
 
 	// get the alpha component without making assumptions about the buffer format
 	uint8_t GetAlpha(int frame, int x, int y) const;
+	// Decode the alpha component of an entire frame into a plane of
+	// width * height bytes, stored row by row.
+	void GetAlphaPlane(int frame, std::vector<uint8_t> &plane) const;
 
+	// Check whether the image can be reduced to half its size. Compressed
+	// textures can only be reduced if they have another mipmap level.
+	bool CanShrinkToHalfSize() const;
 	void ShrinkToHalfSize();
 
 	// Read a single frame. Return false if an error is encountered - either the
 	// image is the wrong size, or it is not a supported image format.
 	bool Read(const std::string &path, int frame = 0);
+	// Get a hash of the contents of all the image files that have been read
+	// into this buffer since it was last cleared.
+	uint64_t Hash() const;
 
 
 	uint32_t CompressedFormat() const { return compressed_format; }
 	uint32_t CompressedSize() const { return compressed_size; }
 
+	// Collision mask outlines that were precomputed along with a compressed
+	// texture, if any.
+	const std::string &MaskData() const { return mask_data; }
+	void SetMaskData(std::string data) { mask_data = std::move(data); }
+
 private:
 	int width;
 	int height;
@@ -82,6 +100,11 @@ private:
 
 	uint32_t compressed_format = 0;
 	uint32_t compressed_size = 0;
+	int compressed_levels = 1;
+	size_t compressed_levels_size = 0;
+	std::string mask_data;
+
+	uint64_t hash = 0;
 };
 
 
@@ -0,0 +1,407 @@
+/* ImageCache.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ImageCache.h"
+
+#include "File.h"
+#include "Files.h"
+#include "ImageBuffer.h"
+#include "Mask.h"
+#include "Point.h"
+
+#include <SDL2/SDL_rwops.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+
+namespace {
+	// Every cache file begins with this header. Changing the version number
+	// invalidates all existing cache entries.
+	const char MAGIC[4] = {'E', 'S', 'I', 'C'};
+	constexpr uint32_t VERSION = 1;
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	// Mask cache files store a frame count after the magic and version, then
+	// for each frame the number of outlines, and for each outline the number
+	// of points followed by their coordinates.
+	const char MASK_MAGIC[4] = {'E', 'S', 'M', 'C'};
+	constexpr uint32_t MASK_VERSION = 2;
+
+	atomic<bool> isDisabled(false);
+
+	// Entries that were read or written since this time are in use, and must
+	// not be pruned. Some file systems only store modification times to the
+	// nearest two seconds, so allow for that much rounding.
+	const time_t SESSION_START = time(nullptr) - 2;
+
+	// Entries are written under a temporary name and then renamed, so that an
+	// interrupted write never leaves a truncated entry behind.
+	const string TEMPORARY = ".tmp";
+
+	bool IsTemporary(const string &path)
+	{
+		return path.size() > TEMPORARY.size()
+			&& !path.compare(path.size() - TEMPORARY.size(), TEMPORARY.size(), TEMPORARY);
+	}
+
+	// Two threads may store the same entry at once if two sprites have
+	// identical images, so each write needs a temporary file of its own.
+	string TemporaryPath(const string &path)
+	{
+		static atomic<unsigned> count(0);
+		return path + "." + to_string(count++) + TEMPORARY;
+	}
+
+	// Delete the least recently used files in the given directory that have
+	// not been used since the game started, until those fit in the given number
+	// of bytes.
+	void PruneDirectory(const string &directory, size_t budget)
+	{
+		struct Entry {
+			time_t used;
+			size_t size;
+			string path;
+		};
+		vector<Entry> entries;
+		size_t total = 0;
+		for(string &path : Files::List(directory))
+		{
+			time_t used = Files::Timestamp(path);
+			if(IsTemporary(path) || used >= SESSION_START)
+				continue;
+			size_t size = Files::Size(path);
+			total += size;
+			entries.push_back({used, size, std::move(path)});
+		}
+		if(total <= budget)
+			return;
+
+		sort(entries.begin(), entries.end(),
+			[](const Entry &a, const Entry &b) { return a.used < b.used; });
+		for(const Entry &entry : entries)
+		{
+			if(total <= budget)
+				break;
+			Files::Delete(entry.path);
+			total -= entry.size;
+		}
+	}
+
+	// Get the directory that the cache files of the given kind and version are
+	// stored in, creating it if needed. The directories of any other version of
+	// that cache can never be read again, so they are deleted, as are any
+	// temporary files left over from an earlier run that was interrupted.
+	string MakeDirectory(const string &name, uint32_t version)
+	{
+		string root = Files::Config() + "cache/";
+		Files::CreateFolder(root);
+		string path = root + name + "-" + to_string(version) + "/";
+		// Before the version was part of the name, each cache had a single directory.
+		string unversioned = root + name + "/";
+		string prefix = root + name + "-";
+		for(const string &directory : Files::ListDirectories(root))
+			if(directory != path && (directory == unversioned || !directory.compare(0, prefix.size(), prefix)))
+			{
+				for(const string &file : Files::List(directory))
+					Files::Delete(file);
+				Files::RmDir(directory);
+			}
+
+		Files::CreateFolder(path);
+		for(const string &file : Files::List(path))
+			if(IsTemporary(file))
+				Files::Delete(file);
+		return path;
+	}
+
+	string Path(const string &directory, uint64_t key)
+	{
+		static const char HEX[] = "0123456789abcdef";
+		string name(16, '0');
+		for(int i = 15; i >= 0; --i, key >>= 4)
+			name[i] = HEX[key & 0xF];
+		return directory + name;
+	}
+
+	// Function-local statics are initialized in a thread-safe way, and the
+	// images are read by multiple threads.
+	const string &ImageDirectory()
+	{
+		static const string directory = MakeDirectory("images", VERSION);
+		return directory;
+	}
+
+	const string &MaskDirectory()
+	{
+		static const string directory = MakeDirectory("masks", MASK_VERSION);
+		return directory;
+	}
+}
+
+
+
+// Stop reading and writing any cache entries, so that programs other than the
+// game itself (like the asset compiler) leave the cache alone.
+void ImageCache::Disable()
+{
+	isDisabled = true;
+}
+
+
+
+// Delete the entries that have not been used since the game started, least
+// recently used first, until they take up no more than the given number of
+// bytes in each cache. The entries that have been used are never deleted,
+// because the next launch will most likely need them again.
+void ImageCache::Prune(size_t unusedBytes)
+{
+	if(isDisabled)
+		return;
+
+	PruneDirectory(ImageDirectory(), unusedBytes);
+	PruneDirectory(MaskDirectory(), unusedBytes);
+}
+
+
+
+// Get the key for the image with the given file contents, when loaded with
+// the given blending mode.
+uint64_t ImageCache::Key(const string &data, int additive)
+{
+	// 64-bit FNV-1a hash of the file contents, followed by the blending mode.
+	uint64_t hash = 14695981039346656037ull;
+	for(char c : data)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	hash ^= static_cast<uint64_t>(additive);
+	hash *= 1099511628211ull;
+	return hash;
+}
+
+
+
+// Read the cached pixels for the given key into the given frame of the buffer.
+// Return false if there is no valid cache entry, or if its dimensions do not
+// match the frames that have already been read into the buffer.
+bool ImageCache::Read(uint64_t key, ImageBuffer &buffer, int frame)
+{
+	if(isDisabled)
+		return false;
+
+	string path = Path(ImageDirectory(), key);
+	if(!Files::Exists(path))
+		return false;
+
+	File file(path);
+	if(!file)
+		return false;
+
+	Header header;
+	if(SDL_RWread(file, &header, sizeof(header), 1) != 1)
+		return false;
+	if(memcmp(header.magic, MAGIC, sizeof(MAGIC)) || header.version != VERSION
+			|| !header.width || !header.height)
+		return false;
+
+	// A cache file that was only partially written must not be used.
+	size_t size = static_cast<size_t>(header.width) * header.height * sizeof(uint32_t);
+	if(static_cast<size_t>(SDL_RWsize(file)) != sizeof(header) + size)
+		return false;
+
+	// If the buffer is not yet allocated, allocate it. Otherwise, this frame
+	// must have the same dimensions as the ones already read. If it does not,
+	// let the image decoder report the error.
+	int width = header.width;
+	int height = header.height;
+	buffer.Allocate(width, height);
+	if(width != buffer.Width() || height != buffer.Height())
+		return false;
+
+	// Read the pixels directly into their place in the buffer.
+	if(SDL_RWread(file, buffer.Begin(0, frame), size, 1) != 1)
+		return false;
+
+	// Mark this entry as recently used, so it is the last to be pruned.
+	Files::Touch(path);
+	return true;
+}
+
+
+
+// Store the given frame of the buffer under the given key.
+void ImageCache::Write(uint64_t key, const ImageBuffer &buffer, int frame)
+{
+	if(isDisabled || buffer.CompressedFormat() || !buffer.Pixels())
+		return;
+
+	Header header;
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.width = buffer.Width();
+	header.height = buffer.Height();
+
+	size_t size = static_cast<size_t>(header.width) * header.height * sizeof(uint32_t);
+	string path = Path(ImageDirectory(), key);
+	string temporary = TemporaryPath(path);
+	bool written = false;
+	{
+		File file(temporary, true);
+		if(!file)
+			return;
+		written = SDL_RWwrite(file, &header, sizeof(header), 1) == 1
+			&& SDL_RWwrite(file, buffer.Begin(0, frame), size, 1) == 1;
+	}
+	if(written)
+		Files::Move(temporary, path);
+	else
+		Files::Delete(temporary);
+}
+
+
+
+// Read the collision masks for all frames of the sprite whose images have
+// the given hash (see ImageBuffer::Hash()). Return false if there is no valid
+// cache entry for exactly the given number of frames.
+bool ImageCache::ReadMasks(uint64_t hash, vector<Mask> &masks, size_t frames)
+{
+	if(isDisabled)
+		return false;
+
+	string path = Path(MaskDirectory(), hash);
+	if(!Files::Exists(path))
+		return false;
+
+	if(!ParseMaskData(Files::Read(path), masks, frames))
+		return false;
+
+	Files::Touch(path);
+	return true;
+}
+
+
+
+// Store the collision masks generated for the sprite with the given hash.
+void ImageCache::WriteMasks(uint64_t hash, const vector<Mask> &masks)
+{
+	if(isDisabled)
+		return;
+
+	string path = Path(MaskDirectory(), hash);
+	string temporary = TemporaryPath(path);
+	if(Files::Write(temporary, MaskData(masks)))
+		Files::Move(temporary, path);
+	else
+		Files::Delete(temporary);
+}
+
+
+
+// Convert collision masks to and from the format they are cached in. This
+// is also how the offline asset compiler stores them in compressed textures.
+string ImageCache::MaskData(const vector<Mask> &masks)
+{
+	string data(MASK_MAGIC, sizeof(MASK_MAGIC));
+	auto Append = [&data](const void *value, size_t size) {
+		data.append(reinterpret_cast<const char *>(value), size);
+	};
+	auto AppendCount = [&Append](size_t value) {
+		uint32_t count = value;
+		Append(&count, sizeof(count));
+	};
+
+	Append(&MASK_VERSION, sizeof(MASK_VERSION));
+	AppendCount(masks.size());
+	for(const Mask &mask : masks)
+	{
+		AppendCount(mask.Outlines().size());
+		for(const vector<Point> &outline : mask.Outlines())
+		{
+			AppendCount(outline.size());
+			for(const Point &point : outline)
+			{
+				double coordinates[2] = {point.X(), point.Y()};
+				Append(coordinates, sizeof(coordinates));
+			}
+		}
+	}
+	return data;
+}
+
+
+
+bool ImageCache::ParseMaskData(const string &data, vector<Mask> &masks, size_t frames)
+{
+	size_t pos = 0;
+	// Copy the next value out of the data, making sure not to read past the end.
+	auto Read = [&data, &pos](void *value, size_t size) -> bool {
+		if(data.size() - pos < size)
+			return false;
+		memcpy(value, data.data() + pos, size);
+		pos += size;
+		return true;
+	};
+
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t count = 0;
+	if(!Read(magic, sizeof(magic)) || memcmp(magic, MASK_MAGIC, sizeof(MASK_MAGIC))
+			|| !Read(&version, sizeof(version)) || version != MASK_VERSION
+			|| !Read(&count, sizeof(count)) || count != frames)
+		return false;
+
+	vector<Mask> result;
+	result.reserve(frames);
+	for(size_t i = 0; i < frames; ++i)
+	{
+		uint32_t outlineCount = 0;
+		// Make sure that corrupt data cannot cause a huge allocation.
+		if(!Read(&outlineCount, sizeof(outlineCount)) || outlineCount > data.size() - pos)
+			return false;
+
+		vector<vector<Point>> outlines(outlineCount);
+		for(vector<Point> &outline : outlines)
+		{
+			uint32_t pointCount = 0;
+			if(!Read(&pointCount, sizeof(pointCount)) || pointCount > (data.size() - pos) / (2 * sizeof(double)))
+				return false;
+
+			outline.reserve(pointCount);
+			for(uint32_t j = 0; j < pointCount; ++j)
+			{
+				double coordinates[2];
+				Read(coordinates, sizeof(coordinates));
+				outline.emplace_back(coordinates[0], coordinates[1]);
+			}
+		}
+		result.emplace_back(std::move(outlines));
+		if(!result.back().IsLoaded())
+			return false;
+	}
+
+	masks.swap(result);
+	return true;
+}
@@ -0,0 +1,74 @@
+/* ImageCache.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IMAGE_CACHE_H_
+#define IMAGE_CACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ImageBuffer;
+class Mask;
+
+
+
+// Decoding PNG and JPG images and tracing the collision masks of ship and
+// asteroid sprites are the slowest parts of starting the game. This class
+// stores the decoded (and premultiplied) pixels of each image, and the mask
+// outlines of each masked sprite, in the user's config directory, so that the
+// next time the game starts they can be read back instead. Each entry is named
+// after a hash of the source files' contents, so an image that changes simply
+// gets a new entry. Once the game has loaded its images, the entries that it
+// did not use are pruned, least recently used first, if they take up too much
+// space.
+class ImageCache {
+public:
+	// Stop reading and writing any cache entries, so that programs other than
+	// the game itself (like the asset compiler) leave the cache alone.
+	static void Disable();
+	// Delete the entries that have not been used since the game started, least
+	// recently used first, until they take up no more than the given number of
+	// bytes in each cache. The entries that have been used are never deleted,
+	// because the next launch will most likely need them again.
+	static void Prune(size_t unusedBytes = static_cast<size_t>(256) << 20);
+
+	// Get the key for the image with the given file contents, when loaded with
+	// the given blending mode.
+	static uint64_t Key(const std::string &data, int additive);
+
+	// Read the cached pixels for the given key into the given frame of the buffer.
+	// Return false if there is no valid cache entry, or if its dimensions do not
+	// match the frames that have already been read into the buffer.
+	static bool Read(uint64_t key, ImageBuffer &buffer, int frame);
+	// Store the given frame of the buffer under the given key.
+	static void Write(uint64_t key, const ImageBuffer &buffer, int frame);
+
+	// Read the collision masks for all frames of the sprite whose images have
+	// the given hash (see ImageBuffer::Hash()). Return false if there is no valid
+	// cache entry for exactly the given number of frames.
+	static bool ReadMasks(uint64_t hash, std::vector<Mask> &masks, size_t frames);
+	// Store the collision masks generated for the sprite with the given hash.
+	static void WriteMasks(uint64_t hash, const std::vector<Mask> &masks);
+
+	// Convert collision masks to and from the format they are cached in. This
+	// is also how the offline asset compiler stores them in compressed textures.
+	static std::string MaskData(const std::vector<Mask> &masks);
+	static bool ParseMaskData(const std::string &data, std::vector<Mask> &masks, size_t frames);
+};
+
+
+
+#endif
@@ -17,11 +17,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "GameData.h"
 #include "ImageBuffer.h"
+#include "ImageCache.h"
 #include "Logger.h"
 #include "Mask.h"
 #include "MaskManager.h"
 #include "Sprite.h"
 #include "Preferences.h"
+#include "TextureAtlas.h"
+#include "TextureBudget.h"
 
 #include <algorithm>
 #include <cassert>
@@ -185,6 +188,22 @@ bool ImageSet::IsDeferred(const string &path)
 
 
 
+// Determine whether the given path or name is for a sprite that is needed
+// to display the menus or the HUD, and so should be loaded first.
+bool ImageSet::IsCritical(const string &path)
+{
+	if(path.length() >= 3 && !path.compare(0, 3, "ui/"))
+		return true;
+	if(path.length() >= 5 && !path.compare(0, 5, "icon/"))
+		return true;
+	if(path.length() >= 6 && !path.compare(0, 6, "_menu/"))
+		return true;
+
+	return false;
+}
+
+
+
 ImageSet::ImageSet(string name)
 	: name(std::move(name))
 {
@@ -257,7 +276,8 @@ void ImageSet::Load() noexcept(false)
 {
 	assert(framePaths[0].empty() && "should call ValidateFrames before calling Load");
 
-	if (Preferences::Has("Reduced graphics") && paths[0].size() > 10)
+	// If the sprite is being loaded again, the frames have already been reduced.
+	if (!wasUploaded && Preferences::Has("Reduced graphics") && paths[0].size() > 10)
 	{
 		// remove every other frame
 		for (ssize_t i = paths[0].size() - 1; i >= 0; i -= 2)
@@ -275,23 +295,46 @@ void ImageSet::Load() noexcept(false)
 	buffer[2].Clear(frames);
 	buffer[3].Clear(frames);
 
-	// Check whether we need to generate collision masks.
-	bool makeMasks = IsMasked(name);
-	if(makeMasks)
-		masks.resize(frames);
-
 	// Load the 1x sprites first, then the 2x sprites, because they are likely
-	// to be in separate locations on the disk. Create masks if needed.
+	// to be in separate locations on the disk.
+	vector<bool> isRead(frames, false);
+	bool allRead = true;
 	for(size_t i = 0; i < frames; ++i)
 	{
-		if(!buffer[0].Read(paths[0][i], i))
+		isRead[i] = buffer[0].Read(paths[0][i], i);
+		if(!isRead[i])
+		{
+			allRead = false;
 			Logger::LogError("Failed to read image data for \"" + name + "\" frame #" + to_string(i));
-		else if(makeMasks)
+		}
+	}
+
+	// Check whether we need collision masks, which is only the first time the
+	// sprite is loaded. Tracing them is expensive, so use the ones that were
+	// compiled into the texture if there are any, or if they were generated
+	// from these same images before, use the cached copy.
+	// A compressed texture stores all of its frames in a single file.
+	size_t maskFrames = buffer[0].Frames();
+	isRead.resize(maskFrames, allRead);
+	if(!wasUploaded && IsMasked(name) && !(allRead && (ImageCache::ParseMaskData(buffer[0].MaskData(), masks, maskFrames)
+			|| ImageCache::ReadMasks(buffer[0].Hash(), masks, maskFrames))))
+	{
+		masks.clear();
+		masks.resize(maskFrames);
+		bool allCreated = allRead;
+		for(size_t i = 0; i < maskFrames; ++i)
 		{
+			if(!isRead[i])
+				continue;
 			masks[i].Create(buffer[0], i);
 			if(!masks[i].IsLoaded())
+			{
+				allCreated = false;
 				Logger::LogError("Failed to create collision mask for \"" + name + "\" frame #" + to_string(i));
+			}
 		}
+		if(allCreated)
+			ImageCache::WriteMasks(buffer[0].Hash(), masks);
 	}
 
 	auto LoadSprites = [&](vector<string> &toLoad, ImageBuffer &buffer, const string &specifier) {
@@ -322,16 +365,87 @@ void ImageSet::Load() noexcept(false)
 
 
 
-// Create the sprite and upload the image data to the GPU. After this is
-// called, the internal image buffers and mask vector will be cleared, but
-// the paths are saved in case the sprite needs to be loaded again.
-void ImageSet::Upload(Sprite *sprite)
+// Get the paths of the images that will be loaded, after ValidateFrames()
+// has been called: 1x, @2x, mask and @2x mask.
+const vector<string> &ImageSet::Paths(int index) const
+{
+	return paths[index];
+}
+
+
+
+// Get the data loaded from those images, and the collision masks generated
+// for them, after Load() has been called. This is used by the offline asset
+// compiler; the game itself only needs to Upload() them.
+ImageBuffer &ImageSet::Buffer(int index)
+{
+	return buffer[index];
+}
+
+
+
+const vector<Mask> &ImageSet::Masks() const
+{
+	return masks;
+}
+
+
+
+// Upload as much of the image data to the GPU as possible before the given
+// deadline, and return the fraction of it that has been uploaded. Once all of
+// it has been, the internal image buffers and mask vector are cleared, but the
+// paths are saved in case the sprite needs to be loaded again.
+double ImageSet::Upload(Sprite *sprite, chrono::steady_clock::time_point deadline)
+{
+	// Small sprites without swizzle masks are packed into shared textures
+	// instead, which clears their buffers. This is only tried when the upload
+	// starts, since the buffers may be changed as they are uploaded.
+	if(!isUploading && !buffer[2].Pixels() && !buffer[3].Pixels())
+		TextureAtlas::Add(sprite, buffer[0], buffer[1]);
+	isUploading = true;
+
+	// Upload the 1x and @2x frames, then their swizzle masks. Each buffer is
+	// cleared once it has been uploaded.
+	for(bool isFirst = true; uploadIndex < 4; ++uploadIndex)
+	{
+		ImageBuffer &current = buffer[uploadIndex];
+		if(!current.Pixels())
+			continue;
+		if(!isFirst && chrono::steady_clock::now() >= deadline)
+			return uploadIndex / 4.;
+		isFirst = false;
+
+		bool is2x = uploadIndex % 2;
+		double progress = (uploadIndex < 2) ? sprite->AddFrames(current, is2x, deadline)
+			: sprite->AddSwizzleMaskFrames(current, is2x, deadline);
+		if(progress < 1.)
+			return (uploadIndex + progress) / 4.;
+	}
+	isUploading = false;
+	uploadIndex = 0;
+
+	// The masks may already be in use if the sprite is being loaded again.
+	if(!wasUploaded)
+		GameData::GetMaskManager().SetMasks(sprite, std::move(masks));
+	masks.clear();
+	wasUploaded = true;
+	// Only count the sprite's textures once all of them are uploaded, so that
+	// it cannot be unloaded while some of them are still being uploaded. A
+	// sprite in the atlas has no textures of its own, and is never unloaded.
+	if(sprite->TextureBytes())
+		GameData::GetTextureBudget().Add(sprite, sprite->TextureBytes());
+	return 1.;
+}
+
+
+
+// Stop an upload that is in progress, because the sprite was unloaded. The
+// image buffers and masks are cleared as if the upload had finished.
+void ImageSet::CancelUpload()
 {
-	// Load the frames (this will clear the buffers).
-	sprite->AddFrames(buffer[0], false);
-	sprite->AddFrames(buffer[1], true);
-	sprite->AddSwizzleMaskFrames(buffer[2], false);
-	sprite->AddSwizzleMaskFrames(buffer[3], true);
-	GameData::GetMaskManager().SetMasks(sprite, std::move(masks));
+	isUploading = false;
+	uploadIndex = 0;
+	for(ImageBuffer &it : buffer)
+		it.Clear();
 	masks.clear();
 }
@@ -18,6 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "ImageBuffer.h"
 
+#include <chrono>
 #include <cstddef>
 #include <map>
 #include <string>
@@ -41,6 +42,9 @@ public:
 	// Determine whether the given path or name is for a sprite whose loading
 	// should be deferred until needed.
 	static bool IsDeferred(const std::string &path);
+	// Determine whether the given path or name is for a sprite that is needed
+	// to display the menus or the HUD, and so should be loaded first.
+	static bool IsCritical(const std::string &path);
 
 
 public:
@@ -60,10 +64,22 @@ public:
 	// Load all the frames. This should be called in one of the image-loading
 	// worker threads. This also generates collision masks if needed.
 	void Load() noexcept(false);
-	// Create the sprite and upload the image data to the GPU. After this is
-	// called, the internal image buffers and mask vector will be cleared, but
-	// the paths are saved in case the sprite needs to be loaded again.
-	void Upload(Sprite *sprite);
+	// Get the paths of the images that will be loaded, after ValidateFrames()
+	// has been called: 1x, @2x, mask and @2x mask.
+	const std::vector<std::string> &Paths(int index) const;
+	// Get the data loaded from those images, and the collision masks generated
+	// for them, after Load() has been called. This is used by the offline asset
+	// compiler; the game itself only needs to Upload() them.
+	ImageBuffer &Buffer(int index);
+	const std::vector<Mask> &Masks() const;
+	// Upload as much of the image data to the GPU as possible before the given
+	// deadline, and return the fraction of it that has been uploaded. Once all of
+	// it has been, the internal image buffers and mask vector are cleared, but the
+	// paths are saved in case the sprite needs to be loaded again.
+	double Upload(Sprite *sprite, std::chrono::steady_clock::time_point deadline);
+	// Stop an upload that is in progress, because the sprite was unloaded. The
+	// image buffers and masks are cleared as if the upload had finished.
+	void CancelUpload();
 
 
 private:
@@ -76,6 +92,13 @@ private:
 	// Data loaded from the images:
 	ImageBuffer buffer[4];
 	std::vector<Mask> masks;
+	// Whether these images have been uploaded before. Sprites can be unloaded
+	// to save memory, and then loaded again from the same image set.
+	bool wasUploaded = false;
+	// Whether an upload has been started and not yet finished, and which
+	// buffer is being uploaded.
+	bool isUploading = false;
+	int uploadIndex = 0;
 };
 
 
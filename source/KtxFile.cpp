@@ -2,6 +2,7 @@
 
 #include "opengl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
@@ -65,18 +66,32 @@ KtxFile::KtxFile(const std::string& data)
 	default: return;
 	}
 
-	// Don't support mipmaps, faces, or depth
-	if (header->mipmaps > 1) return;
+	// Don't support faces or depth
 	if (header->faces > 1) return;
 	if (header->depth > 1) return;
 
-	// Do support arrays, as this is how we handle animation frames.
+	// Do support arrays, as this is how we handle animation frames, and
+	// mipmaps, which are used in place of shrinking the texture when in
+	// reduced graphics mode.
 
-	// Validate that we have as much data as it claims we do.
+	// Validate that we have as much data as it claims we do, for every level.
 	ssize_t remaining_size = data.size() - sizeof(ktx_header) - header->key_value_data;
-	if (remaining_size < static_cast<ssize_t>(sizeof(uint32_t))) return;
-	uint32_t image_size = *reinterpret_cast<const uint32_t*>(data.data() + sizeof(ktx_header) + header->key_value_data);
-	if (remaining_size - image_size < 0) return;
+	const char* level = data.data() + sizeof(ktx_header) + header->key_value_data;
+	const char* first = level + sizeof(uint32_t);
+	for (uint32_t i = 0; i < std::max<uint32_t>(header->mipmaps, 1); ++i)
+	{
+		if (remaining_size < static_cast<ssize_t>(sizeof(uint32_t))) return;
+		uint32_t image_size = *reinterpret_cast<const uint32_t*>(level);
+		remaining_size -= sizeof(uint32_t);
+		if (remaining_size - static_cast<ssize_t>(image_size) < 0) return;
+		level += sizeof(uint32_t);
+		all_levels_size = level + image_size - first;
+
+		// Each level's data is padded to a multiple of 4 bytes.
+		uint32_t padded_size = (image_size + 3) / 4 * 4;
+		remaining_size -= std::min<ssize_t>(padded_size, remaining_size);
+		level += padded_size;
+	}
 
 	// Default original_width/original_height, which may be overridden by the
 	// key/value data
@@ -118,6 +133,8 @@ KtxFile::KtxFile(const std::string& data)
 				if (i)
 					original_height = i;
 			}
+			else if (key == "es_masks")
+				mask_data = std::move(value);
 
 			p = kvend;
 			p += 3 - ((kv_size + 3) % 4); // padding
@@ -154,6 +171,11 @@ uint32_t KtxFile::Frames() const
 	return header->array_elements ? header->array_elements : 1;
 }
 
+uint32_t KtxFile::Levels() const
+{
+	return header->mipmaps ? header->mipmaps : 1;
+}
+
 uint32_t KtxFile::Size() const
 {
 	const uint8_t* p = reinterpret_cast<const uint8_t*>(header + 1);
@@ -17,12 +17,21 @@ public:
 	uint32_t OriginalWidth() const {return original_width; }
 	uint32_t OriginalHeight() const {return original_height; }
 	uint32_t Frames() const;
+	uint32_t Levels() const;
 	uint32_t Size() const;
+	// Size of all the mipmap levels, starting from Data(). Each level after the
+	// first is preceded by its size, as it is in the file.
+	uint32_t AllLevelsSize() const { return all_levels_size; }
 
 	const void* Data() const;
 
+	// Collision mask outlines that were precomputed along with the texture, if any.
+	const std::string& MaskData() const { return mask_data; }
+
 private:
 	const struct ktx_header* header = nullptr;
 	uint32_t original_width = 0;
 	uint32_t original_height = 0;
+	uint32_t all_levels_size = 0;
+	std::string mask_data;
 };
\ No newline at end of file
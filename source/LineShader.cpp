@@ -128,6 +128,7 @@ void LineShader::Draw(const Point &from, const Point &to, float width, const Col
 	glUniform4fv(colorI, 1, color.Get());
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	OpenGL::CountDrawCall();
 
 	glBindVertexArray(0);
 	glUseProgram(0);
@@ -33,6 +33,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "PlayerInfo.h"
 #include "Preferences.h"
 #include "Rectangle.h"
+#include "SaveWriter.h"
 #include "StarField.h"
 #include "StartConditionsPanel.h"
 #include "text/truncate.hpp"
@@ -525,6 +526,8 @@ bool LoadPanel::Scroll(double dx, double dy)
 
 void LoadPanel::UpdateLists()
 {
+	// Make sure that every save has been completely written before reading them.
+	SaveWriter::Wait();
 	files.clear();
 
 	vector<string> fileList = Files::List(Files::Saves());
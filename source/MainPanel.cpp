@@ -47,6 +47,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "SpriteSet.h"
 #include "StellarObject.h"
 #include "System.h"
+#include "TextureBudget.h"
 #include "UI.h"
 
 #include "opengl.h"
@@ -58,6 +59,20 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 using namespace std;
 
+namespace {
+	const ColorRef DRAG_SELECT_COLOR("drag select");
+	const ColorRef MEDIUM_COLOR("medium");
+
+	const InterfaceRef MAIN_BUTTONS_INTERFACE("main buttons");
+	const InterfaceRef MAP_INTERFACE("map");
+
+	const PreferenceFlag CONTROL_SHIP_WITH_MOUSE("Control ship with mouse");
+	const PreferenceFlag FIGHTERS_TRANSFER_CARGO("Fighters transfer cargo");
+	const PreferenceFlag ONSCREEN_JOYSTICK("Onscreen Joystick");
+	const PreferenceFlag SHOW_BUTTONS_ON_MAP("Show buttons on map");
+	const PreferenceFlag SHOW_CPU_GPU_LOAD("Show CPU / GPU load");
+}
+
 
 
 MainPanel::MainPanel(PlayerInfo &player)
@@ -107,7 +122,7 @@ void MainPanel::Step()
 	if(flagship)
 	{
 		// Check if any help messages should be shown.
-		if(isActive && Preferences::Has("Control ship with mouse"))
+		if(isActive && CONTROL_SHIP_WITH_MOUSE.Has())
 			isActive = !DoHelp("control ship with mouse");
 		if(isActive && flagship->IsTargetable())
 			isActive = !DoHelp("navigation");
@@ -131,7 +146,7 @@ void MainPanel::Step()
 			isActive = !DoHelp("fleet asteroid mining") && !DoHelp("fleet asteroid mining shortcuts");
 		if(isActive && player.DisplayCarrierHelp())
 			isActive = !DoHelp("try out fighters transfer cargo");
-		if(isActive && Preferences::Has("Fighters transfer cargo"))
+		if(isActive && FIGHTERS_TRANSFER_CARGO.Has())
 			isActive = !DoHelp("fighters transfer cargo");
 		if(isActive && !flagship->IsHyperspacing() && flagship->Position().Length() > 10000.
 				&& player.GetDate() <= player.StartData().GetDate() + 4)
@@ -168,6 +183,9 @@ void MainPanel::Step()
 	else
 		canDrag = false;
 	canClick = isActive;
+	// While another panel is on top of this one the game is paused, so the
+	// view of it does not change.
+	SetIsStatic(!isActive);
 }
 
 
@@ -183,7 +201,7 @@ void MainPanel::Draw()
 	{
 		if(canDrag)
 		{
-			const Color &dragColor = *GameData::Colors().Get("drag select");
+			const Color &dragColor = *DRAG_SELECT_COLOR;
 			LineShader::Draw(dragSource, Point(dragSource.X(), dragPoint.Y()), .8f, dragColor);
 			LineShader::Draw(Point(dragSource.X(), dragPoint.Y()), dragPoint, .8f, dragColor);
 			LineShader::Draw(dragPoint, Point(dragPoint.X(), dragSource.Y()), .8f, dragColor);
@@ -193,12 +211,18 @@ void MainPanel::Draw()
 			isDragging = false;
 	}
 
-	if(Preferences::Has("Show CPU / GPU load"))
+	if(SHOW_CPU_GPU_LOAD.Has())
 	{
-		string loadString = to_string(lround(load * 100.)) + "% GPU";
-		const Color &color = *GameData::Colors().Get("medium");
+		string loadString = to_string(lround(load * 100.)) + "% GPU, "
+			+ to_string(OpenGL::DrawCalls()) + " draw calls";
+		const Color &color = *MEDIUM_COLOR;
 		FontSet::Get(14).Draw(loadString, Point(10., Screen::Height() * -.5 + 5.), color);
 
+		const TextureBudget &textures = GameData::GetTextureBudget();
+		string textureString = to_string(textures.ResidentBytes() / (1024 * 1024)) + " MB textures, "
+			+ to_string(textures.EvictionsPerMinute()) + " evictions per minute";
+		FontSet::Get(14).Draw(textureString, Point(10., Screen::Height() * -.5 + 25.), color);
+
 		loadSum += loadTimer.Time();
 		if(++loadCount == 60)
 		{
@@ -209,11 +233,11 @@ void MainPanel::Draw()
 	}
 
 	bool isActive = (GetUI()->Top().get() == this);
-	if (isActive && Preferences::Has("Show buttons on map"))
+	if (isActive && SHOW_BUTTONS_ON_MAP.Has())
 	{
 		Information info;
-		const Interface *mapInterface = GameData::Interfaces().Get("map");
-		const Interface *mapButtonUi = GameData::Interfaces().Get("main buttons");
+		const Interface *mapInterface = MAP_INTERFACE.Get();
+		const Interface *mapButtonUi = MAIN_BUTTONS_INTERFACE.Get();
 		if(player.MapZoom() >= static_cast<int>(mapInterface->GetValue("max zoom")))
 			info.SetCondition("max zoom");
 		if(player.MapZoom() <= static_cast<int>(mapInterface->GetValue("min zoom")))
@@ -308,7 +332,7 @@ void MainPanel::Draw()
 				}
 			}
 		}
-		if(Preferences::Has("Onscreen Joystick"))
+		if(ONSCREEN_JOYSTICK.Has())
 			info.SetCondition("onscreen joystick");
 		mapButtonUi->Draw(info, this);
 	}
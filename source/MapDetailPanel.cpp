@@ -64,6 +64,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef MAP_ORBITS_FLEET_DESTINATION_COLOR("map orbits fleet destination");
+	const ColorRef MAP_SIDE_PANEL_BACKGROUND_COLOR("map side panel background");
+	const ColorRef MEDIUM_COLOR("medium");
+
+	const InterfaceRef MAP_DETAIL_PANEL_INTERFACE("map detail panel");
+	const InterfaceRef MAP_PLANET_CARD_INTERFACE("map planet card");
+
+	const PreferenceFlag SYSTEM_MAP_SENDS_MOVE_ORDERS("System map sends move orders");
+
 	// Convert the angle between two vectors into a sortable angle, i.e an angle
 	// plus a length that is used as a tie-breaker.
 	pair<double, double> SortAngle(const Point &reference, const Point &point)
@@ -177,7 +187,7 @@ double MapDetailPanel::PlanetPanelHeight()
 
 bool MapDetailPanel::Hover(int x, int y)
 {
-	const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+	const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 	isPlanetViewSelected = (x < Screen::Left() + planetCardInterface->GetValue("width")
 		&& y < Screen::Top() + PlanetPanelHeight());
 
@@ -367,9 +377,9 @@ bool MapDetailPanel::KeyDown(SDL_Keycode key, Uint16 mod, const Command &command
 
 bool MapDetailPanel::Click(int x, int y, int clicks)
 {
-	const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+	const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 	const double planetCardWidth = planetCardInterface->GetValue("width");
-	const Interface *mapInterface = GameData::Interfaces().Get("map detail panel");
+	const Interface *mapInterface = MAP_DETAIL_PANEL_INTERFACE.Get();
 	const double arrowOffset = mapInterface->GetValue("arrow x offset");
 	const double planetCardHeight = MapPlanetCard::Height();
 	if(x < Screen::Left() + 160)
@@ -471,7 +481,7 @@ bool MapDetailPanel::Click(int x, int y, int clicks)
 
 bool MapDetailPanel::RClick(int x, int y)
 {
-	if(!Preferences::Has("System map sends move orders"))
+	if(!SYSTEM_MAP_SENDS_MOVE_ORDERS.Has())
 		return true;
 	// TODO: rewrite the map panels to be driven from interfaces.txt so these XY
 	// positions aren't hard-coded.
@@ -528,8 +538,8 @@ void MapDetailPanel::GeneratePlanetCards(const System &system)
 // selected "commodity," which may be reputation level, outfitter size, etc.
 void MapDetailPanel::DrawKey()
 {
-	const Color &dim = *GameData::Colors().Get("dim");
-	const Color &medium = *GameData::Colors().Get("medium");
+	const Color &dim = *DIM_COLOR;
+	const Color &medium = *MEDIUM_COLOR;
 	const Font &font = FontSet::Get(14);
 
 	Point pos = Screen::TopRight() + Point(-110., 310.);
@@ -666,15 +676,15 @@ void MapDetailPanel::DrawKey()
 // details, trade prices, and details about the selected object.
 void MapDetailPanel::DrawInfo()
 {
-	const Color &dim = *GameData::Colors().Get("dim");
-	const Color &medium = *GameData::Colors().Get("medium");
+	const Color &dim = *DIM_COLOR;
+	const Color &medium = *MEDIUM_COLOR;
 
-	const Color &back = *GameData::Colors().Get("map side panel background");
+	const Color &back = *MAP_SIDE_PANEL_BACKGROUND_COLOR;
 
-	const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+	const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 	double planetCardHeight = MapPlanetCard::Height();
 	double planetWidth = planetCardInterface->GetValue("width");
-	const Interface *mapInterface = GameData::Interfaces().Get("map detail panel");
+	const Interface *mapInterface = MAP_DETAIL_PANEL_INTERFACE.Get();
 	double minPlanetPanelHeight = mapInterface->GetValue("min planet panel height");
 	double maxPlanetPanelHeight = mapInterface->GetValue("max planet panel height");
 
@@ -927,7 +937,7 @@ void MapDetailPanel::DrawOrbits()
 		{
 			// Draw an X (to mark the spot, of course).
 			auto uiPoint = (pendingOrder.second * scale) + orbitCenter;
-			const Color *color = GameData::Colors().Get("map orbits fleet destination");
+			const Color *color = MAP_ORBITS_FLEET_DESTINATION_COLOR.Get();
 			// TODO: Add a "batch pointershader" method that takes
 			// the shape description, a count, and a reference point+orientation.
 			// Use that method below and in Engine for drawing target reticles.
@@ -955,7 +965,7 @@ void MapDetailPanel::DrawOrbits()
 	const string &name = selectedPlanet ? selectedPlanet->Name() : selectedSystem->Name();
 	Point namePos(Screen::Right() - 190., Screen::Top() + 7.);
 	font.Draw({name, {180, Alignment::CENTER, Truncate::BACK}},
-		namePos, *GameData::Colors().Get("medium"));
+		namePos, *MEDIUM_COLOR);
 }
 
 
@@ -0,0 +1,367 @@
+/* MapGeometry.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "MapGeometry.h"
+
+#include "Color.h"
+#include "Point.h"
+#include "Screen.h"
+#include "Shader.h"
+
+#include "opengl.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+	const int LINKS = 0;
+	const int SYSTEMS = 1;
+
+	// Each link or system is drawn as a quad made of two triangles. These are
+	// the corners of those triangles.
+	const float LINK_CORNERS[6][2] = {
+		{0.f, -1.f}, {1.f, -1.f}, {0.f, 1.f},
+		{0.f, 1.f}, {1.f, -1.f}, {1.f, 1.f}
+	};
+	const float SYSTEM_CORNERS[6][2] = {
+		{-1.f, -1.f}, {1.f, -1.f}, {-1.f, 1.f},
+		{-1.f, 1.f}, {1.f, -1.f}, {1.f, 1.f}
+	};
+	// The number of floats in each vertex: the two ends of the link, the
+	// corner, and the color; or the position, the corner, and the color.
+	const int STRIDE[2] = {10, 8};
+
+	Shader shader[2];
+	GLint scaleI[2];
+	GLint centerI[2];
+	GLint zoomI[2];
+	GLint widthI[2];
+	GLint offsetI;
+	GLint radiusI;
+
+
+	void Append(vector<float> &data, const Point &point)
+	{
+		data.push_back(point.X());
+		data.push_back(point.Y());
+	}
+
+
+	void Append(vector<float> &data, const float *values, int count)
+	{
+		data.insert(data.end(), values, values + count);
+	}
+
+
+	// Set the uniforms that both shaders have.
+	void SetUniforms(int layer, const Point &center, double zoom)
+	{
+		GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
+		glUniform2fv(scaleI[layer], 1, scale);
+		GLfloat centerV[2] = {static_cast<float>(center.X()), static_cast<float>(center.Y())};
+		glUniform2fv(centerI[layer], 1, centerV);
+		glUniform1f(zoomI[layer], zoom);
+	}
+}
+
+
+
+void MapGeometry::Init()
+{
+	// This is the same as the line shader, except that the ends of the line
+	// are converted from map coordinates to screen coordinates here.
+	static const char *linkVertexCode =
+		"// vertex map link shader\n"
+		"uniform vec2 scale;\n"
+		"uniform vec2 center;\n"
+		"uniform float zoom;\n"
+		"uniform float width;\n"
+		"uniform float offset;\n"
+
+		"in vec2 start;\n"
+		"in vec2 end;\n"
+		"in vec2 vert;\n"
+		"in vec4 color;\n"
+		"out vec2 tpos;\n"
+		"out float tscale;\n"
+		"out vec4 fragColor;\n"
+
+		"void main() {\n"
+		"  vec2 from = zoom * (start + center);\n"
+		"  vec2 to = zoom * (end + center);\n"
+		"  vec2 unit = normalize(from - to) * offset;\n"
+		"  from -= unit;\n"
+		"  to += unit;\n"
+		"  vec2 len = to - from;\n"
+		"  vec2 u = normalize(len) * width;\n"
+		"  tpos = vert;\n"
+		"  tscale = length(len);\n"
+		"  fragColor = color;\n"
+		"  gl_Position = vec4((from + vert.x * len + vert.y * vec2(u.y, -u.x)) * scale, 0, 1);\n"
+		"}\n";
+
+	static const char *linkFragmentCode =
+		"// fragment map link shader\n"
+		"precision mediump float;\n"
+
+		"in vec2 tpos;\n"
+		"in float tscale;\n"
+		"in vec4 fragColor;\n"
+		"out vec4 finalColor;\n"
+
+		"void main() {\n"
+		"  float alpha = min(tscale - abs(tpos.x * (2.f * tscale) - tscale), 1.f - abs(tpos.y));\n"
+		"  finalColor = fragColor * alpha;\n"
+		"}\n";
+
+	// This is the same as the ring shader, but always draws a full ring.
+	static const char *systemVertexCode =
+		"// vertex map system shader\n"
+		"uniform vec2 scale;\n"
+		"uniform vec2 center;\n"
+		"uniform float zoom;\n"
+		"uniform float radius;\n"
+		"uniform float width;\n"
+
+		"in vec2 position;\n"
+		"in vec2 vert;\n"
+		"in vec4 color;\n"
+		"out vec2 coord;\n"
+		"out vec4 fragColor;\n"
+
+		"void main() {\n"
+		"  coord = (radius + width) * vert;\n"
+		"  fragColor = color;\n"
+		"  gl_Position = vec4((zoom * (position + center) + coord) * scale, 0.f, 1.f);\n"
+		"}\n";
+
+	static const char *systemFragmentCode =
+		"// fragment map system shader\n"
+		"precision mediump float;\n"
+		"uniform float radius;\n"
+		"uniform float width;\n"
+
+		"in vec2 coord;\n"
+		"in vec4 fragColor;\n"
+		"out vec4 finalColor;\n"
+
+		"void main() {\n"
+		"  float lenFalloff = width - abs(length(coord) - radius);\n"
+		"  finalColor = fragColor * clamp(lenFalloff, 0.f, 1.f);\n"
+		"}\n";
+
+	shader[LINKS] = Shader(linkVertexCode, linkFragmentCode);
+	shader[SYSTEMS] = Shader(systemVertexCode, systemFragmentCode);
+	for(int layer = 0; layer < 2; ++layer)
+	{
+		scaleI[layer] = shader[layer].Uniform("scale");
+		centerI[layer] = shader[layer].Uniform("center");
+		zoomI[layer] = shader[layer].Uniform("zoom");
+		widthI[layer] = shader[layer].Uniform("width");
+	}
+	offsetI = shader[LINKS].Uniform("offset");
+	radiusI = shader[SYSTEMS].Uniform("radius");
+}
+
+
+
+// A copy has the same systems and links, but its own vertex buffers.
+MapGeometry::MapGeometry(const MapGeometry &other)
+	: data{other.data[LINKS], other.data[SYSTEMS]}
+{
+}
+
+
+
+MapGeometry &MapGeometry::operator=(const MapGeometry &other)
+{
+	if(this != &other)
+	{
+		DeleteBuffers();
+		for(int layer = 0; layer < 2; ++layer)
+		{
+			data[layer] = other.data[layer];
+			isDirty[layer] = true;
+		}
+	}
+	return *this;
+}
+
+
+
+MapGeometry::~MapGeometry()
+{
+	DeleteBuffers();
+}
+
+
+
+// Remove all the systems and links.
+void MapGeometry::Clear()
+{
+	for(int layer = 0; layer < 2; ++layer)
+	{
+		data[layer].clear();
+		isDirty[layer] = true;
+	}
+}
+
+
+
+void MapGeometry::AddSystem(const Point &position, const Color &color)
+{
+	vector<float> &systems = data[SYSTEMS];
+	for(const float *corner : SYSTEM_CORNERS)
+	{
+		Append(systems, position);
+		Append(systems, corner, 2);
+		Append(systems, color.Get(), 4);
+	}
+	isDirty[SYSTEMS] = true;
+}
+
+
+
+void MapGeometry::AddLink(const Point &from, const Point &to, const Color &color)
+{
+	vector<float> &links = data[LINKS];
+	for(const float *corner : LINK_CORNERS)
+	{
+		Append(links, from);
+		Append(links, to);
+		Append(links, corner, 2);
+		Append(links, color.Get(), 4);
+	}
+	isDirty[LINKS] = true;
+}
+
+
+
+// Draw the links or the systems, with the given map position at the center
+// of the screen. Each end of a link is moved the given distance away from
+// the system it is attached to.
+void MapGeometry::DrawLinks(const Point &center, double zoom, float width, float offset)
+{
+	if(!shader[LINKS].Object())
+		throw runtime_error("MapGeometry: DrawLinks() called before Init().");
+	if(data[LINKS].empty())
+		return;
+
+	Upload(LINKS);
+	glUseProgram(shader[LINKS].Object());
+	glBindVertexArray(vao[LINKS]);
+
+	SetUniforms(LINKS, center, zoom);
+	glUniform1f(widthI[LINKS], width);
+	glUniform1f(offsetI, offset);
+
+	glDrawArrays(GL_TRIANGLES, 0, data[LINKS].size() / STRIDE[LINKS]);
+	OpenGL::CountDrawCall();
+
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+
+
+void MapGeometry::DrawSystems(const Point &center, double zoom, float out, float in)
+{
+	if(!shader[SYSTEMS].Object())
+		throw runtime_error("MapGeometry: DrawSystems() called before Init().");
+	if(data[SYSTEMS].empty())
+		return;
+
+	Upload(SYSTEMS);
+	glUseProgram(shader[SYSTEMS].Object());
+	glBindVertexArray(vao[SYSTEMS]);
+
+	SetUniforms(SYSTEMS, center, zoom);
+	// Convert the outer and inner radii the same way RingShader does, so the
+	// rings look the same as when they were drawn one at a time.
+	float width = .5f * (1.f + out - in);
+	glUniform1f(radiusI, out - width);
+	glUniform1f(widthI[SYSTEMS], width);
+
+	glDrawArrays(GL_TRIANGLES, 0, data[SYSTEMS].size() / STRIDE[SYSTEMS]);
+	OpenGL::CountDrawCall();
+
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+
+
+// Copy the vertex data into the given buffer, creating it if necessary.
+void MapGeometry::Upload(int layer)
+{
+	if(!isDirty[layer])
+		return;
+	isDirty[layer] = false;
+
+	if(!vao[layer])
+	{
+		glGenVertexArrays(1, &vao[layer]);
+		glBindVertexArray(vao[layer]);
+		glGenBuffers(1, &vbo[layer]);
+		glBindBuffer(GL_ARRAY_BUFFER, vbo[layer]);
+
+		// Each vertex begins with one or two points, and ends with the corner
+		// of the quad and the color.
+		const Shader &program = shader[layer];
+		const GLsizei stride = STRIDE[layer] * sizeof(GLfloat);
+		const char *const POINTS[2][2] = {{"start", "end"}, {"position", nullptr}};
+		int offset = 0;
+		for(const char *name : POINTS[layer])
+			if(name)
+			{
+				glEnableVertexAttribArray(program.Attrib(name));
+				glVertexAttribPointer(program.Attrib(name), 2, GL_FLOAT, GL_FALSE, stride,
+					reinterpret_cast<const GLvoid *>(offset * sizeof(GLfloat)));
+				offset += 2;
+			}
+		glEnableVertexAttribArray(program.Attrib("vert"));
+		glVertexAttribPointer(program.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, stride,
+			reinterpret_cast<const GLvoid *>(offset * sizeof(GLfloat)));
+		offset += 2;
+		glEnableVertexAttribArray(program.Attrib("color"));
+		glVertexAttribPointer(program.Attrib("color"), 4, GL_FLOAT, GL_FALSE, stride,
+			reinterpret_cast<const GLvoid *>(offset * sizeof(GLfloat)));
+	}
+	else
+	{
+		glBindVertexArray(vao[layer]);
+		glBindBuffer(GL_ARRAY_BUFFER, vbo[layer]);
+	}
+
+	glBufferData(GL_ARRAY_BUFFER, data[layer].size() * sizeof(GLfloat), data[layer].data(), GL_STATIC_DRAW);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+
+
+void MapGeometry::DeleteBuffers()
+{
+	for(int layer = 0; layer < 2; ++layer)
+		if(vao[layer])
+		{
+			glDeleteBuffers(1, &vbo[layer]);
+			glDeleteVertexArrays(1, &vao[layer]);
+			vao[layer] = 0;
+			vbo[layer] = 0;
+		}
+}
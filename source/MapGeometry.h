@@ -0,0 +1,73 @@
+/* MapGeometry.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAP_GEOMETRY_H_
+#define MAP_GEOMETRY_H_
+
+#include <cstdint>
+#include <vector>
+
+class Color;
+class Point;
+
+
+
+// Class holding the rings of the systems and the hyperspace links between them
+// that the map draws. They are stored in map coordinates, so the vertex buffers
+// only need to be rebuilt when the systems or their colors change, not when the
+// map is scrolled or zoomed; then each layer is drawn with a single draw call.
+// The ring sizes and line widths are given in pixels, as for the RingShader and
+// the LineShader, and do not change with the zoom.
+class MapGeometry {
+public:
+	static void Init();
+
+	MapGeometry() = default;
+	// A copy has the same systems and links, but its own vertex buffers.
+	MapGeometry(const MapGeometry &other);
+	MapGeometry &operator=(const MapGeometry &other);
+	~MapGeometry();
+
+	// Remove all the systems and links.
+	void Clear();
+	void AddSystem(const Point &position, const Color &color);
+	void AddLink(const Point &from, const Point &to, const Color &color);
+
+	// Draw the links or the systems, with the given map position at the center
+	// of the screen. Each end of a link is moved the given distance away from
+	// the system it is attached to.
+	void DrawLinks(const Point &center, double zoom, float width, float offset);
+	void DrawSystems(const Point &center, double zoom, float out, float in);
+
+
+private:
+	// Copy the vertex data into the given buffer, creating it if necessary.
+	void Upload(int layer);
+	void DeleteBuffers();
+
+
+private:
+	// The vertex data of the links and of the systems.
+	std::vector<float> data[2];
+	// Whether the vertex buffers need to be updated.
+	bool isDirty[2] = {true, true};
+
+	uint32_t vao[2] = {0, 0};
+	uint32_t vbo[2] = {0, 0};
+};
+
+
+
+#endif
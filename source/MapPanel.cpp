@@ -65,6 +65,20 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef MAP_JUMP_RANGE_COLOR("map jump range color");
+	const ColorRef MAP_LINK_COLOR("map link");
+	const ColorRef MAP_NAME_COLOR("map name");
+	const ColorRef MAP_VIEW_RANGE_COLOR("map view range color");
+	const ColorRef MEDIUM_COLOR("medium");
+	const ColorRef TOOLTIP_BACKGROUND_COLOR("tooltip background");
+
+	const InterfaceRef HUD_INTERFACE("hud");
+	const InterfaceRef MAP_INTERFACE("map");
+
+	const PreferenceFlag DEADLINE_BLINK_BY_DISTANCE("Deadline blink by distance");
+	const PreferenceFlag HIDE_UNEXPLORED_MAP_REGIONS("Hide unexplored map regions");
+
 	const std::string SHOW_ESCORT_SYSTEMS = "Show escort systems on map";
 	const std::string SHOW_STORED_OUTFITS = "Show stored outfits on map";
 	const unsigned MAX_MISSION_POINTERS_DRAWN = 12;
@@ -165,7 +179,7 @@ namespace {
 			daysLeft = mission.Deadline() - player.GetDate() + 1;
 			if(daysLeft > 0)
 			{
-				if(Preferences::Has("Deadline blink by distance"))
+				if(DEADLINE_BLINK_BY_DISTANCE.Has())
 				{
 					DistanceMap distance(player, player.GetSystem());
 					if(distance.HasRoute(mission.Destination()->GetSystem()))
@@ -290,16 +304,16 @@ void MapPanel::Draw()
 	for(const auto &it : GameData::Galaxies())
 		SpriteShader::Draw(it.second.GetSprite(), Zoom() * (center + it.second.Position()), Zoom());
 
-	if(Preferences::Has("Hide unexplored map regions"))
+	if(HIDE_UNEXPLORED_MAP_REGIONS.Has())
 		FogShader::Draw(center, Zoom(), player);
 
 	// Draw the "visible range" circle around your current location.
-	const Color &viewRangeColor = *GameData::Colors().Get("map view range color");
+	const Color &viewRangeColor = *MAP_VIEW_RANGE_COLOR;
 	RingShader::Draw(Zoom() * (playerSystem.Position() + center),
 		System::DEFAULT_NEIGHBOR_DISTANCE * Zoom(), 2.0f, 1.0f, viewRangeColor);
 	// Draw the jump range circle around your current location if it is different than the
 	// visible range.
-	const Color &jumpRangeColor = *GameData::Colors().Get("map jump range color");
+	const Color &jumpRangeColor = *MAP_JUMP_RANGE_COLOR;
 	if(playerJumpDistance != System::DEFAULT_NEIGHBOR_DISTANCE)
 		RingShader::Draw(Zoom() * (playerSystem.Position() + center),
 			(playerJumpDistance + .5) * Zoom(), (playerJumpDistance - .5) * Zoom(), jumpRangeColor);
@@ -333,7 +347,7 @@ void MapPanel::FinishDrawing(const string &buttonCondition)
 
 	Information info;
 	info.SetCondition(buttonCondition);
-	const Interface *mapInterface = GameData::Interfaces().Get("map");
+	const Interface *mapInterface = MAP_INTERFACE.Get();
 	if(player.MapZoom() >= static_cast<int>(mapInterface->GetValue("max zoom")))
 		info.SetCondition("max zoom");
 	if(player.MapZoom() <= static_cast<int>(mapInterface->GetValue("min zoom")))
@@ -398,8 +412,8 @@ void MapPanel::FinishDrawing(const string &buttonCondition)
 			if(topLeft.Y() + size.Y() > Screen::Bottom())
 				topLeft.Y() -= size.Y();
 			// Draw the background fill and the tooltip text.
-			FillShader::Fill(topLeft + .5 * size, size, *GameData::Colors().Get("tooltip background"));
-			hoverText.Draw(topLeft + Point(10., 10.), *GameData::Colors().Get("medium"));
+			FillShader::Fill(topLeft + .5 * size, size, *TOOLTIP_BACKGROUND_COLOR);
+			hoverText.Draw(topLeft + Point(10., 10.), *MEDIUM_COLOR);
 		}
 	}
 
@@ -425,7 +439,7 @@ void MapPanel::DrawMiniMap(const PlayerInfo &player, float alpha, const System *
 	const Font &font = FontSet::Get(14);
 	Color lineColor(alpha, 0.f);
 	Point center = .5 * (jump[0]->Position() + jump[1]->Position());
-	const Point &drawPos = GameData::Interfaces().Get("hud")->GetPoint("mini-map");
+	const Point &drawPos = HUD_INTERFACE.Get()->GetPoint("mini-map");
 	set<const System *> drawnSystems = { jump[0], jump[1] };
 	bool isLink = jump[0]->Links().count(jump[1]);
 
@@ -538,7 +552,7 @@ bool MapPanel::AllowsFastForward() const noexcept
 
 bool MapPanel::KeyDown(SDL_Keycode key, Uint16 mod, const Command &command, bool isNewPress)
 {
-	const Interface *mapInterface = GameData::Interfaces().Get("map");
+	const Interface *mapInterface = MAP_INTERFACE.Get();
 	if(command.Has(Command::MAP) || key == 'd' || key == SDLK_ESCAPE || key == SDLK_AC_BACK
 			|| (key == 'w' && (mod & (KMOD_CTRL | KMOD_GUI))))
 		GetUI()->Pop(this);
@@ -665,7 +679,7 @@ bool MapPanel::Scroll(double dx, double dy)
 	// The mouse should be pointing to the same map position before and after zooming.
 	Point mouse = UI::GetMouse();
 	Point anchor = mouse / Zoom() - center;
-	const Interface *mapInterface = GameData::Interfaces().Get("map");
+	const Interface *mapInterface = MAP_INTERFACE.Get();
 	if(dy > 0.)
 		player.SetMapZoom(min(static_cast<int>(mapInterface->GetValue("max zoom")), player.MapZoom() + 1));
 	else if(dy < 0.)
@@ -692,7 +706,7 @@ bool MapPanel::FingerMove(int x, int y, int fid)
 {
 	if(zoomGesture.FingerMove(Point(x, y), fid))
 	{
-		const Interface *mapInterface = GameData::Interfaces().Get("map");
+		const Interface *mapInterface = MAP_INTERFACE.Get();
 
 		// We want to support arbitrary zoom levels, but the upstream zoom config
 		// is an integer power of 1.5, so we have to convert it when we store it
@@ -1075,10 +1089,11 @@ void MapPanel::UpdateCache()
 	// Remember which commodity the cached systems are colored by.
 	cachedCommodity = commodity;
 	nodes.clear();
+	geometry.Clear();
 
 	// Draw the circles for the systems, colored based on the selected criterion,
 	// which may be government, services, or commodity prices.
-	const Color &closeNameColor = *GameData::Colors().Get("map name");
+	const Color &closeNameColor = *MAP_NAME_COLOR;
 	const Color &farNameColor = closeNameColor.Transparent(.5);
 	for(const auto &it : GameData::Systems())
 	{
@@ -1188,13 +1203,12 @@ void MapPanel::UpdateCache()
 			player.KnowsName(system) ? system.Name() : "",
 			(&system == &playerSystem) ? closeNameColor : farNameColor,
 			player.HasVisited(system) ? system.GetGovernment() : nullptr);
+		geometry.AddSystem(system.Position(), color);
 	}
 
 	// Now, update the cache of the links.
-	links.clear();
-
 	// The link color depends on whether it's connected to the current system or not.
-	const Color &closeColor = *GameData::Colors().Get("map link");
+	const Color &closeColor = *MAP_LINK_COLOR;
 	const Color &farColor = closeColor.Transparent(.5);
 	for(const auto &it : GameData::Systems())
 	{
@@ -1212,7 +1226,7 @@ void MapPanel::UpdateCache()
 					continue;
 
 				bool isClose = (system == &playerSystem || link == &playerSystem);
-				links.emplace_back(system->Position(), link->Position(), isClose ? closeColor : farColor);
+				geometry.AddLink(system->Position(), link->Position(), isClose ? closeColor : farColor);
 			}
 	}
 }
@@ -1313,8 +1327,8 @@ void MapPanel::DrawEscorts()
 
 	// Fill in the center of any system containing the player's ships, if the
 	// player knows about that system (since escorts may use unknown routes).
-	const Color &active = *GameData::Colors().Get("map link");
-	const Color &parked = *GameData::Colors().Get("dim");
+	const Color &active = *MAP_LINK_COLOR;
+	const Color &parked = *DIM_COLOR;
 	double zoom = Zoom();
 	for(const auto &squad : escortSystems)
 		if(player.HasSeen(*squad.first) || squad.first == specialSystem)
@@ -1406,17 +1420,9 @@ void MapPanel::DrawWormholes()
 
 void MapPanel::DrawLinks()
 {
-	double zoom = Zoom();
-	for(const Link &link : links)
-	{
-		Point from = zoom * (link.start + center);
-		Point to = zoom * (link.end + center);
-		Point unit = (from - to).Unit() * LINK_OFFSET;
-		from -= unit;
-		to += unit;
-
-		LineShader::Draw(from, to, LINK_WIDTH, link.color);
-	}
+	// The links are drawn from the cache in one batch, so they only need to be
+	// re-uploaded when the cache changes, not each time the map moves.
+	geometry.DrawLinks(center, Zoom(), LINK_WIDTH, LINK_OFFSET);
 }
 
 
@@ -1426,32 +1432,30 @@ void MapPanel::DrawSystems()
 	if(commodity != cachedCommodity)
 		UpdateCache();
 
+	// Draw the circles for the systems.
+	double zoom = Zoom();
+	geometry.DrawSystems(center, zoom, OUTER, INNER);
+
 	// If coloring by government, we need to keep track of which ones are the
 	// closest to the center of the window because those will be the ones that
 	// are shown in the map key.
-	if(commodity == SHOW_GOVERNMENT)
-		closeGovernments.clear();
+	if(commodity != SHOW_GOVERNMENT)
+		return;
 
-	// Draw the circles for the systems.
-	double zoom = Zoom();
+	closeGovernments.clear();
 	for(const Node &node : nodes)
-	{
-		Point pos = zoom * (node.position + center);
-		RingShader::Draw(pos, OUTER, INNER, node.color);
-
-		if(commodity == SHOW_GOVERNMENT && node.government && node.government->GetName() != "Uninhabited")
+		if(node.government && node.government->GetName() != "Uninhabited")
 		{
 			// For every government that is drawn, keep track of how close it
 			// is to the center of the view. The four closest governments
 			// will be displayed in the key.
-			double distance = pos.Length();
+			double distance = (zoom * (node.position + center)).Length();
 			auto it = closeGovernments.find(node.government);
 			if(it == closeGovernments.end())
 				closeGovernments[node.government] = distance;
 			else
 				it->second = min(it->second, distance);
 		}
-	}
 }
 
 
@@ -1467,8 +1471,23 @@ void MapPanel::DrawNames()
 	bool useBigFont = (zoom > 2.);
 	const Font &font = FontSet::Get(useBigFont ? 18 : 14);
 	Point offset(useBigFont ? 8. : 6., -.5 * font.Height());
+	// When zoomed in, most of the systems are off screen. Skip them without
+	// laying out their names: a name is only drawn to the right of its system.
+	double left = Screen::Left() - offset.X();
+	double top = Screen::Top() - font.Height() - offset.Y();
+	double bottom = Screen::Bottom() - offset.Y();
+	double right = Screen::Right() - offset.X();
+	font.BeginBatch();
 	for(const Node &node : nodes)
-		font.Draw(node.name, zoom * (node.position + center) + offset, node.nameColor);
+	{
+		Point pos = zoom * (node.position + center);
+		if(node.name.empty() || pos.X() > right || pos.Y() < top || pos.Y() > bottom)
+			continue;
+		if(pos.X() < left && pos.X() + font.Width(node.name) < left)
+			continue;
+		font.Draw(node.name, pos + offset, node.nameColor);
+	}
+	font.EndBatch();
 }
 
 
@@ -20,6 +20,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Color.h"
 #include "DistanceMap.h"
+#include "MapGeometry.h"
 #include "Point.h"
 #include "ZoomGesture.h"
 #include "text/WrappedText.h"
@@ -203,17 +204,9 @@ private:
 		const Government *government;
 	};
 	std::vector<Node> nodes;
-
-	class Link {
-	public:
-		Link(const Point &start, const Point &end, const Color &color)
-			: start(start), end(end), color(color) {}
-
-		Point start;
-		Point end;
-		Color color;
-	};
-	std::vector<Link> links;
+	// The rings of the nodes and the links, kept in vertex buffers so that
+	// they only need to be rebuilt when the cache is updated.
+	MapGeometry geometry;
 
 	double mapZoom = 1.0;
 	Animate<double> mapZoomAnimate;
@@ -35,6 +35,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef FAINT_COLOR("faint");
+	const ColorRef ITEM_SELECTED_COLOR("item selected");
+	const ColorRef MEDIUM_COLOR("medium");
+
+	const InterfaceRef MAP_DETAIL_PANEL_INTERFACE("map detail panel");
+	const InterfaceRef MAP_PLANET_CARD_INTERFACE("map planet card");
+
 	bool hasGovernments = false;
 }
 
@@ -75,7 +83,7 @@ MapPlanetCard::MapPlanetCard(const StellarObject &object, unsigned number, bool
 
 	sprite = object.GetSprite();
 
-	const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+	const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 	const float planetIconMaxSize = static_cast<float>(planetCardInterface->GetValue("planet icon max size"));
 	spriteScale = min(.5f, min(planetIconMaxSize / sprite->Width(), planetIconMaxSize / sprite->Height()));
 }
@@ -88,7 +96,7 @@ MapPlanetCard::ClickAction MapPlanetCard::Click(int x, int y, int clicks)
 	// The isShown variable should have already updated by the drawing of this item.
 	if(isShown)
 	{
-		const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+		const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 		// Point at which the text starts (after the top margin), at first there is the planet's name,
 		// and then it is divided into clickable categories of the same size.
 		const double textStart = planetCardInterface->GetValue("text start");
@@ -139,11 +147,11 @@ bool MapPlanetCard::DrawIfFits(const Point &uiPoint)
 	if(isShown)
 	{
 		const Font &font = FontSet::Get(14);
-		const Color &faint = *GameData::Colors().Get("faint");
-		const Color &dim = *GameData::Colors().Get("dim");
-		const Color &medium = *GameData::Colors().Get("medium");
+		const Color &faint = *FAINT_COLOR;
+		const Color &dim = *DIM_COLOR;
+		const Color &medium = *MEDIUM_COLOR;
 
-		const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+		const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 		// The maximum possible size for the sprite of the planet.
 		const double planetIconMaxSize = planetCardInterface->GetValue("planet icon max size");
 		const auto alignLeft = Layout(planetCardInterface->GetValue("width") - planetIconMaxSize, Truncate::BACK);
@@ -161,7 +169,7 @@ bool MapPlanetCard::DrawIfFits(const Point &uiPoint)
 		const double availableBottomSpace = AvailableBottomSpace();
 
 		// The top part goes out of the screen so we can draw there. The bottom would go out of this panel.
-		const Interface *mapInterface = GameData::Interfaces().Get("map detail panel");
+		const Interface *mapInterface = MAP_DETAIL_PANEL_INTERFACE.Get();
 
 		auto spriteItem = SpriteShader::Prepare(sprite, Point(Screen::Left() + planetIconMaxSize / 2.,
 			uiPoint.Y() + height / 2.), spriteScale);
@@ -266,7 +274,7 @@ void MapPlanetCard::Select(bool select)
 
 double MapPlanetCard::Height()
 {
-	const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+	const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 	return planetCardInterface->GetValue("height padding") +
 		(planetCardInterface->GetValue("categories") + hasGovernments) *
 		planetCardInterface->GetValue("category size");
@@ -283,11 +291,11 @@ void MapPlanetCard::ResetSize()
 
 void MapPlanetCard::Highlight(double availableSpace) const
 {
-	const Interface *planetCardInterface = GameData::Interfaces().Get("map planet card");
+	const Interface *planetCardInterface = MAP_PLANET_CARD_INTERFACE.Get();
 	const double width = planetCardInterface->GetValue("width");
 
 	FillShader::Fill(Point(Screen::Left() + width / 2., yCoordinate + availableSpace / 2.),
-		Point(width, availableSpace), *GameData::Colors().Get("item selected"));
+		Point(width, availableSpace), *ITEM_SELECTED_COLOR);
 }
 
 
@@ -302,7 +310,7 @@ double MapPlanetCard::AvailableTopSpace() const
 
 double MapPlanetCard::AvailableBottomSpace() const
 {
-	const Interface *mapInterface = GameData::Interfaces().Get("map detail panel");
+	const Interface *mapInterface = MAP_DETAIL_PANEL_INTERFACE.Get();
 	double maxPlanetPanelHeight = mapInterface->GetValue("max planet panel height");
 
 	return min(Height(), max(0., Screen::Top() +
@@ -43,6 +43,13 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 using namespace std;
 
+namespace {
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef ITEM_SELECTED_COLOR("item selected");
+	const ColorRef MAP_SIDE_PANEL_BACKGROUND_COLOR("map side panel background");
+	const ColorRef MEDIUM_COLOR("medium");
+}
+
 const double MapSalesPanel::ICON_HEIGHT = 90.;
 const double MapSalesPanel::PAD = 8.;
 const int MapSalesPanel::WIDTH = 270;
@@ -258,7 +265,7 @@ void MapSalesPanel::DrawKey() const
 
 void MapSalesPanel::DrawPanel() const
 {
-	const Color &back = *GameData::Colors().Get("map side panel background");
+	const Color &back = *MAP_SIDE_PANEL_BACKGROUND_COLOR;
 	FillShader::Fill(
 		Point(Screen::Width() * -.5 + WIDTH * .5, 0.),
 		Point(WIDTH, Screen::Height()),
@@ -298,7 +305,7 @@ void MapSalesPanel::DrawInfo() const
 			width += box->Width() + compareInfo.PanelWidth();
 		}
 
-		const Color &back = *GameData::Colors().Get("map side panel background");
+		const Color &back = *MAP_SIDE_PANEL_BACKGROUND_COLOR;
 		Point size(width, height);
 		Point topLeft(Screen::Right() - size.X(), Screen::Top());
 		FillShader::Fill(topLeft + .5 * size, size, back);
@@ -376,7 +383,7 @@ void MapSalesPanel::Draw(Point &corner, const Sprite *sprite, int swizzle, bool
 		const std::string &storage)
 {
 	const Font &font = FontSet::Get(14);
-	const Color &selectionColor = *GameData::Colors().Get("item selected");
+	const Color &selectionColor = *ITEM_SELECTED_COLOR;
 
 	// Set the padding so the text takes the same height overall,
 	// regardless of whether it's three lines of text or four.
@@ -395,8 +402,8 @@ void MapSalesPanel::Draw(Point &corner, const Sprite *sprite, int swizzle, bool
 
 		DrawSprite(corner, sprite, swizzle);
 
-		const Color &mediumColor = *GameData::Colors().Get("medium");
-		const Color &dimColor = *GameData::Colors().Get("dim");
+		const Color &mediumColor = *MEDIUM_COLOR;
+		const Color &dimColor = *DIM_COLOR;
 		const Color textColor = isForSale ? mediumColor : storage.empty()
 			? dimColor : Color::Combine(.5f, mediumColor, .5f, dimColor);
 		auto layout = Layout(static_cast<int>(WIDTH - ICON_HEIGHT - 1), Truncate::BACK);
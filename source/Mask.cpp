@@ -38,6 +38,11 @@ namespace {
 		};
 		raw.clear();
 
+		// Decode the whole frame's alpha channel up front, rather than one
+		// pixel at a time, since compressed textures are stored in blocks.
+		vector<uint8_t> alpha;
+		image.GetAlphaPlane(frame, alpha);
+
 		auto hasOutline = vector<bool>(numPixels, false);
 		vector<int> directions;
 		vector<Point> points;
@@ -50,7 +55,7 @@ namespace {
 			// Find a pixel with some renderable color data (i.e. a non-zero alpha component).
 			for( ; start < numPixels; ++start)
 			{
-				if(image.GetAlpha(0, start % width, start / width))
+				if(alpha[start])
 				{
 					// If this pixel is not part of an existing outline, trace it.
 					if(!hasOutline[start])
@@ -58,7 +63,7 @@ namespace {
 					// Otherwise, advance to the next transparent pixel.
 					// (any non-transparent pixels will belong to the existing outline).
 					for(++start; start < numPixels; ++start)
-						if(!(image.GetAlpha(0, start % width, start / width)))
+						if(!(alpha[start]))
 							break;
 				}
 			}
@@ -101,7 +106,7 @@ namespace {
 					// First, ensure an offset in this direction would access a valid pixel index.
 					if(next[0] >= 0 && next[0] < width && next[1] >= 0 && next[1] < height)
 						// If that pixel has color data, then add it to the outline.
-						if(image.GetAlpha(0, next[0], next[1]))
+						if(alpha[next[0] + next[1] * width])
 							break;
 
 					// Otherwise, advance to the next direction.
@@ -154,7 +159,7 @@ namespace {
 				Point shift = Point(
 					step[out0][0] * scale[out0 & 1] + step[out1][0] * scale[out1 & 1],
 					step[out0][1] * scale[out0 & 1] + step[out1][1] * scale[out1 & 1]).Unit();
-				shift *= image.GetAlpha(0, p[0], p[1]) * (1. / 255.) - .5;
+				shift *= alpha[pos] * (1. / 255.) - .5;
 				points.push_back(shift + Point(p[0], p[1]));
 
 				p[0] += step[next][0];
@@ -280,6 +285,16 @@ namespace {
 
 
 
+// Construct a mask from outlines that were generated previously.
+Mask::Mask(vector<vector<Point>> outlines)
+	: outlines(std::move(outlines))
+{
+	for(const vector<Point> &outline : this->outlines)
+		radius = max(radius, ComputeRadius(outline));
+}
+
+
+
 // Construct a mask from the alpha channel of an RGBA-formatted image.
 void Mask::Create(const ImageBuffer &image, int frame)
 {
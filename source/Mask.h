@@ -32,6 +32,10 @@ class ImageBuffer;
 // the image itself.
 class Mask {
 public:
+	Mask() = default;
+	// Construct a mask from outlines that were generated previously.
+	explicit Mask(std::vector<std::vector<Point>> outlines);
+
 	// Construct a mask from the alpha channel of an RGBA-formatted image.
 	void Create(const ImageBuffer &image, int frame = 0);
 
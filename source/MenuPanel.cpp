@@ -62,7 +62,7 @@ namespace {
 MenuPanel::MenuPanel(PlayerInfo &player, UI &gamePanels)
 	: player(player), gamePanels(gamePanels), mainMenuUi(GameData::Interfaces().Get("main menu"))
 {
-	assert(GameData::IsLoaded() && "MenuPanel should only be created after all data is fully loaded");
+	assert(GameData::IsCriticalLoaded() && "MenuPanel should only be created after the menu data is loaded");
 	SetIsFullScreen(true);
 
 	if(mainMenuUi->GetBox("credits").Dimensions())
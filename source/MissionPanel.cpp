@@ -54,6 +54,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef FAINT_COLOR("faint");
+	const ColorRef MAP_SIDE_PANEL_BACKGROUND_COLOR("map side panel background");
+	const ColorRef MEDIUM_COLOR("medium");
+	const ColorRef TOOLTIP_BACKGROUND_COLOR("tooltip background");
+	const ColorRef WAYPOINT_BACK_COLOR("waypoint back");
+
+	const InterfaceRef MISSION_INTERFACE("mission");
+
 	constexpr int SIDE_WIDTH = 280;
 
 	// Hovering over sort buttons for this many frames activates the tooltip.
@@ -752,7 +762,7 @@ bool MissionPanel::ControllerButtonDown(SDL_GameControllerButton button)
 		{
 			// Switch to the buttons, defaulting to the Accept button.
 			controllerFocus = FOCUS_BUTTONS;
-			auto ui = GameData::Interfaces().Get("mission");
+			auto ui = MISSION_INTERFACE.Get();
 			GamepadCursor::SetPosition(ui->GetBox("_Accept Mission").Center());
 			// we want to come back here after the mission is accepted/canceled
 			returnGamepadCursorToAvailableMissions = true;
@@ -860,7 +870,7 @@ void MissionPanel::DrawSelectedSystem() const
 	const Font &font = FontSet::Get(14);
 	Point pos(-175., Screen::Top() + .5 * (30. - font.Height()));
 	font.Draw({text, {350, Alignment::CENTER, Truncate::MIDDLE}},
-		pos, *GameData::Colors().Get("bright"));
+		pos, *BRIGHT_COLOR);
 }
 
 
@@ -876,8 +886,8 @@ void MissionPanel::DrawMissionSystem(const Mission &mission, const Color &color)
 	for(const Planet *planet : mission.VisitedStopovers())
 		hasVisited.insert(planet->GetSystem());
 
-	const Color &waypoint = *GameData::Colors().Get("waypoint back");
-	const Color &visited = *GameData::Colors().Get("faint");
+	const Color &waypoint = *WAYPOINT_BACK_COLOR;
+	const Color &visited = *FAINT_COLOR;
 
 	double zoom = Zoom();
 	auto drawRing = [&](const System *system, const Color &drawColor)
@@ -902,11 +912,11 @@ void MissionPanel::DrawMissionSystem(const Mission &mission, const Color &color)
 // Draw the background for the lists of available and accepted missions (based on pos).
 Point MissionPanel::DrawPanel(Point pos, const string &label, int entries, bool sorter) const
 {
-	const Color &back = *GameData::Colors().Get("map side panel background");
-	const Color &text = *GameData::Colors().Get("medium");
+	const Color &back = *MAP_SIDE_PANEL_BACKGROUND_COLOR;
+	const Color &text = *MEDIUM_COLOR;
 	const Color separatorLine = text.Opaque();
-	const Color &title = *GameData::Colors().Get("bright");
-	const Color &highlight = *GameData::Colors().Get("dim");
+	const Color &title = *BRIGHT_COLOR;
+	const Color &highlight = *DIM_COLOR;
 
 	// Draw the panel.
 	Point size(SIDE_WIDTH, 20 * entries + 40);
@@ -978,10 +988,10 @@ Point MissionPanel::DrawList(const list<Mission> &list, Point pos, const std::li
 	bool separateDeadlineOrPossible) const
 {
 	const Font &font = FontSet::Get(14);
-	const Color &highlight = *GameData::Colors().Get("faint");
-	const Color &unselected = *GameData::Colors().Get("medium");
-	const Color &selected = *GameData::Colors().Get("bright");
-	const Color &dim = *GameData::Colors().Get("dim");
+	const Color &highlight = *FAINT_COLOR;
+	const Color &unselected = *MEDIUM_COLOR;
+	const Color &selected = *BRIGHT_COLOR;
+	const Color &dim = *DIM_COLOR;
 	const Sprite *fast = SpriteSet::Get("ui/fast forward");
 	bool separated = false;
 
@@ -1042,7 +1052,7 @@ void MissionPanel::DrawMissionInfo()
 
 	info.SetString("today", player.GetDate().ToString());
 
-	GameData::Interfaces().Get("mission")->Draw(info, this);
+	MISSION_INTERFACE.Get()->Draw(info, this);
 
 	// If a mission is selected, draw its descriptive text.
 	if(availableIt != available.end())
@@ -1051,7 +1061,7 @@ void MissionPanel::DrawMissionInfo()
 		wrap.Wrap(acceptedIt->Description());
 	else
 		return;
-	wrap.Draw(Point(-190., Screen::Bottom() - 213.), *GameData::Colors().Get("bright"));
+	wrap.Draw(Point(-190., Screen::Bottom() - 213.), *BRIGHT_COLOR);
 }
 
 
@@ -1099,8 +1109,8 @@ void MissionPanel::DrawTooltips()
 		size += Point(20., 20.);
 		Point topLeft = Point(Screen::Left() + SIDE_WIDTH - 120. + 30 * hoverSort, Screen::Top() + 30.);
 		// Draw the background fill and the tooltip text.
-		FillShader::Fill(topLeft + .5 * size, size, *GameData::Colors().Get("tooltip background"));
-		hoverText.Draw(topLeft + Point(10., 10.), *GameData::Colors().Get("medium"));
+		FillShader::Fill(topLeft + .5 * size, size, *TOOLTIP_BACKGROUND_COLOR);
+		hoverText.Draw(topLeft + Point(10., 10.), *MEDIUM_COLOR);
 	}
 }
 
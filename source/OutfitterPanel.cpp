@@ -46,6 +46,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef MEDIUM_COLOR("medium");
+
 	// Label for the decription field of the detail pane.
 	const string DESCRIPTION = "description";
 
@@ -163,7 +166,7 @@ void OutfitterPanel::DrawItem(const string &name, const Point &point)
 	int mapSize = outfit->Get("map");
 
 	const Font &font = FontSet::Get(14);
-	const Color &bright = *GameData::Colors().Get("bright");
+	const Color &bright = *BRIGHT_COLOR;
 	if(playerShip || isLicense || mapSize)
 	{
 		int minCount = numeric_limits<int>::max();
@@ -280,7 +283,7 @@ int OutfitterPanel::DrawDetails(const Point &center)
 			}
 			else
 			{
-				const Color &dim = *GameData::Colors().Get("medium");
+				const Color &dim = *MEDIUM_COLOR;
 				font.Draw(DESCRIPTION, startPoint + Point(35., 12.), dim);
 				const Sprite *collapsedArrow = SpriteSet::Get("ui/collapsed");
 				SpriteShader::Draw(collapsedArrow, startPoint + Point(20., 20.));
@@ -303,7 +306,7 @@ int OutfitterPanel::DrawDetails(const Point &center)
 	}
 
 	// Draw this string representing the selected item (if any), centered in the details side panel
-	const Color &bright = *GameData::Colors().Get("bright");
+	const Color &bright = *BRIGHT_COLOR;
 	Point selectedPoint(center.X() - INFOBAR_WIDTH / 2, center.Y());
 	font.Draw({selectedItem, {INFOBAR_WIDTH, Alignment::CENTER, Truncate::MIDDLE}},
 		selectedPoint, bright);
@@ -736,7 +739,7 @@ void OutfitterPanel::DrawKey()
 	SpriteShader::Draw(back, Screen::BottomLeft() + .5 * Point(back->Width(), -back->Height()));
 
 	const Font &font = FontSet::Get(14);
-	Color color[2] = {*GameData::Colors().Get("medium"), *GameData::Colors().Get("bright")};
+	Color color[2] = {*MEDIUM_COLOR, *BRIGHT_COLOR};
 	const Sprite *box[2] = {SpriteSet::Get("ui/unchecked"), SpriteSet::Get("ui/checked")};
 
 	Point pos = Screen::BottomLeft() + Point(10., -VisibilityCheckboxesSize() - 20.);
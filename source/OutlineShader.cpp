@@ -32,6 +32,7 @@ namespace {
 	GLint frameI;
 	GLint frameCountI;
 	GLint colorI;
+	GLint uvRectI;
 
 	GLuint vao;
 	GLuint vbo;
@@ -78,12 +79,19 @@ void OutlineShader::Init()
 		"uniform float frameCount;\n"
 		"uniform vec4 color;\n"
 		"uniform vec2 off;\n"
+		"uniform highp vec4 uvRect;\n"
 		"const vec4 weight = vec4(.4, .4, .4, 1.);\n"
 
 		"in vec2 fragTexCoord;\n"
 
 		"out vec4 finalColor;\n"
 
+		// Sample the sprite, which may be in only part of the texture if it is
+		// in an atlas.
+		"float Sample(vec2 coord, float layer) {\n"
+		"  return dot(texture(tex, vec3(uvRect.xy + clamp(coord, 0.f, 1.f) * uvRect.zw, layer)), weight);\n"
+		"}\n"
+
 		"float Sobel(float layer) {\n"
 		"  float sum = 0.f;\n"
 		"  for(int dy = -1; dy <= 1; ++dy)\n"
@@ -91,16 +99,16 @@ void OutlineShader::Init()
 		"    for(int dx = -1; dx <= 1; ++dx)\n"
 		"    {\n"
 		"      vec2 center = fragTexCoord + .618034 * off * vec2(dx, dy);\n"
-		"      float nw = dot(texture(tex, vec3(center + vec2(-off.x, -off.y), layer)), weight);\n"
-		"      float ne = dot(texture(tex, vec3(center + vec2(off.x, -off.y), layer)), weight);\n"
-		"      float sw = dot(texture(tex, vec3(center + vec2(-off.x, off.y), layer)), weight);\n"
-		"      float se = dot(texture(tex, vec3(center + vec2(off.x, off.y), layer)), weight);\n"
+		"      float nw = Sample(center + vec2(-off.x, -off.y), layer);\n"
+		"      float ne = Sample(center + vec2(off.x, -off.y), layer);\n"
+		"      float sw = Sample(center + vec2(-off.x, off.y), layer);\n"
+		"      float se = Sample(center + vec2(off.x, off.y), layer);\n"
 		"      float h = nw + sw - ne - se + 2.f * (\n"
-		"        dot(texture(tex, vec3(center + vec2(-off.x, 0.f), layer)), weight)\n"
-		"          - dot(texture(tex, vec3(center + vec2(off.x, 0.f), layer)), weight));\n"
+		"        Sample(center + vec2(-off.x, 0.f), layer)\n"
+		"          - Sample(center + vec2(off.x, 0.f), layer));\n"
 		"      float v = nw + ne - sw - se + 2.f * (\n"
-		"        dot(texture(tex, vec3(center + vec2(0.f, -off.y), layer)), weight)\n"
-		"          - dot(texture(tex, vec3(center + vec2(0.f, off.y), layer)), weight));\n"
+		"        Sample(center + vec2(0.f, -off.y), layer)\n"
+		"          - Sample(center + vec2(0.f, off.y), layer));\n"
 		"      sum += h * h + v * v;\n"
 		"    }\n"
 		"  }\n"
@@ -123,6 +131,7 @@ void OutlineShader::Init()
 	frameI = shader.Uniform("frame");
 	frameCountI = shader.Uniform("frameCount");
 	colorI = shader.Uniform("color");
+	uvRectI = shader.Uniform("uvRect");
 
 	glUseProgram(shader.Object());
 	glUniform1i(shader.Uniform("tex"), 0);
@@ -190,10 +199,12 @@ void OutlineShader::Draw(const Sprite *sprite, const Point &pos, const Point &si
 	glUniform2fv(positionI, 1, position);
 
 	glUniform4fv(colorI, 1, color.Get());
+	glUniform4fv(uvRectI, 1, sprite->UVRect());
 
 	glBindTexture(GL_TEXTURE_2D_ARRAY, sprite->Texture(unit.Length() * Screen::Zoom() > 50.));
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	OpenGL::CountDrawCall();
 
 	glBindVertexArray(0);
 	glUseProgram(0);
@@ -82,6 +82,15 @@ bool Panel::IsInterruptible() const noexcept
 
 
 
+// Check if this panel must be drawn again even if nothing has happened
+// since it was last drawn. That is always true unless it is static.
+bool Panel::NeedsRedraw() const noexcept
+{
+	return !isStatic || needsRedraw;
+}
+
+
+
 // Clear the list of clickable zones.
 void Panel::ClearZones()
 {
@@ -333,6 +342,23 @@ void Panel::SetInterruptible(bool set)
 
 
 
+// A panel that only changes in response to input can be marked as static,
+// so that frames in which nothing happens do not need to be drawn.
+void Panel::SetIsStatic(bool set)
+{
+	isStatic = set;
+}
+
+
+
+// Ask for a static panel to be drawn again, because it changed on its own.
+void Panel::Redraw()
+{
+	needsRedraw = true;
+}
+
+
+
 // Dim the background of this panel.
 void Panel::DrawBackdrop() const
 {
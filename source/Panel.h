@@ -57,6 +57,9 @@ public:
 	bool TrapAllEvents() const noexcept;
 	// Check if this panel can be "interrupted" to return to the main menu.
 	bool IsInterruptible() const noexcept;
+	// Check if this panel must be drawn again even if nothing has happened
+	// since it was last drawn. That is always true unless it is static.
+	bool NeedsRedraw() const noexcept;
 
 	// Clear the list of clickable zones.
 	void ClearZones();
@@ -112,6 +115,11 @@ protected:
 	void SetIsFullScreen(bool set);
 	void SetTrapAllEvents(bool set);
 	void SetInterruptible(bool set);
+	// A panel that only changes in response to input can be marked as static,
+	// so that frames in which nothing happens do not need to be drawn.
+	void SetIsStatic(bool set);
+	// Ask for a static panel to be drawn again, because it changed on its own.
+	void Redraw();
 
 	// Dim the background of this panel.
 	void DrawBackdrop() const;
@@ -186,6 +194,8 @@ private:
 	bool isFullScreen = false;
 	bool trapAllEvents = true;
 	bool isInterruptible = true;
+	bool isStatic = false;
+	bool needsRedraw = true;
 
 	std::list<Zone> zones;
 
@@ -51,6 +51,9 @@ PlanetPanel::PlanetPanel(PlayerInfo &player, function<void()> callback)
 	planet(*player.GetPlanet()), system(*player.GetSystem()),
 	ui(*GameData::Interfaces().Get("planet"))
 {
+	// Nothing on the planet is animated, so it only needs to be drawn again
+	// when the player does something.
+	SetIsStatic(true);
 	trading.reset(new TradingPanel(player));
 	bank.reset(new BankPanel(player));
 	spaceport.reset(new SpaceportPanel(player));
@@ -62,9 +65,10 @@ PlanetPanel::PlanetPanel(PlayerInfo &player, function<void()> callback)
 	text.Wrap(planet.Description());
 
 	// Since the loading of landscape images is deferred, make sure that the
-	// landscapes for this system are loaded before showing the planet panel.
+	// landscape is loaded next. If it has not been uploaded yet, it is drawn as
+	// soon as it is, rather than stalling the game until then.
 	GameData::Preload(planet.Landscape());
-	GameData::FinishLoadingSprites();
+	GameData::Promote(planet.Landscape());
 }
 
 
@@ -87,8 +91,13 @@ void PlanetPanel::Step()
 	if(activePanel != spaceport.get() && GetUI()->IsTop(activePanel))
 	{
 		Mission *mission = player.MissionToOffer(Mission::LANDING);
+		// Missions with no conversation are accepted right away, which can
+		// change the cargo and passengers that the open panel lists.
 		if(mission)
+		{
 			mission->Do(Mission::OFFER, player, GetUI());
+			Redraw();
+		}
 		else
 			player.HandleBlockedMissions(Mission::LANDING, GetUI());
 	}
@@ -18,7 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "AI.h"
 #include "Audio.h"
 #include "ConversationPanel.h"
-#include "DataFile.h"
+#include "DataStream.h"
 #include "DataWriter.h"
 #include "Dialog.h"
 #include "DistanceMap.h"
@@ -37,6 +37,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "RaidFleet.h"
 #include "Random.h"
 #include "SavedGame.h"
+#include "SaveWriter.h"
 #include "Ship.h"
 #include "ShipEvent.h"
 #include "ShipJumpNavigation.h"
@@ -52,6 +53,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <functional>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 
@@ -128,9 +130,6 @@ void PlayerInfo::Clear()
 	Messages::Reset();
 
 	conditions.Clear();
-
-	delete transactionSnapshot;
-	transactionSnapshot = nullptr;
 }
 
 
@@ -189,8 +188,10 @@ void PlayerInfo::New(const StartConditions &start)
 // Load player information from a saved game file.
 void PlayerInfo::Load(const string &path)
 {
-	// Make sure any previously loaded data is cleared.
+	// Make sure any previously loaded data is cleared, and that the file is
+	// not still being written.
 	Clear();
+	SaveWriter::Wait();
 
 	// A listing of missions and the ships where their cargo or passengers were when the game was saved.
 	// Missions and ships are referred to by string UUIDs.
@@ -214,9 +215,12 @@ void PlayerInfo::Load(const string &path)
 	// Register derived conditions now, so old primary versions can load into them.
 	RegisterDerivedConditions();
 
-	DataFile file(path);
-	for(const DataNode &child : file)
+	// Read the file one top-level node at a time, so the whole saved game is
+	// never held in memory as text and as nodes at once.
+	DataStream file(path);
+	while(file.Next())
 	{
+		const DataNode &child = file.Node();
 		// Basic player information and persistent UI settings:
 		if(child.Token(0) == "pilot" && child.Size() >= 3)
 		{
@@ -454,6 +458,11 @@ void PlayerInfo::Load(const string &path)
 	// will count as non-depreciated.
 	if(!depreciation.IsLoaded())
 		depreciation.Init(ships, date.DaysSinceEpoch());
+
+	// Unless this was a snapshot, the date that was just read is also the date
+	// of the file that this player will be saved to.
+	if(filePath == path)
+		savedDate = date;
 }
 
 
@@ -461,6 +470,7 @@ void PlayerInfo::Load(const string &path)
 // Load the most recently saved player (if any). Returns false when no save was loaded.
 bool PlayerInfo::LoadRecent()
 {
+	SaveWriter::Wait();
 	string recentPath = Files::Read(Files::Config() + "recent.txt");
 	// Trim trailing whitespace (including newlines) from the path.
 	while(!recentPath.empty() && recentPath.back() <= ' ')
@@ -485,17 +495,36 @@ void PlayerInfo::Save() const
 	if(!CanBeSaved())
 		return;
 
-	// Remember that this was the most recently saved player.
-	Files::Write(Files::Config() + "recent.txt", filePath + '\n');
-
-	if(filePath.rfind(".txt") == filePath.length() - 4)
-	{
-		// Only update the backups if this save will have a newer date.
-		SavedGame saved(filePath);
-		if(saved.GetDate() != date.ToString())
+	// Everything that is saved is gathered here. The files are written, and the
+	// backups rotated, by the save writer while the game goes on.
+	const shared_ptr<const string> contents = make_shared<string>(SaveToString());
+	DataWriter globalConditions;
+	GameData::GlobalConditions().Save(globalConditions);
+	const shared_ptr<const string> conditions = make_shared<string>(globalConditions.GetString());
+
+	const string path = filePath;
+	const string config = Files::Config();
+	// If the date of the save being replaced is not known (i.e. because a
+	// snapshot was loaded in place of this pilot), the writer reads it from the
+	// start of the file.
+	const string oldDate = savedDate ? savedDate.ToString() : "";
+	const string newDate = date.ToString();
+	savedDate = date;
+	const int previousCount = Preferences::GetPreviousSaveCount();
+	const bool hasSpaceport = planet->HasSpaceport();
+	const bool compress = Preferences::Has("Compress saved games");
+	SaveWriter::Add([=]()
+	{
+		// Remember that this was the most recently saved player.
+		SaveWriter::Write(config + "recent.txt", path + '\n');
+
+		// Only update the backups if this save will have a newer date. The most
+		// recent backup is a copy, so that the save itself is only replaced once
+		// the new one has been completely written.
+		if(path.rfind(".txt") == path.length() - 4
+				&& (oldDate.empty() ? SavedGame::ReadDate(path) : oldDate) != newDate)
 		{
-			string root = filePath.substr(0, filePath.length() - 4);
-			const int previousCount = Preferences::GetPreviousSaveCount();
+			string root = path.substr(0, path.length() - 4);
 			const string rootPrevious = root + "~~previous-";
 			for(int i = previousCount - 1; i > 0; --i)
 			{
@@ -503,18 +532,23 @@ void PlayerInfo::Save() const
 				if(Files::Exists(toMove))
 					Files::Move(toMove, rootPrevious + to_string(i + 1) + ".txt");
 			}
-			if(Files::Exists(filePath))
-				Files::Move(filePath, rootPrevious + "1.txt");
-			if(planet->HasSpaceport())
-				Save(rootPrevious + "spaceport.txt");
+			if(Files::Exists(path))
+				Files::Copy(path, rootPrevious + "1.txt");
+			if(hasSpaceport)
+			{
+				if(SaveWriter::Write(rootPrevious + "spaceport.txt", *contents, compress))
+					SavedGame::AddToIndex(rootPrevious + "spaceport.txt", *contents);
+			}
 		}
-	}
 
-	Save(filePath);
+		// If the save could not be written, the index must still describe the
+		// old file.
+		if(SaveWriter::Write(path, *contents, compress))
+			SavedGame::AddToIndex(path, *contents);
 
-	// Save global conditions:
-	DataWriter globalConditions(Files::Config() + "global conditions.txt");
-	GameData::GlobalConditions().Save(globalConditions);
+		// Save global conditions:
+		SaveWriter::Write(config + "global conditions.txt", *conditions);
+	});
 }
 
 
@@ -532,20 +566,32 @@ string PlayerInfo::Identifier() const
 
 void PlayerInfo::StartTransaction()
 {
-	assert(!transactionSnapshot && "Starting PlayerInfo transaction while one is already active");
-
-	// Create in-memory DataWriter and save to it.
-	transactionSnapshot = new DataWriter();
-	Save(*transactionSnapshot);
+	assert(!isInTransaction && "Starting PlayerInfo transaction while one is already active");
+	isInTransaction = true;
 }
 
 
 
 void PlayerInfo::FinishTransaction()
 {
-	assert(transactionSnapshot && "Finishing PlayerInfo while one hasn't been started");
-	delete transactionSnapshot;
-	transactionSnapshot = nullptr;
+	assert(isInTransaction && "Finishing PlayerInfo while one hasn't been started");
+	isInTransaction = false;
+	transactionSnapshot.clear();
+}
+
+
+
+// This must be called before anything changes the player during a
+// transaction. The first time, it stores the player's current state, which
+// is the state the transaction started with.
+void PlayerInfo::BeforeChange()
+{
+	if(!isInTransaction || !transactionSnapshot.empty())
+		return;
+
+	DataWriter out;
+	Save(out);
+	transactionSnapshot = out.GetString();
 }
 
 
@@ -665,6 +711,7 @@ const string &PlayerInfo::LastName() const
 // Set the player's name. This will also set the saved game file name.
 void PlayerInfo::SetName(const string &first, const string &last)
 {
+	BeforeChange();
 	firstName = first;
 	lastName = last;
 
@@ -4155,13 +4202,27 @@ void PlayerInfo::Autosave() const
 
 void PlayerInfo::Save(const string &filePath) const
 {
-	if(transactionSnapshot)
-		transactionSnapshot->SaveToPath(filePath);
-	else
+	const shared_ptr<const string> contents = make_shared<string>(SaveToString());
+	const bool compress = Preferences::Has("Compress saved games");
+	SaveWriter::Add([filePath, contents, compress]()
 	{
-		DataWriter out(filePath);
-		Save(out);
-	}
+		if(SaveWriter::Write(filePath, *contents, compress))
+			SavedGame::AddToIndex(filePath, *contents);
+	});
+}
+
+
+
+// Get the contents of the saved game. During a transaction, this is the
+// state of the player when the transaction started.
+string PlayerInfo::SaveToString() const
+{
+	if(!transactionSnapshot.empty())
+		return transactionSnapshot;
+
+	DataWriter out;
+	Save(out);
+	return out.GetString();
 }
 
 
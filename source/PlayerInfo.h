@@ -92,11 +92,15 @@ public:
 	// are multiple pilots with the same name it may have a digit appended.)
 	std::string Identifier() const;
 
-	// Start a transaction. This stores the current state, and any Save()
-	// calls during the transaction will store this saved state.
+	// Start a transaction. Any Save() calls during the transaction will store
+	// the state the player was in when it started.
 	void StartTransaction();
 	// Complete the transaction.
 	void FinishTransaction();
+	// This must be called before anything changes the player during a
+	// transaction. The first time, it stores the player's current state, which
+	// is the state the transaction started with.
+	void BeforeChange();
 
 	// Apply the given changes and store them in the player's saved game file.
 	void AddChanges(std::list<DataNode> &changes);
@@ -353,6 +357,9 @@ private:
 	void Autosave() const;
 	void Save(const std::string &path) const;
 	void Save(DataWriter &out) const;
+	// Get the contents of the saved game. During a transaction, this is the
+	// state of the player when the transaction started.
+	std::string SaveToString() const;
 
 	// Check for and apply any punitive actions from planetary security.
 	void Fine(UI *ui);
@@ -378,6 +385,9 @@ private:
 	std::string filePath;
 
 	Date date;
+	// The date of the saved game in the file, if it is known. This decides
+	// whether the backups must be rotated when the player is saved again.
+	mutable Date savedDate;
 	SystemEntry entry = SystemEntry::TAKE_OFF;
 	const System *previousSystem = nullptr;
 	const System *system = nullptr;
@@ -467,7 +477,11 @@ private:
 	// Basic information about the player's starting scenario.
 	CoreStartData startData;
 
-	DataWriter *transactionSnapshot = nullptr;
+	// The state of the player when the current transaction started. This is
+	// only stored once something is about to change the player, so that
+	// transactions that change nothing cost nothing.
+	bool isInTransaction = false;
+	std::string transactionSnapshot;
 };
 
 
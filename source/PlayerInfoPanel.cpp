@@ -45,9 +45,20 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef DEAD_COLOR("dead");
+	const ColorRef DIMMER_COLOR("dimmer");
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef DISABLED_COLOR("disabled");
+	const ColorRef FAINT_COLOR("faint");
+	const ColorRef FLAGSHIP_COLOR("flagship");
+	const ColorRef MEDIUM_COLOR("medium");
+
+	const InterfaceRef INFO_PANEL_INTERFACE("info panel");
+
 	int LinesPerPage()
 	{
-		auto bounds = GameData::Interfaces().Get("info panel")->GetBox("fleet");
+		auto bounds = INFO_PANEL_INTERFACE.Get()->GetBox("fleet");
 		return (bounds.Height() - 8 - 20 - 5) / 20;
 	}
 
@@ -71,10 +82,10 @@ namespace {
 			}
 		}
 
-		const Color &dim = *GameData::Colors().Get("medium");
+		const Color &dim = *MEDIUM_COLOR;
 		table.DrawGap(10);
 		table.DrawUnderline(dim);
-		table.Draw(title, *GameData::Colors().Get("bright"));
+		table.Draw(title, *BRIGHT_COLOR);
 		table.Advance();
 		table.DrawGap(5);
 
@@ -259,7 +270,7 @@ void PlayerInfoPanel::Draw()
 		interfaceInfo.SetCondition("enable logbook");
 
 	// Draw the interface.
-	const Interface *infoPanelUi = GameData::Interfaces().Get("info panel");
+	const Interface *infoPanelUi = INFO_PANEL_INTERFACE.Get();
 	infoPanelUi->Draw(interfaceInfo, this);
 
 	// Draw the player and fleet info sections.
@@ -614,8 +625,8 @@ void PlayerInfoPanel::DrawPlayer(const Rectangle &bounds)
 		return;
 
 	// Colors to draw with.
-	const Color &dim = *GameData::Colors().Get("medium");
-	const Color &bright = *GameData::Colors().Get("bright");
+	const Color &dim = *MEDIUM_COLOR;
+	const Color &bright = *BRIGHT_COLOR;
 
 	// Two columns of opposite alignment are used to simulate a single visual column.
 	Table table;
@@ -708,14 +719,14 @@ void PlayerInfoPanel::DrawFleet(const Rectangle &bounds)
 		return;
 
 	// Colors to draw with.
-	const Color &back = *GameData::Colors().Get("faint");
-	const Color &selectedBack = *GameData::Colors().Get("dimmer");
-	const Color &dim = *GameData::Colors().Get("medium");
-	const Color &bright = *GameData::Colors().Get("bright");
-	const Color &elsewhere = *GameData::Colors().Get("dim");
-	const Color &dead = *GameData::Colors().Get("dead");
-	const Color &flagship = *GameData::Colors().Get("flagship");
-	const Color &disabled = *GameData::Colors().Get("disabled");
+	const Color &back = *FAINT_COLOR;
+	const Color &selectedBack = *DIMMER_COLOR;
+	const Color &dim = *MEDIUM_COLOR;
+	const Color &bright = *BRIGHT_COLOR;
+	const Color &elsewhere = *DIM_COLOR;
+	const Color &dead = *DEAD_COLOR;
+	const Color &flagship = *FLAGSHIP_COLOR;
+	const Color &disabled = *DISABLED_COLOR;
 
 	// Table attributes.
 	Table table;
@@ -938,7 +949,7 @@ PlayerInfoPanel::SortableColumn::SortableColumn(
 
 int PlayerInfoPanel::GetShipIndexFromPoint(int x, int y)
 {
-	auto bounds = GameData::Interfaces().Get("info panel")->GetBox("fleet");
+	auto bounds = INFO_PANEL_INTERFACE.Get()->GetBox("fleet");
 
 	// Duplicate the table drawing logic. This would be much nicer if table was
 	// persistent class, instead of just a formatting aid.
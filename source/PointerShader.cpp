@@ -153,6 +153,7 @@ void PointerShader::Add(const Point &center, const Point &angle,
 	glUniform4fv(colorI, 1, color.Get());
 
 	glDrawArrays(GL_TRIANGLES, 0, 3);
+	OpenGL::CountDrawCall();
 }
 
 
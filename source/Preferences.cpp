@@ -21,9 +21,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "DataNode.h"
 #include "DataWriter.h"
 #include "Files.h"
+#include "GameData.h"
 #include "GameWindow.h"
 #include "Logger.h"
 #include "Screen.h"
+#include "TextureBudget.h"
 #include <SDL2/SDL_log.h>
 
 #ifdef __linux__
@@ -37,7 +39,12 @@ using namespace std;
 
 namespace {
 	map<string, bool> settings;
+	// This changes whenever a setting is added or removed, so that any
+	// PreferenceFlag knows it must look up its setting again.
+	atomic<unsigned> settingsGeneration(1);
 	int scrollSpeed = 60;
+	// The time, in milliseconds, that may be spent uploading textures each frame.
+	double uploadBudget = 4.;
 
 	// Strings for ammo expenditure:
 	const string EXPEND_AMMO = "Escorts expend ammo";
@@ -52,6 +59,11 @@ namespace {
 	const double ZOOM_INTERVAL = 1.25;
 	double viewZoom = 1.0;
 	constexpr double VOLUME_SCALE = .25;
+	// The texture budget is stored in megabytes.
+	constexpr size_t BYTES_PER_MB = 1024 * 1024;
+	// Only a budget that the user chose is saved. Otherwise, the default for
+	// this device is worked out again each time the game starts.
+	bool hasTextureBudget = false;
 
 	// Default to fullscreen.
 	int screenModeIndex = 1;
@@ -187,6 +199,9 @@ void Preferences::Load()
 			SDL_Log("Detected low memory... defaulting Reduced graphics to true");
 			settings["Reduced graphics"] = true;
 		}
+		// Textures share the device's memory with everything else, so by
+		// default, let them use no more than a quarter of it.
+		GameData::GetTextureBudget().SetLimit(static_cast<uint64_t>(si.totalram) * si.mem_unit / 4);
 	}
 #endif
 
@@ -201,6 +216,13 @@ void Preferences::Load()
 			Audio::SetVolume(node.Value(1) * VOLUME_SCALE);
 		else if(node.Token(0) == "scroll speed" && node.Size() >= 2)
 			scrollSpeed = node.Value(1);
+		else if(node.Token(0) == "texture budget" && node.Size() >= 2)
+		{
+			GameData::GetTextureBudget().SetLimit(static_cast<size_t>(max(0., node.Value(1)) * BYTES_PER_MB));
+			hasTextureBudget = true;
+		}
+		else if(node.Token(0) == "upload budget" && node.Size() >= 2)
+			uploadBudget = max(.5, node.Value(1));
 		else if(node.Token(0) == "boarding target")
 			boardingIndex = max<int>(0, min<int>(node.Value(1), BOARDING_SETTINGS.size() - 1));
 		else if(node.Token(0) == "Flotsam collection")
@@ -276,6 +298,7 @@ void Preferences::Load()
 		SDL_Log("Previous loading crashed... defaulting Reduced graphics to true");
 		settings["Reduced graphics"] = true;
 	}
+	++settingsGeneration;
 }
 
 
@@ -288,6 +311,9 @@ void Preferences::Save()
 	out.Write("window size", Screen::RawWidth(), Screen::RawHeight());
 	out.Write("zoom", Screen::UserZoom());
 	out.Write("scroll speed", scrollSpeed);
+	if(hasTextureBudget)
+		out.Write("texture budget", GameData::GetTextureBudget().Limit() / BYTES_PER_MB);
+	out.Write("upload budget", uploadBudget);
 	out.Write("boarding target", boardingIndex);
 	out.Write("Flotsam collection", flotsamIndex);
 	out.Write("view zoom", viewZoom);
@@ -320,7 +346,11 @@ bool Preferences::Has(const string &name)
 
 void Preferences::Set(const string &name, bool on)
 {
-	settings[name] = on;
+	auto result = settings.emplace(name, on);
+	if(result.second)
+		++settingsGeneration;
+	else
+		result.first->second = on;
 	Preferences::Save();
 }
 
@@ -384,6 +414,14 @@ void Preferences::SetScrollSpeed(int speed)
 
 
 
+// The time, in milliseconds, that may be spent uploading textures each frame.
+double Preferences::UploadBudget()
+{
+	return uploadBudget;
+}
+
+
+
 // View zoom.
 double Preferences::ViewZoom()
 {
@@ -709,3 +747,19 @@ int Preferences::GetPreviousSaveCount()
 {
 	return previousSaveCount;
 }
+
+
+
+// Check whether this setting is on, just like Preferences::Has().
+bool PreferenceFlag::Has() const
+{
+	unsigned current = settingsGeneration.load(memory_order_acquire);
+	if(generation.load(memory_order_acquire) != current)
+	{
+		auto it = settings.find(name);
+		value.store(it == settings.end() ? nullptr : &it->second, memory_order_release);
+		generation.store(current, memory_order_release);
+	}
+	const bool *result = value.load(memory_order_acquire);
+	return result && *result;
+}
@@ -16,6 +16,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #ifndef PREFERENCES_H_
 #define PREFERENCES_H_
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -112,6 +113,9 @@ public:
 	static int ScrollSpeed();
 	static void SetScrollSpeed(int speed);
 
+	// The time, in milliseconds, that may be spent uploading textures each frame.
+	static double UploadBudget();
+
 	// View zoom.
 	static double ViewZoom();
 	static bool ZoomViewIn();
@@ -171,4 +175,28 @@ public:
 
 
 
+// A handle to one of the on / off settings, for code that checks the same
+// setting every frame. The setting is only looked up by name again after
+// settings have been added or removed.
+class PreferenceFlag {
+public:
+	explicit constexpr PreferenceFlag(const char *name) noexcept : name(name) {}
+	PreferenceFlag(const PreferenceFlag &) = delete;
+	PreferenceFlag &operator=(const PreferenceFlag &) = delete;
+
+	// Check whether this setting is on, just like Preferences::Has().
+	bool Has() const;
+	explicit operator bool() const { return Has(); }
+
+
+private:
+	const char *name;
+	// The setting, or null if it has never been set, and the version of the
+	// settings that it was looked up in. Handles may be shared by threads.
+	mutable std::atomic<const bool *> value{nullptr};
+	mutable std::atomic<unsigned> generation{0};
+};
+
+
+
 #endif
@@ -795,6 +795,7 @@ void PreferencesPanel::DrawSettings()
 		REACTIVATE_HELP,
 		"Interrupt fast-forward",
 		"Landing zoom",
+		"Compress saved games",
 		SCROLL_SPEED,
 		DATE_FORMAT
 	};
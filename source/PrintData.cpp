@@ -15,8 +15,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "PrintData.h"
 
+#include "ColumnWriter.h"
 #include "DataFile.h"
 #include "DataNode.h"
+#include "Dictionary.h"
+#include "Files.h"
 #include "GameData.h"
 #include "GameEvent.h"
 #include "LocationFilter.h"
@@ -25,9 +28,18 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Ship.h"
 #include "System.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -47,10 +59,10 @@ namespace {
 
 	// Take a set of items and a set of sales and print a list of each item followed by the sales it appears in.
 	template <class Type>
-	void PrintItemSales(const Set<Type> &items, const Set<Sale<Type>> &sales,
+	void PrintItemSales(ostream &out, const Set<Type> &items, const Set<Sale<Type>> &sales,
 		const string &itemNoun, const string &saleNoun)
 	{
-		cout << itemNoun << ',' << saleNoun << '\n';
+		out << itemNoun << ',' << saleNoun << '\n';
 		map<string, set<string>> itemSales;
 		for(auto &saleIt : sales)
 			for(auto &itemIt : saleIt.second)
@@ -59,64 +71,64 @@ namespace {
 		{
 			if(itemIt.first != ObjectName(itemIt.second))
 				continue;
-			cout << '"' << itemIt.first << '"';
+			out << '"' << itemIt.first << '"';
 			for(auto &saleName : itemSales[itemIt.first])
-				cout << ',' << '"' << saleName << '"';
-			cout << '\n';
+				out << ',' << '"' << saleName << '"';
+			out << '\n';
 		}
 	}
 
 	// Take a set of sales and print a list of each followed by the items it contains.
 	// Will fail to compile for items not of type Ship or Outfit.
 	template <class Type>
-	void PrintSales(const Set<Sale<Type>> &sales, const string &saleNoun, const string &itemNoun)
+	void PrintSales(ostream &out, const Set<Sale<Type>> &sales, const string &saleNoun, const string &itemNoun)
 	{
-		cout << saleNoun << ';' << itemNoun << '\n';
+		out << saleNoun << ';' << itemNoun << '\n';
 		for(auto &saleIt : sales)
 		{
-			cout << '"' << saleIt.first << '"';
+			out << '"' << saleIt.first << '"';
 			int index = 0;
 			for(auto &item : saleIt.second)
-				cout << (index++ ? ';' : ',') << '"' << ObjectName(*item) << '"';
-			cout << '\n';
+				out << (index++ ? ';' : ',') << '"' << ObjectName(*item) << '"';
+			out << '\n';
 		}
 	}
 
 
 	// Take a Set and print a list of the names (keys) it contains.
 	template <class Type>
-	void PrintObjectList(const Set<Type> &objects, bool withQuotes, const string &name)
+	void PrintObjectList(ostream &out, const Set<Type> &objects, bool withQuotes, const string &name)
 	{
-		cout << name << '\n';
+		out << name << '\n';
 		const string start = withQuotes ? "\"" : "";
 		const string end = withQuotes ? "\"\n" : "\n";
 		for(const auto &it : objects)
-			cout << start << it.first << end;
+			out << start << it.first << end;
 	}
 
 	// Takes a Set of objects and prints the key for each, followed by a list of its attributes.
 	// The class 'Type' must have an accessible 'Attributes()' member method which returns a collection of strings.
 	template <class Type>
-	void PrintObjectAttributes(const Set<Type> &objects, const string &name)
+	void PrintObjectAttributes(ostream &out, const Set<Type> &objects, const string &name)
 	{
-		cout << name << ',' << "attributes" << '\n';
+		out << name << ',' << "attributes" << '\n';
 		for(auto &it : objects)
 		{
-			cout << '"' << it.first << '"';
+			out << '"' << it.first << '"';
 			const Type &object = it.second;
 			int index = 0;
 			for(const string &attribute : object.Attributes())
-				cout << (index++ ? ';' : ',') << '"' << attribute << '"';
-			cout << '\n';
+				out << (index++ ? ';' : ',') << '"' << attribute << '"';
+			out << '\n';
 		}
 	}
 
 	// Takes a Set of objects, which must have an accessible member `Attributes()`, returning a collection of strings.
 	// Prints a list of all those string attributes and, for each, the list of keys of objects with that attribute.
 	template <class Type>
-	void PrintObjectsByAttribute(const Set<Type> &objects, const string &name)
+	void PrintObjectsByAttribute(ostream &out, const Set<Type> &objects, const string &name)
 	{
-		cout << "attribute" << ',' << name << '\n';
+		out << "attribute" << ',' << name << '\n';
 		set<string> attributes;
 		for(auto &it : objects)
 		{
@@ -126,24 +138,24 @@ namespace {
 		}
 		for(const string &attribute : attributes)
 		{
-			cout << '"' << attribute << '"';
+			out << '"' << attribute << '"';
 			int index = 0;
 			for(auto &it : objects)
 			{
 				const Type &object = it.second;
 				if(object.Attributes().count(attribute))
-					cout << (index++ ? ';' : ',') << '"' << it.first << '"';
+					out << (index++ ? ';' : ',') << '"' << it.first << '"';
 			}
-			cout << '\n';
+			out << '\n';
 		}
 	}
 
 
-	void Ships(const char *const *argv)
+	void Ships(const char *const *argv, ostream &out)
 	{
-		auto PrintBaseShipStats = []() -> void
+		auto PrintBaseShipStats = [&out]() -> void
 		{
-			cout << "model" << ',' << "category" << ',' << "chassis cost" << ',' << "loaded cost" << ',' << "shields" << ','
+			out << "model" << ',' << "category" << ',' << "chassis cost" << ',' << "loaded cost" << ',' << "shields" << ','
 				<< "hull" << ',' << "mass" << ',' << "drag" << ',' << "heat dissipation" << ','
 				<< "required crew" << ',' << "bunks" << ',' << "cargo space" << ',' << "fuel" << ','
 				<< "outfit space" << ',' << "weapon capacity" << ',' << "engine capacity" << ',' << "gun mounts" << ','
@@ -156,27 +168,27 @@ namespace {
 					continue;
 
 				const Ship &ship = it.second;
-				cout << '"' << it.first << '"' << ',';
+				out << '"' << it.first << '"' << ',';
 
 				const Outfit &attributes = ship.BaseAttributes();
-				cout << '"' << attributes.Category() << '"' << ',';
-				cout << ship.ChassisCost() << ',';
-				cout << ship.Cost() << ',';
+				out << '"' << attributes.Category() << '"' << ',';
+				out << ship.ChassisCost() << ',';
+				out << ship.Cost() << ',';
 
 				auto mass = attributes.Mass() ? attributes.Mass() : 1.;
-				cout << ship.MaxShields() << ',';
-				cout << ship.MaxHull() << ',';
-				cout << mass << ',';
-				cout << attributes.Get("drag") << ',';
-				cout << ship.HeatDissipation() * 1000. << ',';
-				cout << attributes.Get("required crew") << ',';
-				cout << attributes.Get("bunks") << ',';
-				cout << attributes.Get("cargo space") << ',';
-				cout << attributes.Get("fuel capacity") << ',';
-
-				cout << attributes.Get("outfit space") << ',';
-				cout << attributes.Get("weapon capacity") << ',';
-				cout << attributes.Get("engine capacity") << ',';
+				out << ship.MaxShields() << ',';
+				out << ship.MaxHull() << ',';
+				out << mass << ',';
+				out << attributes.Get("drag") << ',';
+				out << ship.HeatDissipation() * 1000. << ',';
+				out << attributes.Get("required crew") << ',';
+				out << attributes.Get("bunks") << ',';
+				out << attributes.Get("cargo space") << ',';
+				out << attributes.Get("fuel capacity") << ',';
+
+				out << attributes.Get("outfit space") << ',';
+				out << attributes.Get("weapon capacity") << ',';
+				out << attributes.Get("engine capacity") << ',';
 
 				int numTurrets = 0;
 				int numGuns = 0;
@@ -187,17 +199,17 @@ namespace {
 					else
 						++numGuns;
 				}
-				cout << numGuns << ',' << numTurrets << ',';
+				out << numGuns << ',' << numTurrets << ',';
 
 				int numFighters = ship.BaysTotal("Fighter");
 				int numDrones = ship.BaysTotal("Drone");
-				cout << numFighters << ',' << numDrones << '\n';
+				out << numFighters << ',' << numDrones << '\n';
 			}
 		};
 
-		auto PrintLoadedShipStats = [](bool variants) -> void
+		auto PrintLoadedShipStats = [&out](bool variants) -> void
 		{
-			cout << "model" << ',' << "category" << ',' << "cost" << ',' << "shields" << ','
+			out << "model" << ',' << "category" << ',' << "cost" << ',' << "shields" << ','
 				<< "hull" << ',' << "mass" << ',' << "required crew" << ',' << "bunks" << ','
 				<< "cargo space" << ',' << "fuel" << ',' << "outfit space" << ',' << "weapon capacity" << ','
 				<< "engine capacity" << ',' << "speed" << ',' << "accel" << ',' << "turn" << ','
@@ -213,27 +225,27 @@ namespace {
 					continue;
 
 				const Ship &ship = it.second;
-				cout << '"' << it.first << '"' << ',';
+				out << '"' << it.first << '"' << ',';
 
 				const Outfit &attributes = ship.Attributes();
-				cout << '"' << attributes.Category() << '"' << ',';
-				cout << ship.Cost() << ',';
+				out << '"' << attributes.Category() << '"' << ',';
+				out << ship.Cost() << ',';
 
 				auto mass = attributes.Mass() ? attributes.Mass() : 1.;
-				cout << ship.MaxShields() << ',';
-				cout << ship.MaxHull() << ',';
-				cout << mass << ',';
-				cout << attributes.Get("required crew") << ',';
-				cout << attributes.Get("bunks") << ',';
-				cout << attributes.Get("cargo space") << ',';
-				cout << attributes.Get("fuel capacity") << ',';
-
-				cout << ship.BaseAttributes().Get("outfit space") << ',';
-				cout << ship.BaseAttributes().Get("weapon capacity") << ',';
-				cout << ship.BaseAttributes().Get("engine capacity") << ',';
-				cout << (attributes.Get("drag") ? (60. * attributes.Get("thrust") / attributes.Get("drag")) : 0) << ',';
-				cout << 3600. * attributes.Get("thrust") / mass << ',';
-				cout << 60. * attributes.Get("turn") / mass << ',';
+				out << ship.MaxShields() << ',';
+				out << ship.MaxHull() << ',';
+				out << mass << ',';
+				out << attributes.Get("required crew") << ',';
+				out << attributes.Get("bunks") << ',';
+				out << attributes.Get("cargo space") << ',';
+				out << attributes.Get("fuel capacity") << ',';
+
+				out << ship.BaseAttributes().Get("outfit space") << ',';
+				out << ship.BaseAttributes().Get("weapon capacity") << ',';
+				out << ship.BaseAttributes().Get("engine capacity") << ',';
+				out << (attributes.Get("drag") ? (60. * attributes.Get("thrust") / attributes.Get("drag")) : 0) << ',';
+				out << 3600. * attributes.Get("thrust") / mass << ',';
+				out << 60. * attributes.Get("turn") / mass << ',';
 
 				double energyConsumed = attributes.Get("energy consumption")
 					+ max(attributes.Get("thrusting energy"), attributes.Get("reverse thrusting energy"))
@@ -262,13 +274,13 @@ namespace {
 						energyConsumed += oit.second * oit.first->FiringEnergy() / reload;
 						heatProduced += oit.second * oit.first->FiringHeat() / reload;
 					}
-				cout << 60. * (attributes.Get("energy generation") + attributes.Get("solar collection")) << ',';
-				cout << 60. * energyConsumed << ',';
-				cout << attributes.Get("energy capacity") << ',';
-				cout << ship.IdleHeat() / max(1., ship.MaximumHeat()) << ',';
-				cout << 60. * heatProduced << ',';
+				out << 60. * (attributes.Get("energy generation") + attributes.Get("solar collection")) << ',';
+				out << 60. * energyConsumed << ',';
+				out << attributes.Get("energy capacity") << ',';
+				out << ship.IdleHeat() / max(1., ship.MaximumHeat()) << ',';
+				out << 60. * heatProduced << ',';
 				// Maximum heat is 100 degrees per ton. Bleed off rate is 1/1000 per 60th of a second, so:
-				cout << 60. * ship.HeatDissipation() * ship.MaximumHeat() << ',';
+				out << 60. * ship.HeatDissipation() * ship.MaximumHeat() << ',';
 
 				int numTurrets = 0;
 				int numGuns = 0;
@@ -279,11 +291,11 @@ namespace {
 					else
 						++numGuns;
 				}
-				cout << numGuns << ',' << numTurrets << ',';
+				out << numGuns << ',' << numTurrets << ',';
 
 				int numFighters = ship.BaysTotal("Fighter");
 				int numDrones = ship.BaysTotal("Drone");
-				cout << numFighters << ',' << numDrones << ',';
+				out << numFighters << ',' << numDrones << ',';
 
 				double deterrence = 0.;
 				for(const Hardpoint &hardpoint : ship.Weapons())
@@ -297,11 +309,11 @@ namespace {
 							+ (weapon->RelativeHullDamage() * ship.MaxHull());
 						deterrence += .12 * damage / weapon->Reload();
 					}
-				cout << deterrence << '\n';
+				out << deterrence << '\n';
 			}
 		};
 
-		auto PrintShipList = [](bool variants) -> void
+		auto PrintShipList = [&out](bool variants) -> void
 		{
 			for(auto &it : GameData::Ships())
 			{
@@ -309,7 +321,7 @@ namespace {
 				if(it.second.TrueModelName() != it.first && !variants)
 					continue;
 
-				cout << "\"" << it.first << "\"\n";
+				out << "\"" << it.first << "\"\n";
 			}
 		};
 
@@ -332,7 +344,7 @@ namespace {
 		}
 
 		if(sales)
-			PrintItemSales(GameData::Ships(), GameData::Shipyards(), "ship", "shipyards");
+			PrintItemSales(out, GameData::Ships(), GameData::Shipyards(), "ship", "shipyards");
 		else if(loaded)
 			PrintLoadedShipStats(variants);
 		else if(list)
@@ -341,11 +353,11 @@ namespace {
 			PrintBaseShipStats();
 	}
 
-	void Outfits(const char *const *argv)
+	void Outfits(const char *const *argv, ostream &out)
 	{
-		auto PrintWeaponStats = []() -> void
+		auto PrintWeaponStats = [&out]() -> void
 		{
-			cout << "name" << ',' << "category" << ',' << "cost" << ',' << "space" << ',' << "range" << ','
+			out << "name" << ',' << "category" << ',' << "cost" << ',' << "space" << ',' << "range" << ','
 				<< "reload" << ',' << "burst count" << ',' << "burst reload" << ',' << "lifetime" << ','
 				<< "shots/second" << ',' << "energy/shot" << ',' << "heat/shot" << ',' << "recoil/shot" << ','
 				<< "energy/s" << ',' << "heat/s" << ',' << "recoil/s" << ',' << "shield/s" << ','
@@ -362,80 +374,80 @@ namespace {
 					continue;
 
 				const Outfit &outfit = it.second;
-				cout << '"' << it.first << '"' << ',';
-				cout << '"' << outfit.Category() << '"' << ',';
-				cout << outfit.Cost() << ',';
-				cout << -outfit.Get("weapon capacity") << ',';
+				out << '"' << it.first << '"' << ',';
+				out << '"' << outfit.Category() << '"' << ',';
+				out << outfit.Cost() << ',';
+				out << -outfit.Get("weapon capacity") << ',';
 
-				cout << outfit.Range() << ',';
+				out << outfit.Range() << ',';
 
 				double reload = outfit.Reload();
-				cout << reload << ',';
-				cout << outfit.BurstCount() << ',';
-				cout << outfit.BurstReload() << ',';
-				cout << outfit.TotalLifetime() << ',';
+				out << reload << ',';
+				out << outfit.BurstCount() << ',';
+				out << outfit.BurstReload() << ',';
+				out << outfit.TotalLifetime() << ',';
 				double fireRate = 60. / reload;
-				cout << fireRate << ',';
+				out << fireRate << ',';
 
 				double firingEnergy = outfit.FiringEnergy();
-				cout << firingEnergy << ',';
+				out << firingEnergy << ',';
 				firingEnergy *= fireRate;
 				double firingHeat = outfit.FiringHeat();
-				cout << firingHeat << ',';
+				out << firingHeat << ',';
 				firingHeat *= fireRate;
 				double firingForce = outfit.FiringForce();
-				cout << firingForce << ',';
+				out << firingForce << ',';
 				firingForce *= fireRate;
 
-				cout << firingEnergy << ',';
-				cout << firingHeat << ',';
-				cout << firingForce << ',';
+				out << firingEnergy << ',';
+				out << firingHeat << ',';
+				out << firingForce << ',';
 
 				double shieldDmg = outfit.ShieldDamage() * fireRate;
-				cout << shieldDmg << ',';
+				out << shieldDmg << ',';
 				double dischargeDmg = outfit.DischargeDamage() * 100. * fireRate;
-				cout << dischargeDmg << ',';
+				out << dischargeDmg << ',';
 				double hullDmg = outfit.HullDamage() * fireRate;
-				cout << hullDmg << ',';
+				out << hullDmg << ',';
 				double corrosionDmg = outfit.CorrosionDamage() * 100. * fireRate;
-				cout << corrosionDmg << ',';
+				out << corrosionDmg << ',';
 				double heatDmg = outfit.HeatDamage() * fireRate;
-				cout << heatDmg << ',';
+				out << heatDmg << ',';
 				double burnDmg = outfit.BurnDamage() * 100. * fireRate;
-				cout << burnDmg << ',';
+				out << burnDmg << ',';
 				double energyDmg = outfit.EnergyDamage() * fireRate;
-				cout << energyDmg << ',';
+				out << energyDmg << ',';
 				double ionDmg = outfit.IonDamage() * 100. * fireRate;
-				cout << ionDmg << ',';
+				out << ionDmg << ',';
 				double scramblingDmg = outfit.ScramblingDamage() * 100. * fireRate;
-				cout << scramblingDmg << ',';
+				out << scramblingDmg << ',';
 				double slowDmg = outfit.SlowingDamage() * fireRate;
-				cout << slowDmg << ',';
+				out << slowDmg << ',';
 				double disruptDmg = outfit.DisruptionDamage() * fireRate;
-				cout << disruptDmg << ',';
-				cout << outfit.Piercing() << ',';
+				out << disruptDmg << ',';
+				out << outfit.Piercing() << ',';
 				double fuelDmg = outfit.FuelDamage() * fireRate;
-				cout << fuelDmg << ',';
+				out << fuelDmg << ',';
 				double leakDmg = outfit.LeakDamage() * 100. * fireRate;
-				cout << leakDmg << ',';
+				out << leakDmg << ',';
 				double hitforce = outfit.HitForce() * fireRate;
-				cout << hitforce << ',';
+				out << hitforce << ',';
 
-				cout << outfit.Homing() << ',';
+				out << outfit.Homing() << ',';
 				double strength = outfit.MissileStrength() + outfit.AntiMissile();
-				cout << strength << ',';
+				out << strength << ',';
 
 				double damage = outfit.ShieldDamage() + outfit.HullDamage();
 				double deterrence = .12 * damage / outfit.Reload();
-				cout << deterrence << '\n';
+				out << deterrence << '\n';
 			}
 
-			cout.flush();
+			out.flush();
 		};
 
-		auto PrintEngineStats = []() -> void
+		auto PrintEngineStats = [&out]() -> void
 		{
-			cout << "name" << ',' << "cost" << ',' << "mass" << ',' << "outfit space" << ','
+			out << "name" << ',' << "cost" << ',' << "mass" << ',' << "outfit space" << ','
 				<< "engine capacity" << ',' << "thrust/s" << ',' << "thrust energy/s" << ','
 				<< "thrust heat/s" << ',' << "turn/s" << ',' << "turn energy/s" << ','
 				<< "turn heat/s" << ',' << "reverse thrust/s" << ',' << "reverse energy/s" << ','
@@ -449,32 +461,32 @@ namespace {
 					continue;
 
 				const Outfit &outfit = it.second;
-				cout << '"' << it.first << '"' << ',';
-				cout << outfit.Cost() << ',';
-				cout << outfit.Mass() << ',';
-				cout << outfit.Get("outfit space") << ',';
-				cout << outfit.Get("engine capacity") << ',';
-				cout << outfit.Get("thrust") * 3600. << ',';
-				cout << outfit.Get("thrusting energy") * 60. << ',';
-				cout << outfit.Get("thrusting heat") * 60. << ',';
-				cout << outfit.Get("turn") * 60. << ',';
-				cout << outfit.Get("turning energy") * 60. << ',';
-				cout << outfit.Get("turning heat") * 60. << ',';
-				cout << outfit.Get("reverse thrust") * 3600. << ',';
-				cout << outfit.Get("reverse thrusting energy") * 60. << ',';
-				cout << outfit.Get("reverse thrusting heat") * 60. << ',';
-				cout << outfit.Get("afterburner thrust") * 3600. << ',';
-				cout << outfit.Get("afterburner energy") * 60. << ',';
-				cout << outfit.Get("afterburner heat") * 60. << ',';
-				cout << outfit.Get("afterburner fuel") * 60. << '\n';
+				out << '"' << it.first << '"' << ',';
+				out << outfit.Cost() << ',';
+				out << outfit.Mass() << ',';
+				out << outfit.Get("outfit space") << ',';
+				out << outfit.Get("engine capacity") << ',';
+				out << outfit.Get("thrust") * 3600. << ',';
+				out << outfit.Get("thrusting energy") * 60. << ',';
+				out << outfit.Get("thrusting heat") * 60. << ',';
+				out << outfit.Get("turn") * 60. << ',';
+				out << outfit.Get("turning energy") * 60. << ',';
+				out << outfit.Get("turning heat") * 60. << ',';
+				out << outfit.Get("reverse thrust") * 3600. << ',';
+				out << outfit.Get("reverse thrusting energy") * 60. << ',';
+				out << outfit.Get("reverse thrusting heat") * 60. << ',';
+				out << outfit.Get("afterburner thrust") * 3600. << ',';
+				out << outfit.Get("afterburner energy") * 60. << ',';
+				out << outfit.Get("afterburner heat") * 60. << ',';
+				out << outfit.Get("afterburner fuel") * 60. << '\n';
 			}
 
-			cout.flush();
+			out.flush();
 		};
 
-		auto PrintPowerStats = []() -> void
+		auto PrintPowerStats = [&out]() -> void
 		{
-			cout << "name" << ',' << "cost" << ',' << "mass" << ',' << "outfit space" << ','
+			out << "name" << ',' << "cost" << ',' << "mass" << ',' << "outfit space" << ','
 				<< "energy generation" << ',' << "heat generation" << ',' << "energy capacity" << '\n';
 
 			for(auto &it : GameData::Outfits())
@@ -484,19 +496,19 @@ namespace {
 					continue;
 
 				const Outfit &outfit = it.second;
-				cout << '"' << it.first << '"' << ',';
-				cout << outfit.Cost() << ',';
-				cout << outfit.Mass() << ',';
-				cout << outfit.Get("outfit space") << ',';
-				cout << outfit.Get("energy generation") << ',';
-				cout << outfit.Get("heat generation") << ',';
-				cout << outfit.Get("energy capacity") << '\n';
+				out << '"' << it.first << '"' << ',';
+				out << outfit.Cost() << ',';
+				out << outfit.Mass() << ',';
+				out << outfit.Get("outfit space") << ',';
+				out << outfit.Get("energy generation") << ',';
+				out << outfit.Get("heat generation") << ',';
+				out << outfit.Get("energy capacity") << '\n';
 			}
 
-			cout.flush();
+			out.flush();
 		};
 
-		auto PrintOutfitsAllStats = []() -> void
+		auto PrintOutfitsAllStats = [&out]() -> void
 		{
 			set<string> attributes;
 			for(auto &it : GameData::Outfits())
@@ -506,21 +518,21 @@ namespace {
 					attributes.insert(attribute.first);
 			}
 
-			cout << "name" << ',' << "category" << ',' << "cost" << ',' << "mass";
+			out << "name" << ',' << "category" << ',' << "cost" << ',' << "mass";
 			for(const auto &attribute : attributes)
-				cout << ',' << '"' << attribute << '"';
-			cout << '\n';
+				out << ',' << '"' << attribute << '"';
+			out << '\n';
 
 			for(auto &it : GameData::Outfits())
 			{
 				const Outfit &outfit = it.second;
-				cout << '"' << outfit.TrueName() << '"' << ',';
-				cout << '"' << outfit.Category() << '"' << ',';
-				cout << outfit.Cost() << ',';
-				cout << outfit.Mass();
+				out << '"' << outfit.TrueName() << '"' << ',';
+				out << '"' << outfit.Category() << '"' << ',';
+				out << outfit.Cost() << ',';
+				out << outfit.Mass();
 				for(const auto &attribute : attributes)
-					cout << ',' << outfit.Attributes().Get(attribute);
-				cout << '\n';
+					out << ',' << outfit.Attributes().Get(attribute);
+				out << '\n';
 			}
 		};
 
@@ -552,14 +564,14 @@ namespace {
 		else if(power)
 			PrintPowerStats();
 		else if(sales)
-			PrintItemSales(GameData::Outfits(), GameData::Outfitters(), "outfit", "outfitters");
+			PrintItemSales(out, GameData::Outfits(), GameData::Outfitters(), "outfit", "outfitters");
 		else if(all)
 			PrintOutfitsAllStats();
 		else
-			PrintObjectList(GameData::Outfits(), true, "outfit");
+			PrintObjectList(out, GameData::Outfits(), true, "outfit");
 	}
 
-	void Sales(const char *const *argv)
+	void Sales(const char *const *argv, ostream &out)
 	{
 		bool ships = false;
 		bool outfits = false;
@@ -579,23 +591,23 @@ namespace {
 			outfits = true;
 		}
 		if(ships)
-			PrintSales(GameData::Shipyards(), "shipyards", "ships");
+			PrintSales(out, GameData::Shipyards(), "shipyards", "ships");
 		if(outfits)
-			PrintSales(GameData::Outfitters(), "outfitters", "outfits");
+			PrintSales(out, GameData::Outfitters(), "outfitters", "outfits");
 	}
 
 
-	void Planets(const char *const *argv)
+	void Planets(const char *const *argv, ostream &out)
 	{
-		auto PrintPlanetDescriptions = []() -> void
+		auto PrintPlanetDescriptions = [&out]() -> void
 		{
-			cout << "planet::description::spaceport\n";
+			out << "planet::description::spaceport\n";
 			for(auto &it : GameData::Planets())
 			{
-				cout << it.first << "::";
+				out << it.first << "::";
 				const Planet &planet = it.second;
-				cout << planet.Description() << "::";
-				cout << planet.SpaceportDescription() << "\n";
+				out << planet.Description() << "::";
+				out << planet.SpaceportDescription() << "\n";
 			}
 		};
 
@@ -616,14 +628,14 @@ namespace {
 		if(descriptions)
 			PrintPlanetDescriptions();
 		if(attributes && byAttribute)
-			PrintObjectsByAttribute(GameData::Planets(), "planets");
+			PrintObjectsByAttribute(out, GameData::Planets(), "planets");
 		else if(attributes)
-			PrintObjectAttributes(GameData::Planets(), "planet");
+			PrintObjectAttributes(out, GameData::Planets(), "planet");
 		if(!(descriptions || attributes))
-			PrintObjectList(GameData::Planets(), false, "planet");
+			PrintObjectList(out, GameData::Planets(), false, "planet");
 	}
 
-	void Systems(const char *const *argv)
+	void Systems(const char *const *argv, ostream &out)
 	{
 		bool attributes = false;
 		bool byAttribute = false;
@@ -637,14 +649,14 @@ namespace {
 				byAttribute = true;
 		}
 		if(attributes && byAttribute)
-			PrintObjectsByAttribute(GameData::Systems(), "systems");
+			PrintObjectsByAttribute(out, GameData::Systems(), "systems");
 		else if(attributes)
-			PrintObjectAttributes(GameData::Systems(), "system");
+			PrintObjectAttributes(out, GameData::Systems(), "system");
 		else
-			PrintObjectList(GameData::Systems(), false, "system");
+			PrintObjectList(out, GameData::Systems(), false, "system");
 	}
 
-	void LocationFilterMatches(const char *const *argv)
+	void LocationFilterMatches(const char *const *argv, ostream &out)
 	{
 		DataFile file(cin);
 		LocationFilter filter;
@@ -666,14 +678,127 @@ namespace {
 			}
 		}
 
-		cout << "Systems matching provided location filter:\n";
+		out << "Systems matching provided location filter:\n";
 		for(const auto &it : GameData::Systems())
 			if(filter.Matches(&it.second))
-				cout << it.first << '\n';
-		cout << "Planets matching provided location filter:\n";
+				out << it.first << '\n';
+		out << "Planets matching provided location filter:\n";
 		for(const auto &it : GameData::Planets())
 			if(filter.Matches(&it.second))
-				cout << it.first << '\n';
+				out << it.first << '\n';
+	}
+
+
+	// Write a table of the "--export" file (see ColumnWriter). Its first
+	// columns are the given ones, and the rest are every attribute that any of
+	// the rows has, in alphabetical order. A row that does not have an
+	// attribute stores 0. An attribute with the same name as one of the given
+	// columns is stored as "attribute: " followed by its name instead, so that
+	// the column names stay unique.
+	template <class Type>
+	void WriteTable(ColumnWriter &writer, const string &name, const vector<const Type *> &rows,
+		const vector<pair<string, vector<string>>> &textColumns,
+		const vector<pair<string, vector<double>>> &numberColumns,
+		const Dictionary &(*attributes)(const Type &))
+	{
+		set<string> fixedNames;
+		for(const auto &it : textColumns)
+			fixedNames.insert(it.first);
+		for(const auto &it : numberColumns)
+			fixedNames.insert(it.first);
+
+		// Find every attribute that any of the rows has, filling in the values
+		// for each row as it goes.
+		map<string, vector<double>> attributeColumns;
+		for(size_t row = 0; row < rows.size(); ++row)
+			for(const auto &it : attributes(*rows[row]))
+			{
+				string column = it.first;
+				if(fixedNames.count(column))
+					column = "attribute: " + column;
+				vector<double> &values = attributeColumns[column];
+				values.resize(rows.size());
+				values[row] = it.second;
+			}
+
+		writer.BeginTable(name, rows.size(), textColumns.size() + numberColumns.size() + attributeColumns.size());
+		for(const auto &it : textColumns)
+			writer.WriteColumn(it.first, it.second);
+		for(const auto &it : numberColumns)
+			writer.WriteColumn(it.first, it.second);
+		for(const auto &it : attributeColumns)
+			writer.WriteColumn(it.first, it.second);
+	}
+
+
+	const Dictionary &ShipAttributes(const Ship &ship)
+	{
+		return ship.BaseAttributes().Attributes();
+	}
+
+
+	const Dictionary &OutfitAttributes(const Outfit &outfit)
+	{
+		return outfit.Attributes();
+	}
+
+
+	// Write every ship model and outfit, with all their attributes, to the file
+	// given after "--export".
+	void Export(const char *const *argv, ostream &out)
+	{
+		string path;
+		for(const char *const *it = argv + 1; *it; ++it)
+			if(string(*it) == "--export" && it[1])
+				path = it[1];
+		if(path.empty())
+		{
+			out << "--export needs the path of the file to write.\n";
+			return;
+		}
+
+		vector<const Ship *> ships;
+		vector<pair<string, vector<string>>> shipText = {{"model", {}}, {"category", {}}};
+		vector<pair<string, vector<double>>> shipNumbers = {{"chassis cost", {}}, {"loaded cost", {}}};
+		for(const auto &it : GameData::Ships())
+		{
+			// Skip variants and unnamed / partially-defined ships.
+			if(it.second.TrueModelName() != it.first)
+				continue;
+
+			const Ship &ship = it.second;
+			ships.push_back(&ship);
+			shipText[0].second.push_back(it.first);
+			shipText[1].second.push_back(ship.BaseAttributes().Category());
+			shipNumbers[0].second.push_back(ship.ChassisCost());
+			shipNumbers[1].second.push_back(ship.Cost());
+		}
+
+		vector<const Outfit *> outfits;
+		vector<pair<string, vector<string>>> outfitText = {{"name", {}}, {"category", {}}};
+		vector<pair<string, vector<double>>> outfitNumbers = {{"cost", {}}};
+		for(const auto &it : GameData::Outfits())
+		{
+			if(it.second.TrueName() != it.first)
+				continue;
+
+			const Outfit &outfit = it.second;
+			outfits.push_back(&outfit);
+			outfitText[0].second.push_back(it.first);
+			outfitText[1].second.push_back(outfit.Category());
+			outfitNumbers[0].second.push_back(outfit.Cost());
+		}
+
+		ColumnWriter writer(2);
+		WriteTable(writer, "ships", ships, shipText, shipNumbers, &ShipAttributes);
+		WriteTable(writer, "outfits", outfits, outfitText, outfitNumbers, &OutfitAttributes);
+		if(!Files::Write(path, writer.Data()))
+		{
+			out << "Unable to write \"" << path << "\".\n";
+			return;
+		}
+
+		out << "Wrote " << ships.size() << " ships and " << outfits.size() << " outfits to \"" << path << "\".\n";
 	}
 
 
@@ -693,8 +818,190 @@ namespace {
 		"--sales",
 		"--planets",
 		"--systems",
-		"--matches"
+		"--matches",
+		"--export",
+		"--serve"
 	};
+
+	// In "--serve" mode, the answer to each query is followed by a line
+	// holding only this character (the ASCII record separator).
+	const char END_OF_ANSWER = '\x1e';
+
+
+	// Print whatever the given arguments ask for.
+	void Query(const char *const *argv, ostream &out)
+	{
+		for(const char *const *it = argv + 1; *it; ++it)
+		{
+			string arg = *it;
+			if(arg == "-s" || arg == "--ships")
+			{
+				Ships(argv, out);
+				break;
+			}
+			else if(OUTFIT_ARGS.count(arg))
+			{
+				Outfits(argv, out);
+				break;
+			}
+			else if(arg == "--sales")
+			{
+				Sales(argv, out);
+				break;
+			}
+			else if(arg == "--planets")
+				Planets(argv, out);
+			else if(arg == "--systems")
+				Systems(argv, out);
+			else if(arg == "--matches")
+				LocationFilterMatches(argv, out);
+			else if(arg == "--export")
+			{
+				Export(argv, out);
+				break;
+			}
+		}
+	}
+
+
+	// Class that answers queries on a pool of worker threads, and writes the
+	// answers to STDOUT in the same order as the queries were received.
+	class QueryServer {
+	public:
+		QueryServer();
+		// Wait for every query to be answered and written.
+		~QueryServer();
+
+		// Answer the query with the given arguments, which are the same as they
+		// would be on the command line.
+		void Add(const vector<string> &args);
+
+
+	private:
+		void Work();
+		void Write();
+
+
+	private:
+		mutex queueMutex;
+		condition_variable queueCondition;
+		deque<packaged_task<string()>> toAnswer;
+		deque<future<string>> toWrite;
+		bool isDone = false;
+
+		vector<thread> workers;
+		thread writer;
+	};
+
+
+	QueryServer::QueryServer()
+	{
+		workers.resize(max(1u, thread::hardware_concurrency()));
+		for(thread &worker : workers)
+			worker = thread(&QueryServer::Work, this);
+		writer = thread(&QueryServer::Write, this);
+	}
+
+
+	QueryServer::~QueryServer()
+	{
+		{
+			lock_guard<mutex> lock(queueMutex);
+			isDone = true;
+		}
+		queueCondition.notify_all();
+		for(thread &worker : workers)
+			worker.join();
+		writer.join();
+	}
+
+
+	void QueryServer::Add(const vector<string> &args)
+	{
+		packaged_task<string()> task([args]() -> string
+		{
+			ostringstream out;
+			// The location filter for "--matches" is read from STDIN, which is
+			// where the queries come from, and applying it changes the game data.
+			if(find(args.begin(), args.end(), "--matches") != args.end())
+				out << "--matches cannot be used with --serve.\n";
+			else
+			{
+				vector<const char *> argv(1, "--serve");
+				for(const string &arg : args)
+					argv.push_back(arg.c_str());
+				argv.push_back(nullptr);
+				Query(argv.data(), out);
+			}
+			return out.str();
+		});
+		{
+			lock_guard<mutex> lock(queueMutex);
+			toWrite.push_back(task.get_future());
+			toAnswer.push_back(std::move(task));
+		}
+		queueCondition.notify_all();
+	}
+
+
+	void QueryServer::Work()
+	{
+		while(true)
+		{
+			packaged_task<string()> task;
+			{
+				unique_lock<mutex> lock(queueMutex);
+				queueCondition.wait(lock, [this] { return isDone || !toAnswer.empty(); });
+				if(toAnswer.empty())
+					return;
+				task = std::move(toAnswer.front());
+				toAnswer.pop_front();
+			}
+			task();
+		}
+	}
+
+
+	void QueryServer::Write()
+	{
+		while(true)
+		{
+			future<string> answer;
+			{
+				unique_lock<mutex> lock(queueMutex);
+				queueCondition.wait(lock, [this] { return isDone || !toWrite.empty(); });
+				if(toWrite.empty())
+					return;
+				answer = std::move(toWrite.front());
+				toWrite.pop_front();
+			}
+			cout << answer.get() << END_OF_ANSWER << endl;
+		}
+	}
+
+
+	// Read queries from STDIN, one per line, until the end of the input.
+	void Serve()
+	{
+		// Some weapon stats are only calculated the first time they are needed.
+		// Calculate them now, so that the queries only read the game data and
+		// can safely be answered at the same time.
+		for(const auto &it : GameData::Outfits())
+		{
+			it.second.TotalLifetime();
+			it.second.DoesDamage();
+		}
+
+		QueryServer server;
+		string line;
+		while(getline(cin, line))
+		{
+			istringstream in(line);
+			vector<string> args{istream_iterator<string>(in), istream_iterator<string>()};
+			if(!args.empty())
+				server.Add(args);
+		}
+	}
 }
 
 
@@ -715,30 +1022,13 @@ bool PrintData::IsPrintDataArgument(const char *const *argv)
 void PrintData::Print(const char *const *argv)
 {
 	for(const char *const *it = argv + 1; *it; ++it)
-	{
-		string arg = *it;
-		if(arg == "-s" || arg == "--ships")
+		if(string(*it) == "--serve")
 		{
-			Ships(argv);
-			break;
+			Serve();
+			return;
 		}
-		else if(OUTFIT_ARGS.count(arg))
-		{
-			Outfits(argv);
-			break;
-		}
-		else if(arg == "--sales")
-		{
-			Sales(argv);
-			break;
-		}
-		else if(arg == "--planets")
-			Planets(argv);
-		else if(arg == "--systems")
-			Systems(argv);
-		else if(arg == "--matches")
-			LocationFilterMatches(argv);
-	}
+
+	Query(argv, cout);
 	cout.flush();
 }
 
@@ -775,4 +1065,10 @@ void PrintData::Help()
 	cerr << "    --matches: prints a list of all planets and systems matching a location filter passed in STDIN."
 			<< endl;
 	cerr << "        The first node of the location filter should be `location`." << endl;
+	cerr << "    --export <path>: writes every ship and outfit, with all their attributes, to a columnar binary file."
+			<< endl;
+	cerr << "        The format of the file is described in source/PrintData.cpp." << endl;
+	cerr << "    --serve: reads queries from STDIN, one per line, using any of the above options except --matches."
+			<< endl;
+	cerr << "        Each answer is followed by a line holding only an ASCII record separator (0x1E)." << endl;
 }
@@ -24,6 +24,19 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 using namespace std;
 
+namespace {
+	const ColorRef RADAR_ANOMALOUS_COLOR("radar anomalous");
+	const ColorRef RADAR_BLINK_COLOR("radar blink");
+	const ColorRef RADAR_FRIENDLY_COLOR("radar friendly");
+	const ColorRef RADAR_HOSTILE_COLOR("radar hostile");
+	const ColorRef RADAR_INACTIVE_COLOR("radar inactive");
+	const ColorRef RADAR_PLAYER_COLOR("radar player");
+	const ColorRef RADAR_SPECIAL_COLOR("radar special");
+	const ColorRef RADAR_STAR_COLOR("radar star");
+	const ColorRef RADAR_UNFRIENDLY_COLOR("radar unfriendly");
+	const ColorRef RADAR_VIEWPORT_COLOR("radar viewport");
+}
+
 const int Radar::PLAYER = 0;
 const int Radar::FRIENDLY = 1;
 const int Radar::UNFRIENDLY = 2;
@@ -137,16 +150,16 @@ void Radar::Draw(const Point &center, double scale, double radius, double pointe
 const Color &Radar::GetColor(int type)
 {
 	static const vector<Color> color = {
-		*GameData::Colors().Get("radar player"),
-		*GameData::Colors().Get("radar friendly"),
-		*GameData::Colors().Get("radar unfriendly"),
-		*GameData::Colors().Get("radar hostile"),
-		*GameData::Colors().Get("radar inactive"),
-		*GameData::Colors().Get("radar special"),
-		*GameData::Colors().Get("radar anomalous"),
-		*GameData::Colors().Get("radar blink"),
-		*GameData::Colors().Get("radar viewport"),
-		*GameData::Colors().Get("radar star")
+		*RADAR_PLAYER_COLOR,
+		*RADAR_FRIENDLY_COLOR,
+		*RADAR_UNFRIENDLY_COLOR,
+		*RADAR_HOSTILE_COLOR,
+		*RADAR_INACTIVE_COLOR,
+		*RADAR_SPECIAL_COLOR,
+		*RADAR_ANOMALOUS_COLOR,
+		*RADAR_BLINK_COLOR,
+		*RADAR_VIEWPORT_COLOR,
+		*RADAR_STAR_COLOR
 	};
 
 	if(static_cast<size_t>(type) >= color.size())
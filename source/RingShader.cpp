@@ -205,6 +205,7 @@ void RingShader::Add(const Point &pos, float radius, float width, float fraction
 	glUniform4fv(colorI, 1, color.Get());
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	OpenGL::CountDrawCall();
 }
 
 
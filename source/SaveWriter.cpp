@@ -0,0 +1,158 @@
+/* SaveWriter.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "SaveWriter.h"
+
+#include "Files.h"
+#include "GzipFile.h"
+#include "Logger.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+using namespace std;
+
+namespace {
+	// The worker thread is started when the first job is added. When the game
+	// exits, it finishes any jobs that are left before it is destroyed, so that
+	// the last save is never lost.
+	class Worker {
+	public:
+		~Worker();
+
+		void Add(function<void()> &&job);
+		void Wait();
+
+
+	private:
+		void Run();
+
+
+	private:
+		queue<function<void()>> jobs;
+		// Whether a job has been taken from the queue but is not done yet.
+		bool isBusy = false;
+		bool isQuitting = false;
+		mutex jobMutex;
+		condition_variable jobCondition;
+		condition_variable doneCondition;
+		thread workerThread;
+	};
+
+	Worker worker;
+
+
+
+	Worker::~Worker()
+	{
+		{
+			lock_guard<mutex> lock(jobMutex);
+			isQuitting = true;
+		}
+		jobCondition.notify_one();
+		if(workerThread.joinable())
+			workerThread.join();
+	}
+
+
+
+	void Worker::Add(function<void()> &&job)
+	{
+		{
+			lock_guard<mutex> lock(jobMutex);
+			jobs.push(std::move(job));
+			if(!workerThread.joinable())
+				workerThread = thread(&Worker::Run, this);
+		}
+		jobCondition.notify_one();
+	}
+
+
+
+	void Worker::Wait()
+	{
+		unique_lock<mutex> lock(jobMutex);
+		while(isBusy || !jobs.empty())
+			doneCondition.wait(lock);
+	}
+
+
+
+	void Worker::Run()
+	{
+		unique_lock<mutex> lock(jobMutex);
+		while(true)
+		{
+			// Only quit once every job has been done.
+			while(jobs.empty() && !isQuitting)
+				jobCondition.wait(lock);
+			if(jobs.empty())
+				break;
+
+			function<void()> job = std::move(jobs.front());
+			jobs.pop();
+			isBusy = true;
+			lock.unlock();
+
+			job();
+
+			lock.lock();
+			isBusy = false;
+			doneCondition.notify_all();
+		}
+	}
+}
+
+
+
+// Add a job to be done in the background.
+void SaveWriter::Add(function<void()> job)
+{
+	worker.Add(std::move(job));
+}
+
+
+
+// Wait until all the jobs that have been added are done. This must be called
+// before reading any file that a job may still be writing.
+void SaveWriter::Wait()
+{
+	worker.Wait();
+}
+
+
+
+// Replace the given file with the given data, compressing it if requested.
+// The data is written to a temporary file which is then renamed, so the file
+// is never left partly written. This writes the file immediately, so it is
+// meant for use in jobs. Return false if the old file had to be kept.
+bool SaveWriter::Write(const string &path, const string &data, bool compress)
+{
+	const string temporary = path + ".tmp";
+	bool written = (compress ? GzipFile::Write(temporary, data) : Files::Write(temporary, data));
+	// The new file must be on the disk before it replaces the old one, or a
+	// crash right after the rename could still leave an empty file behind.
+	if(!written || !Files::Sync(temporary))
+	{
+		// Keep the old file rather than replacing it with a broken one.
+		Logger::LogError("Error: Unable to write \"" + path + "\". The previous version has been kept.");
+		Files::Delete(temporary);
+		return false;
+	}
+	Files::Move(temporary, path);
+	return true;
+}
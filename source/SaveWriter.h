@@ -0,0 +1,45 @@
+/* SaveWriter.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SAVE_WRITER_H_
+#define SAVE_WRITER_H_
+
+#include <functional>
+#include <string>
+
+
+
+// Class that writes saved games to disk in a background thread, so that the
+// game does not stall while a large save is written. The contents of the save
+// must be composed in memory before a job is added; the job itself should only
+// do file I/O. Jobs are done one at a time, in the order they were added.
+class SaveWriter {
+public:
+	// Add a job to be done in the background.
+	static void Add(std::function<void()> job);
+	// Wait until all the jobs that have been added are done. This must be called
+	// before reading any file that a job may still be writing.
+	static void Wait();
+
+	// Replace the given file with the given data, compressing it if requested.
+	// The data is written to a temporary file which is then renamed, so the file
+	// is never left partly written. This writes the file immediately, so it is
+	// meant for use in jobs. Return false if the old file had to be kept.
+	static bool Write(const std::string &path, const std::string &data, bool compress = false);
+};
+
+
+
+#endif
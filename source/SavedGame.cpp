@@ -17,12 +17,40 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DataFile.h"
 #include "DataNode.h"
+#include "DataStream.h"
+#include "DataWriter.h"
 #include "Date.h"
+#include "Files.h"
 #include "text/Format.h"
+#include "SaveWriter.h"
 #include "SpriteSet.h"
 
+#include <ctime>
+#include <map>
+#include <mutex>
+
 using namespace std;
 
+namespace {
+	// An entry in the index is only used if the file still has the same
+	// modification time and size as when the entry was made.
+	struct IndexEntry {
+		time_t timestamp;
+		size_t size;
+		SavedGame summary;
+	};
+
+	mutex indexMutex;
+	map<string, IndexEntry> indexEntries;
+	bool indexIsLoaded = false;
+	bool indexIsChanged = false;
+
+	string IndexPath()
+	{
+		return Files::Config() + "saves index.txt";
+	}
+}
+
 
 
 SavedGame::SavedGame(const string &path)
@@ -32,50 +60,82 @@ SavedGame::SavedGame(const string &path)
 
 
 
+// Read only the date of the saved game in the given file. This stops reading
+// as soon as the date is found, so it takes the same time for any size of
+// saved game, and it does not use any game data.
+string SavedGame::ReadDate(const string &path)
+{
+	// The date is the second line of a saved game.
+	DataStream stream(path);
+	while(stream.Next())
+	{
+		const DataNode &node = stream.Node();
+		if(node.Token(0) == "date" && node.Size() >= 4)
+			return Date(node.Value(1), node.Value(2), node.Value(3)).ToString();
+	}
+	return "";
+}
+
+
+
+// Add the saved game that was just written to the given path, with the
+// given contents, to the index. This does not use any game data.
+void SavedGame::AddToIndex(const string &path, const string &contents)
+{
+	SavedGame summary;
+	DataStream stream(contents.data(), contents.size());
+	if(!summary.Read(stream))
+		return;
+	summary.path = path;
+
+	{
+		lock_guard<mutex> lock(indexMutex);
+		LoadIndex();
+		indexEntries[path] = IndexEntry{Files::Timestamp(path), Files::Size(path), summary};
+		indexIsChanged = true;
+	}
+	SaveIndex();
+}
+
+
+
 void SavedGame::Load(const string &path)
 {
 	Clear();
-	DataFile file(path);
-	if(file.begin() != file.end())
-		this->path = path;
-
-	int flagshipIterator = -1;
-	int flagshipTarget = 0;
+	if(!Files::Exists(path))
+		return;
+
+	// If this file has not changed since it was added to the index, there is
+	// no need to read it.
+	const time_t timestamp = Files::Timestamp(path);
+	const size_t size = Files::Size(path);
+	bool isIndexed = false;
+	{
+		lock_guard<mutex> lock(indexMutex);
+		LoadIndex();
+		auto it = indexEntries.find(path);
+		isIndexed = (it != indexEntries.end() && it->second.timestamp == timestamp && it->second.size == size);
+		if(isIndexed)
+			*this = it->second.summary;
+	}
 
-	for(const DataNode &node : file)
+	if(!isIndexed)
 	{
-		if(node.Token(0) == "pilot" && node.Size() >= 3)
-			name = node.Token(1) + " " + node.Token(2);
-		else if(node.Token(0) == "date" && node.Size() >= 4)
-			date = Date(node.Value(1), node.Value(2), node.Value(3)).ToString();
-		else if(node.Token(0) == "system" && node.Size() >= 2)
-			system = node.Token(1);
-		else if(node.Token(0) == "planet" && node.Size() >= 2)
-			planet = node.Token(1);
-		else if(node.Token(0) == "playtime" && node.Size() >= 2)
-			playTime = Format::PlayTime(node.Value(1));
-		else if(node.Token(0) == "flagship index" && node.Size() >= 2)
-			flagshipTarget = node.Value(1);
-		else if(node.Token(0) == "account")
-		{
-			for(const DataNode &child : node)
-				if(child.Token(0) == "credits" && child.Size() >= 2)
-				{
-					credits = Format::Credits(child.Value(1));
-					break;
-				}
-		}
-		else if(node.Token(0) == "ship" && ++flagshipIterator == flagshipTarget)
+		DataStream stream(path);
+		if(!Read(stream))
+			return;
+		this->path = path;
+
 		{
-			for(const DataNode &child : node)
-			{
-				if(child.Token(0) == "name" && child.Size() >= 2)
-					shipName = child.Token(1);
-				else if(child.Token(0) == "sprite" && child.Size() >= 2)
-					shipSprite = SpriteSet::Get(child.Token(1));
-			}
+			lock_guard<mutex> lock(indexMutex);
+			indexEntries[path] = IndexEntry{timestamp, size, *this};
+			indexIsChanged = true;
 		}
+		SaveWriter::Add(&SavedGame::SaveIndex);
 	}
+
+	if(!shipSpriteName.empty())
+		shipSprite = SpriteSet::Get(shipSpriteName);
 }
 
 
@@ -106,6 +166,7 @@ void SavedGame::Clear()
 	planet.clear();
 	playTime = "0s";
 
+	shipSpriteName.clear();
 	shipSprite = nullptr;
 	shipName.clear();
 }
@@ -165,3 +226,170 @@ const string &SavedGame::ShipName() const
 {
 	return shipName;
 }
+
+
+
+// Read the information from a saved game, stopping as soon as all of it
+// has been found. Return false if the saved game is empty.
+bool SavedGame::Read(DataStream &stream)
+{
+	bool hasData = false;
+	int flagshipIterator = -1;
+	int flagshipTarget = 0;
+
+	while(true)
+	{
+		// Out of all the ships, only the flagship is shown, so there is no need
+		// to parse any of the others.
+		if(flagshipIterator + 1 != flagshipTarget && stream.Skip("ship"))
+		{
+			++flagshipIterator;
+			hasData = true;
+			continue;
+		}
+		if(!stream.Next())
+			break;
+
+		const DataNode &node = stream.Node();
+		hasData = true;
+		if(node.Token(0) == "pilot" && node.Size() >= 3)
+			name = node.Token(1) + " " + node.Token(2);
+		else if(node.Token(0) == "date" && node.Size() >= 4)
+			date = Date(node.Value(1), node.Value(2), node.Value(3)).ToString();
+		else if(node.Token(0) == "system" && node.Size() >= 2)
+			system = node.Token(1);
+		else if(node.Token(0) == "planet" && node.Size() >= 2)
+			planet = node.Token(1);
+		else if(node.Token(0) == "playtime" && node.Size() >= 2)
+			playTime = Format::PlayTime(node.Value(1));
+		else if(node.Token(0) == "flagship index" && node.Size() >= 2)
+			flagshipTarget = node.Value(1);
+		else if(node.Token(0) == "ship")
+		{
+			++flagshipIterator;
+			for(const DataNode &child : node)
+			{
+				if(child.Token(0) == "name" && child.Size() >= 2)
+					shipName = child.Token(1);
+				else if(child.Token(0) == "sprite" && child.Size() >= 2)
+					shipSpriteName = child.Token(1);
+			}
+		}
+		else if(node.Token(0) == "account")
+		{
+			for(const DataNode &child : node)
+				if(child.Token(0) == "credits" && child.Size() >= 2)
+				{
+					credits = Format::Credits(child.Value(1));
+					break;
+				}
+			// The account comes after everything else that is shown, including
+			// the ships, so the rest of the file does not need to be read.
+			return true;
+		}
+	}
+	return hasData;
+}
+
+
+
+// Read or write this information as an entry in the index.
+void SavedGame::LoadEntry(const DataNode &node)
+{
+	for(const DataNode &child : node)
+	{
+		if(child.Size() < 2)
+			continue;
+
+		const string &key = child.Token(0);
+		const string &value = child.Token(1);
+		if(key == "name")
+			name = value;
+		else if(key == "credits")
+			credits = value;
+		else if(key == "date")
+			date = value;
+		else if(key == "system")
+			system = value;
+		else if(key == "planet")
+			planet = value;
+		else if(key == "playtime")
+			playTime = value;
+		else if(key == "ship" && child.Size() >= 3)
+		{
+			shipName = value;
+			shipSpriteName = child.Token(2);
+		}
+	}
+}
+
+
+
+void SavedGame::SaveEntry(DataWriter &out) const
+{
+	out.Write("name", name);
+	out.Write("credits", credits);
+	out.Write("date", date);
+	out.Write("system", system);
+	out.Write("planet", planet);
+	out.Write("playtime", playTime);
+	if(!shipSpriteName.empty())
+		out.Write("ship", shipName, shipSpriteName);
+}
+
+
+
+// Read the index, if it has not been read yet. The index mutex must be held
+// when calling this.
+void SavedGame::LoadIndex()
+{
+	if(indexIsLoaded)
+		return;
+	indexIsLoaded = true;
+
+	DataFile file(IndexPath());
+	for(const DataNode &node : file)
+		if(node.Token(0) == "save" && node.Size() >= 4)
+		{
+			IndexEntry &entry = indexEntries[node.Token(1)];
+			entry.timestamp = node.Value(2);
+			entry.size = node.Value(3);
+			entry.summary.Clear();
+			entry.summary.path = node.Token(1);
+			entry.summary.LoadEntry(node);
+		}
+}
+
+
+
+// Write the index, if it has changed. This should be done by the save writer.
+void SavedGame::SaveIndex()
+{
+	DataWriter out;
+	{
+		lock_guard<mutex> lock(indexMutex);
+		if(!indexIsChanged)
+			return;
+		indexIsChanged = false;
+
+		// Forget about any saved games that have been deleted.
+		for(auto it = indexEntries.begin(); it != indexEntries.end(); )
+		{
+			if(Files::Exists(it->first))
+				++it;
+			else
+				it = indexEntries.erase(it);
+		}
+
+		for(const auto &it : indexEntries)
+		{
+			out.Write("save", it.first, it.second.timestamp, it.second.size);
+			out.BeginChild();
+			{
+				it.second.summary.SaveEntry(out);
+			}
+			out.EndChild();
+		}
+	}
+	SaveWriter::Write(IndexPath(), out.GetString());
+}
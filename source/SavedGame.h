@@ -18,6 +18,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <string>
 
+class DataNode;
+class DataStream;
+class DataWriter;
 class Sprite;
 
 
@@ -26,12 +29,22 @@ class Sprite;
 // information necessary from the file to display it in the "Load Game" panel,
 // without doing all the complicated parsing that PlayerInfo does. This is so
 // that we only need to have one PlayerInfo instance, and there does not need
-// to be logic for copying one PlayerInfo into another.
+// to be logic for copying one PlayerInfo into another. That information is
+// also kept in an index, which is updated whenever the player is saved, so
+// that most saved games never need to be read at all.
 class SavedGame {
 public:
 	SavedGame() = default;
 	explicit SavedGame(const std::string &path);
 
+	// Read only the date of the saved game in the given file. This stops reading
+	// as soon as the date is found, so it takes the same time for any size of
+	// saved game, and it does not use any game data.
+	static std::string ReadDate(const std::string &path);
+	// Add the saved game that was just written to the given path, with the
+	// given contents, to the index. This does not use any game data.
+	static void AddToIndex(const std::string &path, const std::string &contents);
+
 	void Load(const std::string &path);
 	const std::string &Path() const;
 	bool IsLoaded() const;
@@ -49,6 +62,20 @@ public:
 	const std::string &ShipName() const;
 
 
+private:
+	// Read the information from a saved game, stopping as soon as all of it
+	// has been found. Return false if the saved game is empty.
+	bool Read(DataStream &stream);
+	// Read or write this information as an entry in the index.
+	void LoadEntry(const DataNode &node);
+	void SaveEntry(DataWriter &out) const;
+	// Read the index, if it has not been read yet. The index mutex must be held
+	// when calling this.
+	static void LoadIndex();
+	// Write the index, if it has changed. This should be done by the save writer.
+	static void SaveIndex();
+
+
 private:
 	std::string path;
 
@@ -60,6 +87,9 @@ private:
 	std::string planet;
 	std::string playTime;
 
+	// The sprite is looked up by name when the saved game is loaded, because
+	// the index may be updated in the save writer's thread.
+	std::string shipSpriteName;
 	const Sprite *shipSprite = nullptr;
 	std::string shipName;
 };
@@ -17,6 +17,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #define SET_H_
 
 #include <map>
+#include <set>
 #include <string>
 
 
@@ -28,8 +29,9 @@ template<class Type>
 class Set {
 public:
 	// Allow non-const access to the owner of this set; it can hand off only
-	// const references to avoid anyone else modifying the objects.
-	Type *Get(const std::string &name) { return &data[name]; }
+	// const references to avoid anyone else modifying the objects. If changes
+	// are being tracked, the object is assumed to have been changed.
+	Type *Get(const std::string &name);
 	const Type *Get(const std::string &name) const { return &data[name]; }
 	// If an item already exists in this set, get it. Otherwise, return a null
 	// pointer rather than creating the item.
@@ -45,17 +47,45 @@ public:
 
 	int size() const { return data.size(); }
 	bool empty() const { return data.empty(); }
+	// From now on, remember which objects are changed through Get(), so that
+	// Revert() only needs to restore those. Changes made while iterating over
+	// the set, or through FindUntracked(), are not tracked.
+	void TrackChanges();
+	// Get an existing object to change without marking it as changed, for
+	// changes that Revert() does not need to undo. Return a null pointer if
+	// the object is not in this set.
+	Type *FindUntracked(const std::string &name);
+	// Check whether any object has been changed since tracking began or since
+	// the last revert.
+	bool HasChanges() const;
 	// Remove any objects in this set that are not in the given set, and for
-	// those that are in the given set, revert to their contents.
-	void Revert(const Set<Type> &other);
+	// those that are in the given set, revert to their contents. If changes are
+	// being tracked, only the objects that were changed are copied, unless
+	// "revertAll" is set.
+	void Revert(const Set<Type> &other, bool revertAll = false);
+	// Remove any objects whose names are not in the given list. Nothing may
+	// still point to the objects that are removed.
+	void Retain(const std::set<std::string> &names);
 
 
 private:
 	mutable std::map<std::string, Type> data;
+	bool isTracking = false;
+	std::set<std::string> changed;
 };
 
 
 
+template <class Type>
+Type *Set<Type>::Get(const std::string &name)
+{
+	if(isTracking)
+		changed.insert(name);
+	return &data[name];
+}
+
+
+
 template <class Type>
 const Type *Set<Type>::Find(const std::string &name) const
 {
@@ -66,8 +96,36 @@ const Type *Set<Type>::Find(const std::string &name) const
 
 
 template <class Type>
-void Set<Type>::Revert(const Set<Type> &other)
+Type *Set<Type>::FindUntracked(const std::string &name)
 {
+	auto it = data.find(name);
+	return (it == data.end() ? nullptr : &it->second);
+}
+
+
+
+template <class Type>
+void Set<Type>::TrackChanges()
+{
+	isTracking = true;
+	changed.clear();
+}
+
+
+
+template <class Type>
+bool Set<Type>::HasChanges() const
+{
+	return !changed.empty();
+}
+
+
+
+template <class Type>
+void Set<Type>::Revert(const Set<Type> &other, bool revertAll)
+{
+	revertAll |= !isTracking;
+
 	auto it = data.begin();
 	auto oit = other.data.begin();
 
@@ -78,8 +136,10 @@ void Set<Type>::Revert(const Set<Type> &other)
 		else if(it->first == oit->first)
 		{
 			// If this is an entry that is in the set we are reverting to, copy
-			// the state we are reverting to.
-			it->second = oit->second;
+			// the state we are reverting to. Copying an object can be expensive,
+			// so skip the ones that are known to be unchanged.
+			if(revertAll || changed.count(it->first))
+				it->second = oit->second;
 			++it;
 			++oit;
 		}
@@ -87,6 +147,21 @@ void Set<Type>::Revert(const Set<Type> &other)
 		// There should never be a case when an entry in the set we are
 		// reverting to has a name that is not also in this set.
 	}
+	changed.clear();
+}
+
+
+
+template <class Type>
+void Set<Type>::Retain(const std::set<std::string> &names)
+{
+	for(auto it = data.begin(); it != data.end(); )
+	{
+		if(names.count(it->first))
+			++it;
+		else
+			it = data.erase(it);
+	}
 }
 
 
@@ -0,0 +1,67 @@
+/* SetRef.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SET_REF_H_
+#define SET_REF_H_
+
+#include "Set.h"
+
+#include <atomic>
+
+
+
+// Template representing a handle to one named object in a Set, for code that
+// uses the same object every frame. The name is only looked up the first time
+// the handle is used; after that, the handle keeps a pointer to the object.
+// Objects in a Set never move, and loading new data (such as a plugin) changes
+// them in place, so the pointer always refers to the current definition. The
+// lookup is deferred because handles are usually declared at namespace scope,
+// before the game data exists.
+template<class Type, const Set<Type> &(*Source)()>
+class SetRef {
+public:
+	explicit constexpr SetRef(const char *name) noexcept : name(name) {}
+	SetRef(const SetRef &) = delete;
+	SetRef &operator=(const SetRef &) = delete;
+
+	const Type &operator*() const { return *Get(); }
+	const Type *operator->() const { return Get(); }
+	operator const Type &() const { return *Get(); }
+	const Type *Get() const;
+
+
+private:
+	const char *name;
+	// Handles may be shared by the main and calculation threads.
+	mutable std::atomic<const Type *> object{nullptr};
+};
+
+
+
+template<class Type, const Set<Type> &(*Source)()>
+const Type *SetRef<Type, Source>::Get() const
+{
+	const Type *result = object.load(std::memory_order_acquire);
+	if(!result)
+	{
+		result = Source().Get(name);
+		object.store(result, std::memory_order_release);
+	}
+	return result;
+}
+
+
+
+#endif
@@ -0,0 +1,56 @@
+/* ShelfPacker.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ShelfPacker.h"
+
+using namespace std;
+
+
+
+ShelfPacker::ShelfPacker(int size, int padding)
+	: size(size), padding(padding)
+{
+}
+
+
+
+// Find room for a rectangle of the given size, and store the position of its
+// top left corner (inside the padding) in x and y. Return false if there is no
+// room left for it.
+bool ShelfPacker::Place(int width, int height, int &x, int &y)
+{
+	width += 2 * padding;
+	height += 2 * padding;
+	if(width > size || height > size)
+		return false;
+
+	// Use the shortest shelf that the rectangle fits in.
+	Shelf *best = nullptr;
+	for(Shelf &shelf : shelves)
+		if(shelf.height >= height && shelf.x + width <= size && (!best || shelf.height < best->height))
+			best = &shelf;
+	if(!best)
+	{
+		if(usedHeight + height > size)
+			return false;
+		shelves.push_back(Shelf{usedHeight, height, 0});
+		usedHeight += height;
+		best = &shelves.back();
+	}
+	x = best->x + padding;
+	y = best->y + padding;
+	best->x += width;
+	return true;
+}
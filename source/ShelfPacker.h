@@ -0,0 +1,57 @@
+/* ShelfPacker.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHELF_PACKER_H_
+#define SHELF_PACKER_H_
+
+#include <vector>
+
+
+
+// Class that finds room for rectangles in a square area, such as one page of a
+// TextureAtlas. Rectangles are placed from left to right in horizontal
+// "shelves", each as tall as the first rectangle that was placed in it. Each
+// rectangle is surrounded by the given amount of padding, which is not shared
+// with its neighbors.
+class ShelfPacker {
+public:
+	ShelfPacker(int size, int padding);
+
+	// Find room for a rectangle of the given size, and store the position of
+	// its top left corner (inside the padding) in x and y. Return false if
+	// there is no room left for it.
+	bool Place(int width, int height, int &x, int &y);
+
+
+private:
+	class Shelf {
+	public:
+		int y;
+		int height;
+		int x;
+	};
+
+
+private:
+	int size;
+	int padding;
+	std::vector<Shelf> shelves;
+	// The height of all the shelves together.
+	int usedHeight = 0;
+};
+
+
+
+#endif
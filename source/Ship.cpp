@@ -54,6 +54,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const PreferenceFlag EXTRA_FLEET_STATUS_MESSAGES("Extra fleet status messages");
+	const PreferenceFlag FIGHTERS_TRANSFER_CARGO("Fighters transfer cargo");
+
 	const string FIGHTER_REPAIR = "Repair fighters in";
 	const vector<string> BAY_SIDE = {"inside", "over", "under"};
 	const vector<string> BAY_FACING = {"forward", "left", "right", "back"};
@@ -2929,7 +2932,7 @@ bool Ship::Carry(const shared_ptr<Ship> &ship)
 
 	// NPC ships should always transfer cargo. Player ships should only
 	// transfer cargo if they set the AI preference.
-	const bool shouldTransferCargo = !IsYours() || Preferences::Has("Fighters transfer cargo");
+	const bool shouldTransferCargo = !IsYours() || FIGHTERS_TRANSFER_CARGO.Has();
 
 	for(Bay &bay : bays)
 		if((bay.category == category) && !bay.ship)
@@ -3455,7 +3458,7 @@ int Ship::StepDestroyed(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flot
 	// Once we've created enough little explosions, die.
 	if(explosionCount == explosionTotal || forget)
 	{
-		if(IsYours() && Preferences::Has("Extra fleet status messages"))
+		if(IsYours() && EXTRA_FLEET_STATUS_MESSAGES.Has())
 			Messages::Add("Your ship \"" + Name() + "\" has been destroyed.", Messages::Importance::Highest);
 
 		if(!forget)
@@ -4160,7 +4163,7 @@ void Ship::StepPilot()
 	else if(requiredCrew && static_cast<int>(Random::Int(requiredCrew)) >= Crew())
 	{
 		pilotError = 30;
-		if(isYours || (personality.IsEscort() && Preferences::Has("Extra fleet status messages")))
+		if(isYours || (personality.IsEscort() && EXTRA_FLEET_STATUS_MESSAGES.Has()))
 		{
 			if(parent.lock())
 				Messages::Add("The " + name + " is moving erratically because there are not enough crew to pilot it."
@@ -47,6 +47,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef FAINT_COLOR("faint");
+	const ColorRef MEDIUM_COLOR("medium");
+
+	const InterfaceRef INFO_PANEL_INTERFACE("info panel");
+
 	constexpr double WIDTH = 250.;
 	constexpr int COLUMN_WIDTH = static_cast<int>(WIDTH) - 20;
 }
@@ -115,7 +121,7 @@ void ShipInfoPanel::Draw()
 		interfaceInfo.SetCondition("enable logbook");
 
 	// Draw the interface.
-	const Interface *infoPanelUi = GameData::Interfaces().Get("info panel");
+	const Interface *infoPanelUi = INFO_PANEL_INTERFACE.Get();
 	infoPanelUi->Draw(interfaceInfo, this);
 
 	// Draw all the different information sections.
@@ -313,8 +319,8 @@ void ShipInfoPanel::DrawShipStats(const Rectangle &bounds)
 		return;
 
 	// Colors to draw with.
-	Color dim = *GameData::Colors().Get("medium");
-	Color bright = *GameData::Colors().Get("bright");
+	Color dim = *MEDIUM_COLOR;
+	Color bright = *BRIGHT_COLOR;
 	const Ship &ship = **shipIt;
 
 	// Two columns of opposite alignment are used to simulate a single visual column.
@@ -338,8 +344,8 @@ void ShipInfoPanel::DrawOutfits(const Rectangle &bounds, Rectangle &cargoBounds)
 		return;
 
 	// Colors to draw with.
-	Color dim = *GameData::Colors().Get("medium");
-	Color bright = *GameData::Colors().Get("bright");
+	Color dim = *MEDIUM_COLOR;
+	Color bright = *BRIGHT_COLOR;
 	const Ship &ship = **shipIt;
 
 	// Two columns of opposite alignment are used to simulate a single visual column.
@@ -407,8 +413,8 @@ void ShipInfoPanel::DrawOutfits(const Rectangle &bounds, Rectangle &cargoBounds)
 void ShipInfoPanel::DrawWeapons(const Rectangle &bounds)
 {
 	// Colors to draw with.
-	Color dim = *GameData::Colors().Get("medium");
-	Color bright = *GameData::Colors().Get("bright");
+	Color dim = *MEDIUM_COLOR;
+	Color bright = *BRIGHT_COLOR;
 	const Font &font = FontSet::Get(14);
 	const Ship &ship = **shipIt;
 
@@ -528,9 +534,9 @@ void ShipInfoPanel::DrawWeapons(const Rectangle &bounds)
 
 void ShipInfoPanel::DrawCargo(const Rectangle &bounds)
 {
-	Color dim = *GameData::Colors().Get("medium");
-	Color bright = *GameData::Colors().Get("bright");
-	Color backColor = *GameData::Colors().Get("faint");
+	Color dim = *MEDIUM_COLOR;
+	Color bright = *BRIGHT_COLOR;
+	Color backColor = *FAINT_COLOR;
 	const Ship &ship = **shipIt;
 
 	// Cargo list.
@@ -46,6 +46,9 @@ class System;
 using namespace std;
 
 namespace {
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef MEDIUM_COLOR("medium");
+
 	// Label for the decription field of the detail pane.
 	const string DESCRIPTION = "description";
 
@@ -67,7 +70,7 @@ namespace {
 			static const string label = "Random";
 			Point labelSize(font.Width(label), font.Height());
 			Point labelPos = randomPos - .5 * labelSize;
-			font.Draw(label, labelPos, *GameData::Colors().Get("medium"));
+			font.Draw(label, labelPos, *MEDIUM_COLOR);
 			AddZone(Rectangle(randomPos, labelSize), [this]() { Click(randomPos.X(), randomPos.Y(), 1); });
 		}
 
@@ -194,7 +197,7 @@ int ShipyardPanel::DrawDetails(const Point &center)
 			}
 			else
 			{
-				const Color &dim = *GameData::Colors().Get("medium");
+				const Color &dim = *MEDIUM_COLOR;
 				font.Draw(DESCRIPTION, startPoint + Point(35., 12.), dim);
 				const Sprite *collapsedArrow = SpriteSet::Get("ui/collapsed");
 				SpriteShader::Draw(collapsedArrow, startPoint + Point(20., 20.));
@@ -217,7 +220,7 @@ int ShipyardPanel::DrawDetails(const Point &center)
 	}
 
 	// Draw this string representing the selected ship (if any), centered in the details side panel
-	const Color &bright = *GameData::Colors().Get("bright");
+	const Color &bright = *BRIGHT_COLOR;
 	const Point selectedPoint(center.X() - INFOBAR_WIDTH / 2, center.Y());
 	font.Draw({selectedItem, {INFOBAR_WIDTH, Alignment::CENTER, Truncate::MIDDLE}},
 		selectedPoint, bright);
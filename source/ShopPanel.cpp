@@ -55,6 +55,22 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef ACTIVE_COLOR("active");
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef DIM_COLOR("dim");
+	const ColorRef HOVER_COLOR("hover");
+	const ColorRef INACTIVE_COLOR("inactive");
+	const ColorRef MEDIUM_COLOR("medium");
+	const ColorRef PANEL_BACKGROUND_COLOR("panel background");
+	const ColorRef PANEL_BACKGROUND_SELECTED_COLOR("panel background selected");
+	const ColorRef SHOP_INFO_PANEL_BACKGROUND_COLOR("shop info panel background");
+	const ColorRef SHOP_INFO_PANEL_BACKGROUND_SELECTED_COLOR("shop info panel background selected");
+	const ColorRef SHOP_MAIN_PANEL_BACKGROUND_COLOR("shop main panel background");
+	const ColorRef SHOP_MAIN_PANEL_BACKGROUND_SELECTED_COLOR("shop main panel background selected");
+	const ColorRef SHOP_SIDE_PANEL_BACKGROUND_COLOR("shop side panel background");
+	const ColorRef SHOP_SIDE_PANEL_BACKGROUND_SELECTED_COLOR("shop side panel background selected");
+	const ColorRef SHOP_SIDE_PANEL_FOOTER_COLOR("shop side panel footer");
+
 	const string SHIP_OUTLINES = "Ship outlines in shops";
 
 	constexpr int ICON_TILE = 62;
@@ -157,7 +173,7 @@ void ShopPanel::Draw()
 		wrap.Wrap(text);
 
 		bool isError = (warningType.back() == '!');
-		const Color &textColor = *GameData::Colors().Get("medium");
+		const Color &textColor = *MEDIUM_COLOR;
 		const Color &backColor = *GameData::Colors().Get(isError ? "error back" : "warning back");
 
 		Point size(WIDTH, wrap.Height() + 2 * PAD);
@@ -226,7 +242,7 @@ void ShopPanel::DrawShip(const Ship &ship, const Point &center, bool isSelected)
 	const string &name = ship.Name().empty() ? ship.DisplayModelName() : ship.Name();
 	Point offset(-SIDEBAR_WIDTH / 2, -.5f * SHIP_SIZE + 10.f);
 	font.Draw({name, {SIDEBAR_WIDTH, Alignment::CENTER, Truncate::MIDDLE}},
-		center + offset, *GameData::Colors().Get("bright"));
+		center + offset, *BRIGHT_COLOR);
 }
 
 
@@ -905,10 +921,10 @@ const Outfit *ShopPanel::Zone::GetOutfit() const
 void ShopPanel::DrawShipsSidebar()
 {
 	const Font &font = FontSet::Get(14);
-	const Color &medium = *GameData::Colors().Get("medium");
-	const Color &bright = *GameData::Colors().Get("bright");
-	const Color &bg = *GameData::Colors().Get("panel background");
-	const Color &bgSelected = *GameData::Colors().Get("panel background selected");
+	const Color &medium = *MEDIUM_COLOR;
+	const Color &bright = *BRIGHT_COLOR;
+	const Color &bg = *PANEL_BACKGROUND_COLOR;
+	const Color &bgSelected = *PANEL_BACKGROUND_SELECTED_COLOR;
 
 	UpdateSmoothScroll(sidebarScroll, sidebarSmoothScroll);
 
@@ -920,7 +936,7 @@ void ShopPanel::DrawShipsSidebar()
 	FillShader::Fill(
 		Point(Screen::Right() - SIDEBAR_WIDTH, 0.),
 		Point(1, Screen::Height()),
-		*GameData::Colors().Get("shop side panel background"));
+		*SHOP_SIDE_PANEL_BACKGROUND_COLOR);
 
 	// Draw this string, centered in the side panel:
 	static const string YOURS = "Your Ships:";
@@ -1068,9 +1084,9 @@ void ShopPanel::DrawShipsSidebar()
 void ShopPanel::DrawDetailsSidebar()
 {
 	// Fill in the background.
-	const Color &line = *GameData::Colors().Get("dim");
-	const Color &back = *GameData::Colors().Get("shop info panel background");
-	const Color &backSelected = *GameData::Colors().Get("shop info panel background selected");
+	const Color &line = *DIM_COLOR;
+	const Color &back = *SHOP_INFO_PANEL_BACKGROUND_COLOR;
+	const Color &backSelected = *SHOP_INFO_PANEL_BACKGROUND_SELECTED_COLOR;
 
 	UpdateSmoothScroll(infobarScroll, infobarSmoothScroll);
 
@@ -1102,20 +1118,20 @@ void ShopPanel::DrawDetailsSidebar()
 void ShopPanel::DrawButtons()
 {
 	// The last 70 pixels on the end of the side panel are for the buttons:
-	const Color &bg = *GameData::Colors().Get("shop side panel background");
-	const Color &bgSelected = *GameData::Colors().Get("shop side panel background selected");
+	const Color &bg = *SHOP_SIDE_PANEL_BACKGROUND_COLOR;
+	const Color &bgSelected = *SHOP_SIDE_PANEL_BACKGROUND_SELECTED_COLOR;
 
 	Point buttonSize(SIDEBAR_WIDTH, BUTTON_HEIGHT);
 	FillShader::Fill(Screen::BottomRight() - .5 * buttonSize, buttonSize,
 		activePane == ShopPane::Sidebar ? bgSelected : bg);
 	FillShader::Fill(
 		Point(Screen::Right() - SIDEBAR_WIDTH / 2, Screen::Bottom() - BUTTON_HEIGHT),
-		Point(SIDEBAR_WIDTH, 1), *GameData::Colors().Get("shop side panel footer"));
+		Point(SIDEBAR_WIDTH, 1), *SHOP_SIDE_PANEL_FOOTER_COLOR);
 
 	const Font &font = FontSet::Get(14);
-	const Color &bright = *GameData::Colors().Get("bright");
-	const Color &dim = *GameData::Colors().Get("medium");
-	const Color &back = *GameData::Colors().Get("panel background");
+	const Color &bright = *BRIGHT_COLOR;
+	const Color &dim = *MEDIUM_COLOR;
+	const Color &back = *PANEL_BACKGROUND_COLOR;
 
 	const Point creditsPoint(
 		Screen::Right() - SIDEBAR_WIDTH + 10,
@@ -1126,9 +1142,9 @@ void ShopPanel::DrawButtons()
 	font.Draw({credits, {SIDEBAR_WIDTH - 20, Alignment::RIGHT}}, creditsPoint, bright);
 
 	const Font &bigFont = FontSet::Get(18);
-	const Color &hover = *GameData::Colors().Get("hover");
-	const Color &active = *GameData::Colors().Get("active");
-	const Color &inactive = *GameData::Colors().Get("inactive");
+	const Color &hover = *HOVER_COLOR;
+	const Color &active = *ACTIVE_COLOR;
+	const Color &inactive = *INACTIVE_COLOR;
 
 	const Point buyCenter = Screen::BottomRight() - Point(210, 25);
 	FillShader::Fill(buyCenter, Point(60, 30), back);
@@ -1199,10 +1215,10 @@ void ShopPanel::DrawButtons()
 void ShopPanel::DrawMain()
 {
 	const Font &bigFont = FontSet::Get(18);
-	const Color &dim = *GameData::Colors().Get("medium");
-	const Color &bright = *GameData::Colors().Get("bright");
-	const Color bg = *GameData::Colors().Get("shop main panel background");
-	const Color bgSelected = *GameData::Colors().Get("shop main panel background selected");
+	const Color &dim = *MEDIUM_COLOR;
+	const Color &bright = *BRIGHT_COLOR;
+	const Color bg = *SHOP_MAIN_PANEL_BACKGROUND_COLOR;
+	const Color bgSelected = *SHOP_MAIN_PANEL_BACKGROUND_SELECTED_COLOR;
 
 	const Sprite *collapsedArrow = SpriteSet::Get("ui/collapsed");
 	const Sprite *expandedArrow = SpriteSet::Get("ui/expanded");
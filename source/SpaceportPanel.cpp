@@ -35,6 +35,7 @@ SpaceportPanel::SpaceportPanel(PlayerInfo &player)
 	: player(player), ui(*GameData::Interfaces().Get("spaceport"))
 {
 	SetTrapAllEvents(false);
+	SetIsStatic(true);
 
 	text.SetFont(FontSet::Get(14));
 	text.SetAlignment(Alignment::JUSTIFIED);
@@ -80,8 +81,13 @@ void SpaceportPanel::Step()
 		// landing missions were offered, they can still be offered here:
 		if(!mission)
 			mission = player.MissionToOffer(Mission::LANDING);
+		// A mission that is accepted without asking the player may still
+		// change what this panel shows.
 		if(mission)
+		{
 			mission->Do(Mission::OFFER, player, GetUI());
+			Redraw();
+		}
 		else
 			player.HandleBlockedMissions(Mission::SPACEPORT, GetUI());
 	}
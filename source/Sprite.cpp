@@ -15,9 +15,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Sprite.h"
 
+#include "GameData.h"
 #include "ImageBuffer.h"
 #include "Preferences.h"
 #include "Screen.h"
+#include "TextureBudget.h"
 
 #include "opengl.h"
 #include <SDL2/SDL.h>
@@ -27,53 +29,31 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
-	void AddBuffer(ImageBuffer &buffer, uint32_t *target, bool isui = false)
-	{
-		if (!buffer.CompressedFormat())
-		{
-			// Reduce the size of the textures (and the GPU memory load) if we are in
-			// "Reduced graphics" mode.
-			if(Preferences::Has("Reduced graphics") && !isui)
-			{
-				do
-				{
-					buffer.ShrinkToHalfSize();
-				}
-				while (buffer.Width() * buffer.Height() >= 250000);
-			}
-		} // else can't edit pre-compressed data like this
-	
-		// Upload the images as a single array texture.
-		glGenTextures(1, target);
-		glBindTexture(GL_TEXTURE_2D_ARRAY, *target);
+	// A blank texture that is drawn in place of sprites that are not loaded.
+	GLuint placeholder = 0;
+	// The pixel unpack buffer that textures are uploaded through, so that the
+	// driver can copy them to the GPU without stalling the main thread.
+	GLuint unpackBuffer = 0;
+	// The amount of data that is uploaded at a time.
+	constexpr size_t CHUNK_BYTES = 256 * 1024;
+}
 
-		// Use linear interpolation and no wrapping.
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-		if (!buffer.CompressedFormat())
-		{
-			// Upload the image data.
-			glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, // target, mipmap level, internal format,
-				buffer.Width(), buffer.Height(), buffer.Frames(), // width, height, depth,
-				0, GL_RGBA, GL_UNSIGNED_BYTE, buffer.Pixels()); // border, input format, data type, data.
-		}
-		else
-		{
-			// Upload the image data.
-			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, 0, buffer.CompressedFormat(), // target, mipmap level, internal format,
-				buffer.Width(), buffer.Height(), buffer.Frames(), // width, height, depth,
-				0, buffer.CompressedSize(), buffer.Pixels()); // border, input format, data type, data.
-		}
 
-		// Unbind the texture.
-		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+// Create the blank texture that is drawn in place of any sprite that is not
+// loaded yet, or was unloaded to save memory.
+void Sprite::CreatePlaceholder()
+{
+	if(placeholder)
+		return;
 
-		// Free the ImageBuffer memory.
-		buffer.Clear();
-	}
+	glGenTextures(1, &placeholder);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, placeholder);
+	const uint32_t transparent = 0;
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, 1, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &transparent);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 }
 
 
@@ -92,12 +72,14 @@ const string &Sprite::Name() const
 
 
 
-// Upload the given frames. The given buffer will be cleared afterwards.
-void Sprite::AddFrames(ImageBuffer &buffer, bool is2x)
+// Upload as much of the given frames as possible before the deadline, and
+// return the fraction of them that has been uploaded. The frames are not used
+// until all of them have been uploaded, and the buffer is cleared then.
+double Sprite::AddFrames(ImageBuffer &buffer, bool is2x, chrono::steady_clock::time_point deadline)
 {
 	// Do nothing if the buffer is empty.
 	if(!buffer.Pixels())
-		return;
+		return 1.;
 
 	// If this is the 1x image, its dimensions determine the sprite's size.
 	if(!is2x)
@@ -107,35 +89,82 @@ void Sprite::AddFrames(ImageBuffer &buffer, bool is2x)
 		frames = buffer.Frames();
 	}
 
-	AddBuffer(buffer, &texture[is2x], name.substr(0, 3) == "ui/");
+	return AddBuffer(buffer, texture[is2x], textureBytes[is2x], deadline, name.substr(0, 3) == "ui/");
 }
 
 
 
-// Upload the given frames. The given buffer will be cleared afterwards.
-void Sprite::AddSwizzleMaskFrames(ImageBuffer &buffer, bool is2x)
+double Sprite::AddSwizzleMaskFrames(ImageBuffer &buffer, bool is2x, chrono::steady_clock::time_point deadline)
 {
 	// Do nothing if the buffer is empty.
 	if(!buffer.Pixels())
-		return;
+		return 1.;
+
+	return AddBuffer(buffer, swizzleMask[is2x], swizzleMaskBytes[is2x], deadline);
+}
+
+
 
-	AddBuffer(buffer, &swizzleMask[is2x]);
+// Use the given region of the given textures of a TextureAtlas page as this
+// sprite's 1x and @2x images, which have the size of the given buffer.
+void Sprite::SetAtlasRegion(const ImageBuffer &buffer, uint32_t texture1x, uint32_t texture2x, const float uvRect[4])
+{
+	width = buffer.DisplayWidth();
+	height = buffer.DisplayHeight();
+	frames = 1;
+
+	texture[0] = texture1x;
+	texture[1] = texture2x;
+	copy(uvRect, uvRect + 4, this->uvRect);
+	isInAtlas = true;
 }
 
 
 
-// Free up all textures loaded for this sprite.
+// Free up all textures loaded for this sprite. Its dimensions are kept, so
+// that it can still be laid out until it is loaded again.
 void Sprite::Unload()
 {
+	// The atlas textures are shared with other sprites, so they stay loaded.
+	if(isInAtlas)
+		return;
+
 	glDeleteTextures(2, texture);
 	texture[0] = texture[1] = 0;
 
 	glDeleteTextures(2, swizzleMask);
 	swizzleMask[0] = swizzleMask[1] = 0;
 
-	width = 0.f;
-	height = 0.f;
-	frames = 0;
+	textureBytes[0] = textureBytes[1] = 0;
+	swizzleMaskBytes[0] = swizzleMaskBytes[1] = 0;
+	GameData::GetTextureBudget().Remove(this);
+	// The sprite must be promoted again if it is drawn before it is reloaded.
+	isPromoted.store(false, memory_order_relaxed);
+
+	// If a texture is part way through being uploaded, drop it too, so that
+	// the next upload starts over.
+	if(uploadTexture)
+	{
+		glDeleteTextures(1, &uploadTexture);
+		uploadTexture = 0;
+		uploadedRows = 0;
+	}
+}
+
+
+
+// Get the number of bytes of GPU memory that this sprite's textures use.
+size_t Sprite::TextureBytes() const
+{
+	return textureBytes[0] + textureBytes[1] + swizzleMaskBytes[0] + swizzleMaskBytes[1];
+}
+
+
+
+// Get the TextureBudget step in which this sprite was last drawn.
+uint64_t Sprite::LastUse() const
+{
+	return lastUse.load(memory_order_relaxed);
 }
 
 
@@ -184,6 +213,16 @@ uint32_t Sprite::Texture() const
 // Get the index of the texture for the given high DPI mode.
 uint32_t Sprite::Texture(bool isHighDPI) const
 {
+	// If this sprite is being drawn before it has been loaded, load it next.
+	// That takes a lock, so once it has been promoted, do not ask again.
+	if(!texture[0])
+	{
+		if(!isPromoted.load(memory_order_relaxed) && GameData::Promote(this))
+			isPromoted.store(true, memory_order_relaxed);
+		return placeholder;
+	}
+
+	lastUse.store(GameData::GetTextureBudget().Step(), memory_order_relaxed);
 	return (isHighDPI && texture[1]) ? texture[1] : texture[0];
 }
 
@@ -202,3 +241,114 @@ uint32_t Sprite::SwizzleMask(bool isHighDPI) const
 {
 	return (isHighDPI && swizzleMask[1]) ? swizzleMask[1] : swizzleMask[0];
 }
+
+
+
+// Get the region of the texture that holds this sprite's images, as the x
+// and y offset and the width and height, in texture coordinates. This is
+// the whole texture unless the sprite is in a TextureAtlas.
+const float *Sprite::UVRect() const
+{
+	return uvRect;
+}
+
+
+
+// Upload as much of the given buffer as possible before the deadline, into a
+// texture that is only stored in the target once all of it has been uploaded.
+// Its size is then stored in targetBytes, replacing that of any old texture.
+// At least one chunk is uploaded each time, so that the upload always makes
+// progress. Return the fraction of the buffer that has been uploaded.
+double Sprite::AddBuffer(ImageBuffer &buffer, uint32_t &target, size_t &targetBytes,
+	chrono::steady_clock::time_point deadline, bool isUI)
+{
+	if(!uploadTexture)
+	{
+		// Reduce the size of the textures (and the GPU memory load) if we are in
+		// "Reduced graphics" mode. Pre-compressed data can't be edited like this,
+		// but it may come with smaller mipmap levels to use instead.
+		if(Preferences::Has("Reduced graphics") && !isUI)
+		{
+			do
+			{
+				if(!buffer.CanShrinkToHalfSize())
+					break;
+				buffer.ShrinkToHalfSize();
+			}
+			while (buffer.Width() * buffer.Height() >= 250000);
+		}
+
+		// The images are stored as a single array texture.
+		glGenTextures(1, &uploadTexture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, uploadTexture);
+
+		// Use linear interpolation and no wrapping.
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		// Allocate the texture. The image data is filled in one chunk at a time.
+		if(!buffer.CompressedFormat())
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, // target, mipmap level, internal format,
+				buffer.Width(), buffer.Height(), buffer.Frames(), // width, height, depth,
+				0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr); // border, input format, data type, data.
+		else
+			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, 0, buffer.CompressedFormat(), // target, mipmap level, internal format,
+				buffer.Width(), buffer.Height(), buffer.Frames(), // width, height, depth,
+				0, buffer.CompressedSize(), nullptr); // border, image size, data.
+		uploadedRows = 0;
+
+		if(!unpackBuffer)
+			glGenBuffers(1, &unpackBuffer);
+	}
+	else
+		glBindTexture(GL_TEXTURE_2D_ARRAY, uploadTexture);
+
+	// Compressed textures are uploaded one row of 4x4 blocks at a time.
+	const bool isCompressed = buffer.CompressedFormat();
+	const int rows = isCompressed ? (buffer.Height() + 3) / 4 : buffer.Height();
+	const int totalRows = rows * buffer.Frames();
+	const size_t rowBytes = isCompressed ? buffer.CompressedSize() / totalRows
+		: buffer.Width() * sizeof(uint32_t);
+	const int chunkRows = max<int>(1, CHUNK_BYTES / rowBytes);
+	const char *pixels = reinterpret_cast<const char *>(buffer.Pixels());
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+	do {
+		// A chunk never spans more than one frame.
+		int frame = uploadedRows / rows;
+		int row = uploadedRows % rows;
+		int count = min(chunkRows, rows - row);
+		size_t size = count * rowBytes;
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, size, pixels + uploadedRows * rowBytes, GL_STREAM_DRAW);
+
+		if(!isCompressed)
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, row, frame, // target, mipmap level, x, y, z offset,
+				buffer.Width(), count, 1, // width, height, depth,
+				GL_RGBA, GL_UNSIGNED_BYTE, nullptr); // input format, data type, offset in the buffer.
+		else
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 4 * row, frame, // target, mipmap level, x, y, z offset,
+				buffer.Width(), min(4 * count, buffer.Height() - 4 * row), 1, // width, height, depth,
+				buffer.CompressedFormat(), size, nullptr); // format, image size, offset in the buffer.
+		uploadedRows += count;
+	} while(uploadedRows < totalRows && chrono::steady_clock::now() < deadline);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	// Unbind the texture.
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	if(uploadedRows < totalRows)
+		return static_cast<double>(uploadedRows) / totalRows;
+
+	// If this sprite already had a texture here, it is replaced.
+	if(target)
+		glDeleteTextures(1, &target);
+	target = uploadTexture;
+	uploadTexture = 0;
+	targetBytes = isCompressed ? buffer.CompressedSize()
+		: static_cast<size_t>(buffer.Width()) * buffer.Height() * buffer.Frames() * sizeof(uint32_t);
+
+	// Free the ImageBuffer memory.
+	buffer.Clear();
+	return 1.;
+}
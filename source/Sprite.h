@@ -18,6 +18,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Point.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <string>
 
@@ -30,16 +32,32 @@ class ImageBuffer;
 // not be as efficient as sprite sheets, but with modern graphics cards it will
 // not matter much and it makes working with the graphics a lot simpler.
 class Sprite {
+public:
+	// Create the blank texture that is drawn in place of any sprite that is not
+	// loaded yet, or was unloaded to save memory.
+	static void CreatePlaceholder();
+
+
 public:
 	explicit Sprite(const std::string &name = "");
 
 	const std::string &Name() const;
 
-	// Upload the given frames. The given buffer will be cleared afterwards.
-	void AddFrames(ImageBuffer &buffer, bool is2x);
-	void AddSwizzleMaskFrames(ImageBuffer &buffer, bool is2x);
-	// Free up all textures loaded for this sprite.
+	// Upload as much of the given frames as possible before the deadline, and
+	// return the fraction of them that has been uploaded. The frames are not used
+	// until all of them have been uploaded, and the buffer is cleared then.
+	double AddFrames(ImageBuffer &buffer, bool is2x, std::chrono::steady_clock::time_point deadline);
+	double AddSwizzleMaskFrames(ImageBuffer &buffer, bool is2x, std::chrono::steady_clock::time_point deadline);
+	// Use the given region of the given textures of a TextureAtlas page as this
+	// sprite's 1x and @2x images, which have the size of the given buffer.
+	void SetAtlasRegion(const ImageBuffer &buffer, uint32_t texture1x, uint32_t texture2x, const float uvRect[4]);
+	// Free up all textures loaded for this sprite. Its dimensions are kept, so
+	// that it can still be laid out until it is loaded again.
 	void Unload();
+	// Get the number of bytes of GPU memory that this sprite's textures use.
+	size_t TextureBytes() const;
+	// Get the TextureBudget step in which this sprite was last drawn.
+	uint64_t LastUse() const;
 
 	// Image dimensions, in pixels.
 	float Width() const;
@@ -60,11 +78,38 @@ public:
 	uint32_t SwizzleMask() const;
 	uint32_t SwizzleMask(bool isHighDPI) const;
 
+	// Get the region of the texture that holds this sprite's images, as the x
+	// and y offset and the width and height, in texture coordinates. This is
+	// the whole texture unless the sprite is in a TextureAtlas.
+	const float *UVRect() const;
+
+private:
+	// Upload as much of the given buffer as possible before the deadline, into a
+	// texture that is only stored in the target once all of it has been uploaded.
+	// Its size is then stored in targetBytes, replacing that of any old texture.
+	double AddBuffer(ImageBuffer &buffer, uint32_t &target, size_t &targetBytes,
+		std::chrono::steady_clock::time_point deadline, bool isUI = false);
+
+
 private:
 	std::string name;
 
 	uint32_t texture[2] = {0, 0};
 	uint32_t swizzleMask[2] = {0, 0};
+	// The number of bytes of GPU memory each of those textures uses.
+	size_t textureBytes[2] = {0, 0};
+	size_t swizzleMaskBytes[2] = {0, 0};
+	float uvRect[4] = {0.f, 0.f, 1.f, 1.f};
+	// Sprites in a TextureAtlas share their textures with other sprites.
+	bool isInAtlas = false;
+	// The texture that is being uploaded, and how many of its rows are done.
+	uint32_t uploadTexture = 0;
+	int uploadedRows = 0;
+	// Sprites may be drawn from any thread.
+	mutable std::atomic<uint64_t> lastUse{0};
+	// Whether drawing this sprite has already moved it to the front of the
+	// loading queue.
+	mutable std::atomic<bool> isPromoted{false};
 
 	float width = 0.f;
 	float height = 0.f;
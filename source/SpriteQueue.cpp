@@ -47,7 +47,7 @@ SpriteQueue::~SpriteQueue()
 {
 	{
 		lock_guard<mutex> lock(readMutex);
-		added = -1;
+		isQuitting = true;
 	}
 	readCondition.notify_all();
 	for(thread &t : threads)
@@ -57,22 +57,69 @@ SpriteQueue::~SpriteQueue()
 
 
 // Add a sprite to load.
-void SpriteQueue::Add(const shared_ptr<ImageSet> &images)
+void SpriteQueue::Add(const shared_ptr<ImageSet> &images, Priority priority)
 {
 	{
 		lock_guard<mutex> lock(readMutex);
 		// Do nothing if we are destroying the queue already.
-		if(added < 0)
+		if(isQuitting)
 			return;
 
-		toRead.push(images);
-		++added;
+		// If this sprite is already waiting to be read, it only needs to be
+		// moved to a higher priority queue (if the new priority is higher).
+		auto it = pending.find(images->Name());
+		if(it != pending.end())
+		{
+			if(priority < it->second)
+			{
+				--added[it->second];
+				++added[priority];
+				it->second = priority;
+				toRead[priority].push_back(images);
+			}
+			return;
+		}
+
+		toRead[priority].push_back(images);
+		pending.emplace(images->Name(), priority);
+		++added[priority];
 	}
 	readCondition.notify_one();
 }
 
 
 
+// If the given sprite has not been read from the disk yet, move it to the
+// front of the queue (e.g. because something is trying to draw it). Return
+// false if it is not waiting to be read.
+bool SpriteQueue::Promote(const string &name)
+{
+	lock_guard<mutex> lock(readMutex);
+	auto it = pending.find(name);
+	if(it == pending.end())
+		return false;
+	// Sprites that are already in the highest priority queue will be read soon
+	// enough, so there is no need to reorder anything.
+	if(it->second == CRITICAL)
+		return true;
+
+	// Find the image set in its current queue. It stays there, but will be
+	// skipped because its priority no longer matches that queue.
+	const deque<shared_ptr<ImageSet>> &queue = toRead[it->second];
+	auto qit = find_if(queue.begin(), queue.end(),
+		[&name](const shared_ptr<ImageSet> &imageSet) { return imageSet->Name() == name; });
+	if(qit == queue.end())
+		return false;
+
+	--added[it->second];
+	++added[CRITICAL];
+	it->second = CRITICAL;
+	toRead[CRITICAL].push_front(*qit);
+	return true;
+}
+
+
+
 // Unload the texture for the given sprite (to free up memory).
 void SpriteQueue::Unload(const string &name)
 {
@@ -82,24 +129,44 @@ void SpriteQueue::Unload(const string &name)
 
 
 
-// Determine the fraction of sprites uploaded to the GPU.
-double SpriteQueue::GetProgress() const
+// Determine the fraction of sprites uploaded to the GPU, only counting the
+// sprites that have at least the given priority.
+double SpriteQueue::GetProgress(Priority priority) const
 {
 	// Wait until we have completed loading of as many sprites as we have added.
-	// The value of "added" is protected by readMutex.
+	// The values of "added" are protected by readMutex, and the values of
+	// "completed" by loadMutex.
 	unique_lock<mutex> readLock(readMutex);
-	// Special cases: we're bailing out, or we are done.
-	if(added <= 0 || added == completed)
+	// Special case: we're bailing out.
+	if(isQuitting)
+		return 1.;
+
+	unique_lock<mutex> loadLock(loadMutex);
+	int totalAdded = 0;
+	int totalCompleted = 0;
+	for(int i = 0; i <= priority; ++i)
+	{
+		totalAdded += added[i];
+		totalCompleted += completed[i];
+	}
+	// Special case: we are done.
+	if(totalAdded <= 0 || totalAdded == totalCompleted)
 		return 1.;
-	return static_cast<double>(completed) / static_cast<double>(added);
+	// Include the part of the current sprite that has been uploaded already.
+	double partial = (uploading && uploadPriority <= priority) ? uploadProgress : 0.;
+	return (totalCompleted + partial) / static_cast<double>(totalAdded);
 }
 
 
 
-void SpriteQueue::UploadSprites()
+// Upload sprites to the GPU for at most the given number of milliseconds.
+void SpriteQueue::UploadSprites(double budgetMs)
 {
+	auto budget = chrono::duration<double, milli>(budgetMs);
+	auto deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(budget);
+
 	unique_lock<mutex> lock(loadMutex);
-	DoLoad(lock);
+	DoLoad(lock, deadline);
 }
 
 
@@ -110,16 +177,20 @@ void SpriteQueue::Finish()
 	// Loop until done loading.
 	while(true)
 	{
-		unique_lock<mutex> lock(loadMutex);
-
-		// Load whatever is already queued up for loading.
-		DoLoad(lock);
+		{
+			// Load whatever is already queued up for loading.
+			unique_lock<mutex> lock(loadMutex);
+			DoLoad(lock, chrono::steady_clock::time_point::max());
+		}
+		// Checking the progress requires the read lock, which must never be
+		// acquired while holding the load lock.
 		if(GetProgress() == 1.)
 			break;
 
 		// We still have sprites to upload, but none of them have been read from
 		// disk yet. Wait until one arrives.
-		loadCondition.wait(lock);
+		unique_lock<mutex> lock(loadMutex);
+		loadCondition.wait(lock, [this]() { return !toLoad.empty(); });
 	}
 }
 
@@ -134,10 +205,10 @@ void SpriteQueue::operator()()
 		while(true)
 		{
 			// To signal this thread that it is time for it to quit, we set
-			// "added" to -1.
-			if(added < 0)
+			// "isQuitting" to true.
+			if(isQuitting)
 				return;
-			if(toRead.empty())
+			if(pending.empty())
 				break;
 			{
 				// Stop loading images so that the main thread can keep up.
@@ -147,8 +218,10 @@ void SpriteQueue::operator()()
 			}
 
 			// Extract the one item we should work on reading right now.
-			shared_ptr<ImageSet> imageSet = toRead.front();
-			toRead.pop();
+			shared_ptr<ImageSet> imageSet;
+			Priority priority;
+			if(!TakeNext(imageSet, priority))
+				break;
 
 			// It's now safe to add to the lists.
 			lock.unlock();
@@ -161,7 +234,7 @@ void SpriteQueue::operator()()
 			{
 				// The texture must be uploaded to OpenGL in the main thread.
 				unique_lock<mutex> lock(loadMutex);
-				toLoad.push(imageSet);
+				toLoad.emplace(imageSet, priority);
 			}
 			loadCondition.notify_one();
 
@@ -174,31 +247,85 @@ void SpriteQueue::operator()()
 
 
 
-void SpriteQueue::DoLoad(unique_lock<mutex> &lock)
+// Get the highest priority image set that still needs to be read. The
+// readMutex must be held when calling this.
+bool SpriteQueue::TakeNext(shared_ptr<ImageSet> &imageSet, Priority &priority)
+{
+	for(int i = 0; i < PRIORITY_COUNT; ++i)
+	{
+		deque<shared_ptr<ImageSet>> &queue = toRead[i];
+		while(!queue.empty())
+		{
+			imageSet = queue.front();
+			queue.pop_front();
+
+			// Skip any image set that was promoted out of this queue, or that
+			// was already read because it was promoted.
+			auto it = pending.find(imageSet->Name());
+			if(it == pending.end() || it->second != i)
+				continue;
+
+			priority = it->second;
+			pending.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+void SpriteQueue::DoLoad(unique_lock<mutex> &lock, chrono::steady_clock::time_point deadline)
 {
 	while(!toUnload.empty())
 	{
 		Sprite *sprite = SpriteSet::Modify(toUnload.front());
 		toUnload.pop();
 
+		// If this sprite is part way through being uploaded, the rest of it
+		// is no longer needed.
+		shared_ptr<ImageSet> cancelled;
+		if(uploading && uploading->Name() == sprite->Name())
+		{
+			cancelled.swap(uploading);
+			++completed[uploadPriority];
+		}
+
 		lock.unlock();
 		sprite->Unload();
+		if(cancelled)
+			cancelled->CancelUpload();
 		lock.lock();
 	}
 
-	for(int i = 0; !toLoad.empty() && i < MAX_QUEUE; ++i)
+	while(uploading || !toLoad.empty())
 	{
-		// Extract the one item we should work on uploading right now.
-		shared_ptr<ImageSet> imageSet = toLoad.front();
-		toLoad.pop();
+		// Continue uploading the current image set, or extract the next one.
+		if(!uploading)
+		{
+			uploading = toLoad.front().first;
+			uploadPriority = toLoad.front().second;
+			uploadProgress = 0.;
+			toLoad.pop();
+		}
+		shared_ptr<ImageSet> imageSet = uploading;
 
 		// It's now safe to modify the lists.
 		lock.unlock();
 
 		readCondition.notify_one();
-		imageSet->Upload(SpriteSet::Modify(imageSet->Name()));
+		double progress = imageSet->Upload(SpriteSet::Modify(imageSet->Name()), deadline);
 
 		lock.lock();
-		++completed;
+		if(progress < 1.)
+		{
+			// Out of time. The rest of this image set is uploaded next frame.
+			uploadProgress = progress;
+			break;
+		}
+		++completed[uploadPriority];
+		uploading.reset();
+		if(chrono::steady_clock::now() >= deadline)
+			break;
 	}
 }
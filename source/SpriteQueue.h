@@ -16,13 +16,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #ifndef SPRITE_QUEUE_H_
 #define SPRITE_QUEUE_H_
 
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 class ImageBuffer;
@@ -33,8 +36,24 @@ class Sprite;
 
 
 // Class for queuing up a list of sprites to be loaded from the disk, with a set of
-// worker threads that begins loading them as soon as they are added.
+// worker threads that begins loading them as soon as they are added. Sprites are
+// read in order of priority, so that the sprites needed to show the menus and
+// the interface can be loaded before everything else.
 class SpriteQueue {
+public:
+	// The order in which queued sprites are read from the disk. All sprites of
+	// one priority are read before any sprite of a lower priority.
+	enum Priority : int {
+		// Sprites needed to display the menus and the HUD.
+		CRITICAL = 0,
+		// All other sprites.
+		NORMAL,
+		// Sprites that are not needed yet, but may be soon.
+		LOW,
+		PRIORITY_COUNT
+	};
+
+
 public:
 	SpriteQueue();
 	~SpriteQueue();
@@ -46,13 +65,20 @@ public:
 	SpriteQueue &operator=(SpriteQueue &&other) = delete;
 
 	// Add a sprite to load.
-	void Add(const std::shared_ptr<ImageSet> &images);
+	void Add(const std::shared_ptr<ImageSet> &images, Priority priority = NORMAL);
+	// If the given sprite has not been read from the disk yet, move it to the
+	// front of the queue (e.g. because something is trying to draw it). Return
+	// false if it is not waiting to be read.
+	bool Promote(const std::string &name);
 	// Unload the texture for the given sprite (to free up memory).
 	void Unload(const std::string &name);
-	// Determine the fraction of sprites uploaded to the GPU.
-	double GetProgress() const;
-	// Uploads any available sprites to the GPU.
-	void UploadSprites();
+	// Determine the fraction of sprites uploaded to the GPU, only counting the
+	// sprites that have at least the given priority.
+	double GetProgress(Priority priority = NORMAL) const;
+	// Upload sprites to the GPU for at most the given number of milliseconds.
+	// An image set that does not fit is uploaded a part at a time, and the
+	// sprite is not drawn until all of it has been uploaded.
+	void UploadSprites(double budgetMs);
 	// Finish loading.
 	void Finish();
 
@@ -61,21 +87,37 @@ public:
 
 
 private:
-	void DoLoad(std::unique_lock<std::mutex> &lock);
+	// Get the highest priority image set that still needs to be read. The
+	// readMutex must be held when calling this.
+	bool TakeNext(std::shared_ptr<ImageSet> &imageSet, Priority &priority);
+	// Unload the sprites that should be unloaded, and upload sprites until the
+	// given deadline. The loadMutex must be held when calling this.
+	void DoLoad(std::unique_lock<std::mutex> &lock, std::chrono::steady_clock::time_point deadline);
 
 
 private:
-	// These are the image sets that need to be loaded from disk.
-	std::queue<std::shared_ptr<ImageSet>> toRead;
+	// These are the image sets that need to be loaded from disk, in one queue
+	// for each priority. Image sets that have been promoted are left behind in
+	// their original queue, and are skipped when they reach the front of it.
+	std::deque<std::shared_ptr<ImageSet>> toRead[PRIORITY_COUNT];
+	// The current priority of every image set that has not been read yet.
+	std::map<std::string, Priority> pending;
 	mutable std::mutex readMutex;
 	std::condition_variable readCondition;
-	int added = 0;
+	int added[PRIORITY_COUNT] = {};
+	// This is set when the queue is being destroyed.
+	bool isQuitting = false;
 
 	// These image sets have been loaded from disk but have not been uploaded.
-	std::queue<std::shared_ptr<ImageSet>> toLoad;
-	std::mutex loadMutex;
+	std::queue<std::pair<std::shared_ptr<ImageSet>, Priority>> toLoad;
+	mutable std::mutex loadMutex;
 	std::condition_variable loadCondition;
-	int completed = 0;
+	int completed[PRIORITY_COUNT] = {};
+	// The image set that is being uploaded, a part at a time, and the fraction
+	// of it that has been uploaded.
+	std::shared_ptr<ImageSet> uploading;
+	Priority uploadPriority = NORMAL;
+	double uploadProgress = 0.;
 
 	// These sprites must be unloaded to reclaim GPU memory.
 	std::queue<std::string> toUnload;
@@ -15,12 +15,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "SpriteShader.h"
 
+#include "Logger.h"
 #include "Point.h"
 #include "Screen.h"
 #include "Shader.h"
 #include "Sprite.h"
 
+#include <algorithm>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #ifdef ES_GLES
@@ -45,11 +49,53 @@ namespace {
 	GLint clipI;
 	GLint alphaI;
 	GLint swizzlerI;
+	GLint uvRectI;
 
 	GLuint vao;
 	GLuint vbo;
 
+	// The instanced shader gets the parameters of each sprite from a stream
+	// of per-instance vertex attributes instead of from uniforms.
+	Shader instancedShader;
+	GLint instancedScaleI;
+	GLuint instancedVao;
+	GLuint instanceVbo;
+	bool canDrawInstanced = false;
+	vector<GLfloat> instanceData;
+
 	const int SWIZZLES = 29;
+	// Each instance has a position, a transform matrix, a blur vector, the
+	// frame, frame count, clip and alpha, the swizzle and whether to use the
+	// swizzle mask, and the region of the texture that the sprite is in.
+	const int INSTANCE_SIZE = 18;
+
+	// Bounds check for the swizzle value.
+	int ValidSwizzle(uint32_t swizzle)
+	{
+		return swizzle >= static_cast<uint32_t>(SWIZZLES) ? 0 : swizzle;
+	}
+
+	// Point the per-instance attributes at the data of the given instance, so
+	// that the next instanced draw call starts with that sprite.
+	void SetInstanceOffset(size_t first)
+	{
+		static const struct {
+			const char *name;
+			GLint size;
+			size_t offset;
+		} ATTRIBUTES[] = {
+			{"position", 2, 0},
+			{"transform", 4, 2},
+			{"blurVector", 2, 6},
+			{"frameData", 4, 8},
+			{"swizzleData", 2, 12},
+			{"uvRectData", 4, 14},
+		};
+		constexpr auto stride = INSTANCE_SIZE * sizeof(GLfloat);
+		for(const auto &it : ATTRIBUTES)
+			glVertexAttribPointer(instancedShader.Attrib(it.name), it.size, GL_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<const GLvoid *>((first * INSTANCE_SIZE + it.offset) * sizeof(GLfloat)));
+	}
 }
 
 // Initialize the shaders.
@@ -75,26 +121,84 @@ void SpriteShader::Init()
 		"  fragTexCoord = vec2(texCoord.x, min(clip, texCoord.y)) + blurOff;\n"
 		"}\n";
 
-	static const char *fragmentCode =
+	// The instanced vertex shader passes the parameters of each sprite on to
+	// the fragment shader, which is otherwise the same as for a single sprite.
+	static const char *instancedVertexCode =
+		"// instanced vertex sprite shader\n"
+		"precision mediump float;\n"
+		"uniform vec2 scale;\n"
+
+		"in vec2 vert;\n"
+		"in vec2 position;\n"
+		"in vec4 transform;\n"
+		"in vec2 blurVector;\n"
+		"in vec4 frameData;\n"
+		"in vec2 swizzleData;\n"
+		"in vec4 uvRectData;\n"
+		"out vec2 fragTexCoord;\n"
+		"flat out float frame;\n"
+		"flat out float frameCount;\n"
+		"flat out vec2 blur;\n"
+		"flat out float alpha;\n"
+		"flat out int swizzler;\n"
+		"flat out int useSwizzleMask;\n"
+		"flat out highp vec4 uvRect;\n"
+
+		"void main() {\n"
+		"  frame = frameData.x;\n"
+		"  frameCount = frameData.y;\n"
+		"  blur = blurVector;\n"
+		"  alpha = frameData.w;\n"
+		"  swizzler = int(swizzleData.x);\n"
+		"  useSwizzleMask = int(swizzleData.y);\n"
+		"  uvRect = uvRectData;\n"
+		"  vec2 blurOff = 2.f * vec2(vert.x * abs(blur.x), vert.y * abs(blur.y));\n"
+		"  gl_Position = vec4((mat2(transform) * (vert + blurOff) + position) * scale, 0, 1);\n"
+		"  vec2 texCoord = vert + vec2(.5, .5);\n"
+		"  fragTexCoord = vec2(texCoord.x, min(frameData.z, texCoord.y)) + blurOff;\n"
+		"}\n";
+
+	static const char *fragmentHeader =
 		"// fragment sprite shader\n"
 		"precision mediump float;\n"
 #ifdef ES_GLES
 		"precision mediump sampler2DArray;\n"
 #endif
 		"uniform sampler2DArray tex;\n"
-		"uniform sampler2DArray swizzleMask;\n"
+		"uniform sampler2DArray swizzleMask;\n";
+
+	static const char *fragmentUniforms =
 		"uniform int useSwizzleMask;\n"
 		"uniform float frame;\n"
 		"uniform float frameCount;\n"
 		"uniform vec2 blur;\n"
 		"uniform int swizzler;\n"
 		"uniform float alpha;\n"
+		"uniform highp vec4 uvRect;\n";
+
+	static const char *fragmentInputs =
+		"flat in int useSwizzleMask;\n"
+		"flat in float frame;\n"
+		"flat in float frameCount;\n"
+		"flat in vec2 blur;\n"
+		"flat in int swizzler;\n"
+		"flat in float alpha;\n"
+		"flat in highp vec4 uvRect;\n";
+
+	static const char *fragmentBody =
 		"const int range = 5;\n"
 
 		"in vec2 fragTexCoord;\n"
 
 		"out vec4 finalColor;\n"
 
+		// Map coordinates within the sprite to the part of the texture that it
+		// is in, which is only part of it if the sprite is in an atlas. That
+		// needs more precision than the rest of the shader.
+		"highp vec2 Atlas(vec2 coord) {\n"
+		"  return uvRect.xy + clamp(coord, 0.f, 1.f) * uvRect.zw;\n"
+		"}\n"
+
 		"void main() {\n"
 		"  float first = floor(frame);\n"
 		"  float second = mod(ceil(frame), frameCount);\n"
@@ -104,10 +208,10 @@ void SpriteShader::Init()
 		"  {\n"
 		"    if(fade != 0.f)\n"
 		"      color = mix(\n"
-		"        texture(tex, vec3(fragTexCoord, first)),\n"
-		"        texture(tex, vec3(fragTexCoord, second)), fade);\n"
+		"        texture(tex, vec3(Atlas(fragTexCoord), first)),\n"
+		"        texture(tex, vec3(Atlas(fragTexCoord), second)), fade);\n"
 		"    else\n"
-		"      color = texture(tex, vec3(fragTexCoord, first));\n"
+		"      color = texture(tex, vec3(Atlas(fragTexCoord), first));\n"
 		"  }\n"
 		"  else\n"
 		"  {\n"
@@ -116,7 +220,7 @@ void SpriteShader::Init()
 		"    for(int i = -range; i <= range; ++i)\n"
 		"    {\n"
 		"      float scale = float(range + 1 - abs(i)) / divisor;\n"
-		"      vec2 coord = fragTexCoord + (blur * float(i)) / float(range);\n"
+		"      vec2 coord = Atlas(fragTexCoord + (blur * float(i)) / float(range));\n"
 		"      if(fade != 0.f)\n"
 		"        color += scale * mix(\n"
 		"          texture(tex, vec3(coord, first)),\n"
@@ -246,7 +350,7 @@ void SpriteShader::Init()
 		"  }\n"
 		"  if(useSwizzleMask > 0)\n"
 		"  {\n"
-		"    float factor = texture(swizzleMask, vec3(fragTexCoord, first)).r;\n"
+		"    float factor = texture(swizzleMask, vec3(Atlas(fragTexCoord), first)).r;\n"
 		"    color = color * factor + swizzleColor * (1.0 - factor);\n"
 		"  }\n"
 		"  else\n"
@@ -254,7 +358,8 @@ void SpriteShader::Init()
 		"  finalColor = color * alpha;\n"
 		"}\n";
 
-	shader = Shader(vertexCode, fragmentCode);
+	string fragmentCode = string(fragmentHeader) + fragmentUniforms + fragmentBody;
+	shader = Shader(vertexCode, fragmentCode.c_str());
 	scaleI = shader.Uniform("scale");
 	texI = shader.Uniform("tex");
 	frameI = shader.Uniform("frame");
@@ -267,6 +372,7 @@ void SpriteShader::Init()
 	swizzlerI = shader.Uniform("swizzler");
 	swizzleMaskI = shader.Uniform("swizzleMask");
 	useSwizzleMaskI = shader.Uniform("useSwizzleMask");
+	uvRectI = shader.Uniform("uvRect");
 
 	// Generate the vertex data for drawing sprites.
 	glGenVertexArrays(1, &vao);
@@ -289,6 +395,46 @@ void SpriteShader::Init()
 	// unbind the VBO and VAO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
+
+	// Drawing many sprites with one instanced draw call needs OpenGL 3.3 or
+	// OpenGL ES 3.0. Without it, every sprite is drawn with its own call.
+	if(!OpenGL::HasInstancingSupport())
+		return;
+	try {
+		string instancedFragmentCode = string(fragmentHeader) + fragmentInputs + fragmentBody;
+		instancedShader = Shader(instancedVertexCode, instancedFragmentCode.c_str());
+		instancedScaleI = instancedShader.Uniform("scale");
+		glUseProgram(instancedShader.Object());
+		glUniform1i(instancedShader.Uniform("tex"), 0);
+		glUniform1i(instancedShader.Uniform("swizzleMask"), 1);
+		glUseProgram(0);
+
+		glGenVertexArrays(1, &instancedVao);
+		glBindVertexArray(instancedVao);
+
+		// The corners of the sprite are shared by all the instances.
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glEnableVertexAttribArray(instancedShader.Attrib("vert"));
+		glVertexAttribPointer(instancedShader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+
+		// Everything else advances once per instance.
+		glGenBuffers(1, &instanceVbo);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+		for(const char *name : {"position", "transform", "blurVector", "frameData", "swizzleData", "uvRectData"})
+		{
+			glEnableVertexAttribArray(instancedShader.Attrib(name));
+			glVertexAttribDivisor(instancedShader.Attrib(name), 1);
+		}
+		SetInstanceOffset(0);
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
+		canDrawInstanced = true;
+	}
+	catch(const runtime_error &error)
+	{
+		Logger::LogError("Unable to set up instanced sprite drawing: " + string(error.what()));
+	}
 }
 
 
@@ -316,6 +462,7 @@ SpriteShader::Item SpriteShader::Prepare(const Sprite *sprite, const Point &posi
 	item.swizzleMask = sprite->SwizzleMask();
 	item.frame = frame;
 	item.frameCount = sprite->Frames();
+	copy(sprite->UVRect(), sprite->UVRect() + 4, item.uvRect);
 	// Position.
 	item.position[0] = static_cast<float>(position.X());
 	item.position[1] = static_cast<float>(position.Y());
@@ -362,13 +509,13 @@ void SpriteShader::Add(const Item &item, bool withBlur)
 	glUniform2fv(blurI, 1, withBlur ? item.blur : UNBLURRED);
 	glUniform1f(clipI, item.clip);
 	glUniform1f(alphaI, item.alpha);
+	glUniform4fv(uvRectI, 1, item.uvRect);
 
-	// Bounds check for the swizzle value:
-	int swizzle = (static_cast<size_t>(item.swizzle) >= SWIZZLES ? 0 : item.swizzle);
 	// Set the color swizzle.
-	glUniform1i(swizzlerI, swizzle);
+	glUniform1i(swizzlerI, ValidSwizzle(item.swizzle));
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	OpenGL::CountDrawCall();
 }
 
 
@@ -381,3 +528,74 @@ void SpriteShader::Unbind()
 	glBindVertexArray(0);
 	glUseProgram(0);
 }
+
+
+
+// Check whether many sprites can be drawn with a single draw call. If not,
+// each one must be drawn separately using Bind(), Add() and Unbind().
+bool SpriteShader::CanDrawInstanced()
+{
+	return canDrawInstanced;
+}
+
+
+
+// Draw the given items in order. Each run of consecutive items that use the
+// same texture and swizzle mask is drawn with a single instanced draw call.
+void SpriteShader::DrawInstanced(const vector<const Item *> &items, bool withBlur)
+{
+	if(items.empty())
+		return;
+
+	instanceData.clear();
+	instanceData.reserve(items.size() * INSTANCE_SIZE);
+	for(const Item *item : items)
+	{
+		instanceData.insert(instanceData.end(), item->position, item->position + 2);
+		instanceData.insert(instanceData.end(), item->transform, item->transform + 4);
+		instanceData.push_back(withBlur ? item->blur[0] : 0.f);
+		instanceData.push_back(withBlur ? item->blur[1] : 0.f);
+		instanceData.push_back(item->frame);
+		instanceData.push_back(item->frameCount);
+		instanceData.push_back(item->clip);
+		instanceData.push_back(item->alpha);
+		instanceData.push_back(ValidSwizzle(item->swizzle));
+		// Don't mask full color swizzles that always apply to the whole ship sprite.
+		instanceData.push_back(item->swizzle < 27 && item->swizzleMask);
+		instanceData.insert(instanceData.end(), item->uvRect, item->uvRect + 4);
+	}
+
+	glUseProgram(instancedShader.Object());
+	glBindVertexArray(instancedVao);
+
+	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
+	glUniform2fv(instancedScaleI, 1, scale);
+
+	// The buffer is respecified every time, so the driver can give it new
+	// storage instead of waiting for the previous draw calls to finish with it.
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+	glBufferData(GL_ARRAY_BUFFER, instanceData.size() * sizeof(GLfloat), instanceData.data(), GL_STREAM_DRAW);
+
+	for(size_t first = 0; first < items.size(); )
+	{
+		const Item &item = *items[first];
+		size_t end = first + 1;
+		while(end < items.size() && items[end]->texture == item.texture
+				&& items[end]->swizzleMask == item.swizzleMask)
+			++end;
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, item.texture);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, item.swizzleMask);
+		glActiveTexture(GL_TEXTURE0);
+
+		SetInstanceOffset(first);
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, end - first);
+		OpenGL::CountDrawCall();
+		first = end;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
@@ -20,6 +20,7 @@ class Sprite;
 class Point;
 
 #include <cstdint>
+#include <vector>
 
 
 
@@ -42,6 +43,8 @@ public:
 		float blur[2] = {0.f, 0.f};
 		float clip = 1.f;
 		float alpha = 1.f;
+		// The region of the texture that the sprite is in.
+		float uvRect[4] = {0.f, 0.f, 1.f, 1.f};
 	};
 
 
@@ -58,6 +61,13 @@ public:
 	static void Bind();
 	static void Add(const Item &item, bool withBlur = false);
 	static void Unbind();
+
+	// Check whether many sprites can be drawn with a single draw call. If not,
+	// each one must be drawn separately using Bind(), Add() and Unbind().
+	static bool CanDrawInstanced();
+	// Draw the given items in order. Each run of consecutive items that use the
+	// same texture and swizzle mask is drawn with a single instanced draw call.
+	static void DrawInstanced(const std::vector<const Item *> &items, bool withBlur = false);
 };
 
 
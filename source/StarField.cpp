@@ -34,6 +34,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const PreferenceFlag DRAW_BACKGROUND_HAZE("Draw background haze");
+	const PreferenceFlag DRAW_STARFIELD("Draw starfield");
+
 	const int TILE_SIZE = 256;
 	// The star field tiles in 4000 pixel increments. Have the tiling of the haze
 	// field be as different from that as possible. (Note: this may need adjusting
@@ -138,7 +141,7 @@ void StarField::Draw(const Point &pos, const Point &vel, double zoom, const Syst
 						parallaxSetting == Preferences::BackgroundParallax::FAST);
 
 	// Draw the starfield unless it is disabled in the preferences.
-	if(Preferences::Has("Draw starfield") && density > 0.)
+	if(DRAW_STARFIELD.Has() && density > 0.)
 	{
 		glUseProgram(shader.Object());
 		glBindVertexArray(vao);
@@ -195,6 +198,7 @@ void StarField::Draw(const Point &pos, const Point &vel, double zoom, const Syst
 					int first = 6 * tileIndex[index];
 					int count = 6 * tileIndex[index + 1] - first;
 					glDrawArrays(GL_TRIANGLES, first, density * count / (pass * layers));
+					OpenGL::CountDrawCall();
 				}
 			}
 		}
@@ -203,7 +207,7 @@ void StarField::Draw(const Point &pos, const Point &vel, double zoom, const Syst
 	}
 
 	// Draw the background haze unless it is disabled in the preferences.
-	if(!Preferences::Has("Draw background haze"))
+	if(!DRAW_BACKGROUND_HAZE.Has())
 		return;
 
 	// Modify zoom for the second parallax layer.
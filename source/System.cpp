@@ -917,6 +917,19 @@ void System::SetSupply(const string &commodity, double tons)
 
 
 
+// Forget the supply of every commodity, as if the economy had never run.
+void System::ResetTrade()
+{
+	for(auto &it : trade)
+	{
+		it.second.supply = 0.;
+		it.second.exports = 0.;
+		it.second.Update();
+	}
+}
+
+
+
 double System::Supply(const string &commodity) const
 {
 	auto it = trade.find(commodity);
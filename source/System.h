@@ -160,6 +160,8 @@ public:
 	// Update the economy. Returns the amount of trade goods this system exports.
 	void StepEconomy();
 	void SetSupply(const std::string &commodity, double tons);
+	// Forget the supply of every commodity, as if the economy had never run.
+	void ResetTrade();
 	double Supply(const std::string &commodity) const;
 	double Exports(const std::string &commodity) const;
 
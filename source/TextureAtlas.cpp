@@ -0,0 +1,138 @@
+/* TextureAtlas.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "TextureAtlas.h"
+
+#include "ImageBuffer.h"
+#include "Preferences.h"
+#include "ShelfPacker.h"
+#include "Sprite.h"
+
+#include "opengl.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// The size of a page at 1x. OpenGL ES 3.0 supports textures of at least
+	// 2048 pixels, which is the size of the @2x pages.
+	const int PAGE_SIZE = 1024;
+	// The largest sprite that is packed into a page.
+	const int MAX_SIZE = 256;
+	// Each sprite is surrounded by a copy of its edge pixels, so that filtering
+	// never blends in the pixels of its neighbors.
+	const int PADDING = 1;
+
+	struct Page {
+		GLuint texture[2] = {0, 0};
+		ShelfPacker packer = ShelfPacker(PAGE_SIZE, PADDING);
+	};
+
+	vector<Page> pages;
+
+
+	GLuint CreateTexture(int size)
+	{
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		return texture;
+	}
+
+
+	// Copy the given image into the given texture at the given position,
+	// surrounded by the given number of copies of its edge pixels.
+	void Copy(GLuint texture, const ImageBuffer &image, int x, int y, int padding)
+	{
+		int width = image.Width() + 2 * padding;
+		int height = image.Height() + 2 * padding;
+		vector<uint32_t> pixels(width * height);
+		for(int py = 0; py < height; ++py)
+		{
+			const uint32_t *row = image.Begin(max(0, min(image.Height() - 1, py - padding)));
+			for(int px = 0; px < width; ++px)
+				pixels[px + py * width] = row[max(0, min(image.Width() - 1, px - padding))];
+		}
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, 0, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	}
+}
+
+
+
+// If the given images are small enough, copy them into an atlas page and
+// point the sprite at that part of the page. The buffers are cleared then.
+// Return false if the images must be uploaded as their own texture instead.
+bool TextureAtlas::Add(Sprite *sprite, ImageBuffer &image, ImageBuffer &image2x)
+{
+	// Only small, uncompressed images with a single frame are packed.
+	if(!image.Pixels() || image.CompressedFormat() || image.Frames() != 1)
+		return false;
+	if(image.Width() > MAX_SIZE || image.Height() > MAX_SIZE)
+		return false;
+	// The @2x image, if any, must have exactly the same layout at twice the size.
+	bool has2x = image2x.Pixels();
+	if(has2x && (image2x.CompressedFormat() || image2x.Frames() != 1
+			|| image2x.Width() != 2 * image.Width() || image2x.Height() != 2 * image.Height()))
+		return false;
+	// "Reduced graphics" mode shrinks all but the interface sprites, which
+	// only happens when they are uploaded as their own texture.
+	if(Preferences::Has("Reduced graphics") && sprite->Name().compare(0, 3, "ui/"))
+		return false;
+
+	// Find room on an existing page, or start a new one.
+	int width = image.Width();
+	int height = image.Height();
+	int x = 0;
+	int y = 0;
+	auto it = find_if(pages.begin(), pages.end(),
+		[width, height, &x, &y](Page &page) { return page.packer.Place(width, height, x, y); });
+	if(it == pages.end())
+	{
+		pages.emplace_back();
+		it = prev(pages.end());
+		it->texture[0] = CreateTexture(PAGE_SIZE);
+		it->packer.Place(width, height, x, y);
+	}
+
+	Copy(it->texture[0], image, x - PADDING, y - PADDING, PADDING);
+	if(has2x)
+	{
+		if(!it->texture[1])
+			it->texture[1] = CreateTexture(2 * PAGE_SIZE);
+		Copy(it->texture[1], image2x, 2 * (x - PADDING), 2 * (y - PADDING), 2 * PADDING);
+	}
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	const float uvRect[4] = {
+		static_cast<float>(x) / PAGE_SIZE,
+		static_cast<float>(y) / PAGE_SIZE,
+		static_cast<float>(image.Width()) / PAGE_SIZE,
+		static_cast<float>(image.Height()) / PAGE_SIZE
+	};
+	sprite->SetAtlasRegion(image, it->texture[0], has2x ? it->texture[1] : 0, uvRect);
+
+	image.Clear();
+	image2x.Clear();
+	return true;
+}
@@ -0,0 +1,40 @@
+/* TextureAtlas.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEXTURE_ATLAS_H_
+#define TEXTURE_ATLAS_H_
+
+class ImageBuffer;
+class Sprite;
+
+
+
+// Class that packs small sprites with a single frame (outfit thumbnails, icons,
+// buttons and the like) into a few large shared textures, or "pages", as they
+// are uploaded. Each such sprite remembers which part of its page it is in, so
+// that sprites on the same page can be drawn without binding a new texture, and
+// batched together. Each page has a 1x texture and, if any of its sprites have
+// @2x images, an @2x texture with the same layout at twice the size.
+class TextureAtlas {
+public:
+	// If the given images are small enough, copy them into an atlas page and
+	// point the sprite at that part of the page. The buffers are cleared then.
+	// Return false if the images must be uploaded as their own texture instead.
+	static bool Add(Sprite *sprite, ImageBuffer &image, ImageBuffer &image2x);
+};
+
+
+
+#endif
@@ -0,0 +1,188 @@
+/* TextureBudget.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "TextureBudget.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+	// Sprites that were drawn or added at most this many steps (about two
+	// seconds) ago are still in use, and are never evicted.
+	const uint64_t RECENT_STEPS = 120;
+	// If none of the sprites could be evicted, wait this many steps before
+	// checking all of them again.
+	const uint64_t RETRY_STEPS = 60;
+
+	// Forget about evictions that happened longer ago than this.
+	const chrono::minutes EVICTION_WINDOW(1);
+}
+
+
+
+// Set the budget, in bytes. A budget of zero means there is no limit.
+void TextureBudget::SetLimit(size_t bytes)
+{
+	lock_guard<mutex> lock(budgetMutex);
+	limit = bytes;
+	nextPass = 0;
+}
+
+
+
+size_t TextureBudget::Limit() const
+{
+	lock_guard<mutex> lock(budgetMutex);
+	return limit;
+}
+
+
+
+// Record that textures using the given number of bytes were uploaded for the
+// given sprite.
+void TextureBudget::Add(const Sprite *sprite, size_t bytes)
+{
+	lock_guard<mutex> lock(budgetMutex);
+	Entry &entry = sprites[sprite];
+	entry.bytes += bytes;
+	// A sprite that was just loaded is about to be drawn, so it should not be
+	// evicted again right away.
+	entry.added = step;
+	resident += bytes;
+	isSorted = false;
+}
+
+
+
+// Record that all the textures of the given sprite were deleted.
+void TextureBudget::Remove(const Sprite *sprite)
+{
+	lock_guard<mutex> lock(budgetMutex);
+	auto it = sprites.find(sprite);
+	if(it == sprites.end())
+		return;
+
+	resident -= it->second.bytes;
+	sprites.erase(it);
+}
+
+
+
+// Get the current step, which is what a sprite should record as the time it
+// was last drawn. This may be called from any thread.
+uint64_t TextureBudget::Step() const
+{
+	return step.load(memory_order_relaxed);
+}
+
+
+
+// Choose the sprites to unload to bring the textures back within the budget.
+// Only sprites for which the given function returns true may be chosen, and
+// never any that were drawn (according to the given function) or added in the
+// last few seconds. The chosen sprites no longer count against the budget.
+// This should be called once per frame, since it also advances the step. If
+// nothing can be evicted, the next second's worth of calls do not try again.
+vector<const Sprite *> TextureBudget::Evict(const function<bool(const Sprite *)> &canEvict,
+	const function<uint64_t(const Sprite *)> &lastUse)
+{
+	lock_guard<mutex> lock(budgetMutex);
+	uint64_t now = ++step;
+	vector<const Sprite *> evicted;
+	if(!limit || resident <= limit)
+	{
+		isSorted = false;
+		return evicted;
+	}
+	// Sprites that cannot be evicted, like the critical ones, still count
+	// against the budget, so it may not be possible to get under it. Checking
+	// every sprite in every frame would not change that.
+	if(now < nextPass)
+		return evicted;
+
+	// Sort the sprites, least recently drawn first.
+	if(!isSorted)
+	{
+		vector<pair<uint64_t, const Sprite *>> sorted;
+		sorted.reserve(sprites.size());
+		for(const auto &it : sprites)
+			sorted.emplace_back(max(it.second.added, lastUse(it.first)), it.first);
+		sort(sorted.begin(), sorted.end());
+
+		order.clear();
+		for(const auto &it : sorted)
+			order.push_back(it.second);
+		isSorted = true;
+	}
+
+	// Evict sprites from the front of the list until the textures fit. Sprites
+	// that have been removed are dropped from the list, and those that were
+	// drawn recently are moved to its back.
+	auto time = chrono::steady_clock::now();
+	vector<const Sprite *> remaining;
+	vector<const Sprite *> recent;
+	remaining.reserve(order.size());
+	auto it = order.begin();
+	for( ; it != order.end() && resident > limit; ++it)
+	{
+		auto sit = sprites.find(*it);
+		if(sit == sprites.end())
+			continue;
+		if(max(sit->second.added, lastUse(*it)) + RECENT_STEPS >= now)
+			recent.push_back(*it);
+		else if(!canEvict(*it))
+			remaining.push_back(*it);
+		else
+		{
+			resident -= sit->second.bytes;
+			sprites.erase(sit);
+			evicted.push_back(*it);
+			evictions.push_back(time);
+		}
+	}
+	remaining.insert(remaining.end(), it, order.end());
+	remaining.insert(remaining.end(), recent.begin(), recent.end());
+	order.swap(remaining);
+	// The sprites will be drawn in the meantime, so sort them again when the
+	// next pass is made.
+	if(evicted.empty())
+	{
+		nextPass = now + RETRY_STEPS;
+		isSorted = false;
+	}
+	return evicted;
+}
+
+
+
+// Get the number of bytes used by all the textures that are loaded.
+size_t TextureBudget::ResidentBytes() const
+{
+	lock_guard<mutex> lock(budgetMutex);
+	return resident;
+}
+
+
+
+// Get the number of sprites that were evicted in the last minute.
+int TextureBudget::EvictionsPerMinute() const
+{
+	lock_guard<mutex> lock(budgetMutex);
+	auto cutoff = chrono::steady_clock::now() - EVICTION_WINDOW;
+	while(!evictions.empty() && evictions.front() < cutoff)
+		evictions.pop_front();
+	return evictions.size();
+}
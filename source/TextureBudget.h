@@ -0,0 +1,99 @@
+/* TextureBudget.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEXTURE_BUDGET_H_
+#define TEXTURE_BUDGET_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+class Sprite;
+
+
+
+// Class that keeps track of how much GPU memory the textures of each sprite
+// use (at both 1x and @2x). If all the textures together use more memory than
+// the budget allows, the sprites that have gone the longest without being
+// drawn can be unloaded, to be loaded again when something needs to draw them.
+// Each sprite records the step in which it was last drawn itself, so that
+// drawing it does not need to lock the budget.
+class TextureBudget {
+public:
+	// Set the budget, in bytes. A budget of zero means there is no limit.
+	void SetLimit(size_t bytes);
+	size_t Limit() const;
+
+	// Record that textures using the given number of bytes were uploaded for
+	// the given sprite.
+	void Add(const Sprite *sprite, size_t bytes);
+	// Record that all the textures of the given sprite were deleted.
+	void Remove(const Sprite *sprite);
+	// Get the current step, which is what a sprite should record as the time
+	// it was last drawn. This may be called from any thread.
+	uint64_t Step() const;
+
+	// Choose the sprites to unload to bring the textures back within the
+	// budget. Only sprites for which the given function returns true may be
+	// chosen, and never any that were drawn (according to the given function)
+	// or added in the last few seconds. The chosen sprites no longer count
+	// against the budget. This should be called once per frame, since it also
+	// advances the step. If nothing can be evicted, the next second's worth of
+	// calls do not try again.
+	std::vector<const Sprite *> Evict(const std::function<bool(const Sprite *)> &canEvict,
+		const std::function<uint64_t(const Sprite *)> &lastUse);
+
+	// Get the number of bytes used by all the textures that are loaded.
+	size_t ResidentBytes() const;
+	// Get the number of sprites that were evicted in the last minute.
+	int EvictionsPerMinute() const;
+
+
+private:
+	class Entry {
+	public:
+		size_t bytes = 0;
+		uint64_t added = 0;
+	};
+
+
+private:
+	mutable std::mutex budgetMutex;
+	std::map<const Sprite *, Entry> sprites;
+	// The sprites in the order they should be evicted in. This is only sorted
+	// again when sprites are added or the budget is first exceeded; sprites
+	// that turn out to have been drawn since then are moved to the back.
+	std::vector<const Sprite *> order;
+	bool isSorted = false;
+	size_t limit = 0;
+	size_t resident = 0;
+	// The first step in which to look for sprites to evict again, after a
+	// pass that found none.
+	uint64_t nextPass = 0;
+	// The number of times Evict() has been called.
+	std::atomic<uint64_t> step{0};
+	// When each of the recent evictions happened.
+	mutable std::deque<std::chrono::steady_clock::time_point> evictions;
+};
+
+
+
+#endif
@@ -37,6 +37,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const ColorRef BRIGHT_COLOR("bright");
+	const ColorRef FAINT_COLOR("faint");
+	const ColorRef MEDIUM_COLOR("medium");
+
+	const InterfaceRef TRADE_INTERFACE("trade");
+
 	const string TRADE_LEVEL[] = {
 		"(very low)",
 		"(low)",
@@ -60,6 +66,7 @@ TradingPanel::TradingPanel(PlayerInfo &player)
 	: player(player), system(*player.GetSystem()), COMMODITY_COUNT(GameData::Commodities().size())
 {
 	SetTrapAllEvents(false);
+	SetIsStatic(true);
 
 	buyMultiplier.SetAlign(Dropdown::LEFT);
 	buyMultiplier.SetFontSize(14);
@@ -100,12 +107,12 @@ void TradingPanel::Step()
 
 void TradingPanel::Draw()
 {
-	const Interface *tradeUi = GameData::Interfaces().Get("trade");
+	const Interface *tradeUi = TRADE_INTERFACE.Get();
 	const Rectangle box = tradeUi->GetBox("content");
 	const int MIN_X = box.Left();
 	const int FIRST_Y = box.Top();
 
-	const Color &back = *GameData::Colors().Get("faint");
+	const Color &back = *FAINT_COLOR;
 	int selectedRow = player.MapColoring();
 	if(selectedRow >= 0 && selectedRow < COMMODITY_COUNT)
 	{
@@ -115,8 +122,8 @@ void TradingPanel::Draw()
 	}
 
 	const Font &font = FontSet::Get(14);
-	const Color &unselected = *GameData::Colors().Get("medium");
-	const Color &selected = *GameData::Colors().Get("bright");
+	const Color &unselected = *MEDIUM_COLOR;
+	const Color &selected = *BRIGHT_COLOR;
 
 	int y = FIRST_Y;
 	font.Draw("Commodity", Point(MIN_X + NAME_X, y), selected);
@@ -313,7 +320,7 @@ bool TradingPanel::KeyDown(SDL_Keycode key, Uint16 mod, const Command &command,
 
 bool TradingPanel::Click(int x, int y, int clicks)
 {
-	const Interface *tradeUi = GameData::Interfaces().Get("trade");
+	const Interface *tradeUi = TRADE_INTERFACE.Get();
 	const Rectangle box = tradeUi->GetBox("content");
 	const int MIN_X = box.Left();
 	const int FIRST_Y = box.Top();
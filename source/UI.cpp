@@ -47,6 +47,9 @@ namespace
 // of them handles it. If none do, this returns false.
 bool UI::Handle(const SDL_Event &event)
 {
+	// Any input may change what the panels look like.
+	needsDraw = true;
+
 	bool handled = false;
 	SDL_GameControllerAxis axisTriggered = SDL_CONTROLLER_AXIS_INVALID;
 	SDL_GameControllerAxis axisUnTriggered = SDL_CONTROLLER_AXIS_INVALID;
@@ -300,14 +303,13 @@ void UI::DrawAll()
 	for(const shared_ptr<Panel> &it : stack)
 		it->ClearZones();
 
-	// Find the topmost full-screen panel. Nothing below that needs to be drawn.
-	vector<shared_ptr<Panel>>::const_iterator it = stack.end();
-	while(it != stack.begin())
-		if((*--it)->IsFullScreen())
-			break;
-
-	for( ; it != stack.end(); ++it)
+	// A panel may ask to be drawn again while it is being drawn.
+	for(auto it = FirstDrawn(); it != stack.end(); ++it)
+	{
+		(*it)->needsRedraw = false;
 		(*it)->Draw();
+	}
+	needsDraw = false;
 
 	// If the panel has a valid ui element selected, draw a rotating indicator
 	// around it
@@ -316,6 +318,23 @@ void UI::DrawAll()
 
 
 
+// Check whether the panels must be drawn again: the stack has changed, an
+// event has been handled, or one of the panels that would be drawn is not
+// static or has asked to be redrawn.
+bool UI::NeedsDraw() const
+{
+	// The gamepad cursor is animated whenever it is shown.
+	if(needsDraw || !toPush.empty() || !toPop.empty() || GamepadCursor::Enabled())
+		return true;
+
+	for(auto it = FirstDrawn(); it != stack.end(); ++it)
+		if((*it)->NeedsRedraw())
+			return true;
+	return false;
+}
+
+
+
 // Add the given panel to the stack. UI is responsible for deleting it.
 void UI::Push(Panel *panel)
 {
@@ -387,6 +406,7 @@ void UI::Reset()
 	toPush.clear();
 	toPop.clear();
 	isDone = false;
+	needsDraw = true;
 }
 
 
@@ -515,7 +535,10 @@ void UI::PushOrPop()
 {
 	// If panel state is changing, reset the controller cursor state
 	if(!toPush.empty() || !toPop.empty())
+	{
 		GamepadCursor::SetEnabled(false);
+		needsDraw = true;
+	}
 
 	// Handle any panels that should be added.
 	for(shared_ptr<Panel> &panel : toPush)
@@ -539,6 +562,18 @@ void UI::PushOrPop()
 
 
 
+// Find the topmost full-screen panel. Nothing below it needs to be drawn.
+vector<shared_ptr<Panel>>::const_iterator UI::FirstDrawn() const
+{
+	auto it = stack.end();
+	while(it != stack.begin())
+		if((*--it)->IsFullScreen())
+			break;
+	return it;
+}
+
+
+
 // Handle panel button navigation. This is done in the UI class instead of the
 // panel class because we need to know where all the buttons on all the panels
 // are in order to correctly handle navigation.
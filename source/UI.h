@@ -43,6 +43,10 @@ public:
 	void StepAll();
 	// Draw all the panels.
 	void DrawAll();
+	// Check whether the panels must be drawn again: the stack has changed, an
+	// event has been handled, or one of the panels that would be drawn is not
+	// static or has asked to be redrawn.
+	bool NeedsDraw() const;
 
 	// Add the given panel to the stack. If you do not want a panel to be
 	// deleted when it is popped, save a copy of its shared pointer elsewhere.
@@ -85,6 +89,8 @@ public:
 private:
 	// If a push or pop is queued, apply it.
 	void PushOrPop();
+	// Find the topmost full-screen panel. Nothing below it needs to be drawn.
+	std::vector<std::shared_ptr<Panel>>::const_iterator FirstDrawn() const;
 
 	// Default behavior for game controller events
 	bool DefaultControllerTriggerPressed(SDL_GameControllerAxis axis, bool positive);
@@ -98,6 +104,8 @@ private:
 	bool canSave = false;
 	// Whether the player has requested the game to shut down.
 	bool isDone = false;
+	// Whether anything has changed since the panels were last drawn.
+	bool needsDraw = true;
 
 	std::vector<std::shared_ptr<Panel>> stack;
 	std::vector<std::shared_ptr<Panel>> toPush;
@@ -138,6 +138,7 @@ void UiRectShader::Fill(const Point &center, const Point &size, const Color &col
 	glUniform4fv(colorI, 1, color.Get());
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	OpenGL::CountDrawCall();
 
 	glBindVertexArray(0);
 	glUseProgram(0);
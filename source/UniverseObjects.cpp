@@ -206,10 +206,14 @@ void UniverseObjects::UpdateSystems()
 		it.second.UpdateSystem(systems, neighborDistances);
 
 		// If there were changes to a system there might have been a change to a legacy
-		// wormhole which we must handle.
+		// wormhole which we must handle. Only planets in more than one system can be
+		// wormholes, so only those are touched (and so counted as changed).
 		for(const auto &object : it.second.Objects())
-			if(object.GetPlanet())
-				planets.Get(object.GetPlanet()->TrueName())->FinishLoading(wormholes);
+		{
+			const Planet *planet = object.GetPlanet();
+			if(planet && (planet->IsWormhole() || planet->Systems().size() > 1))
+				planets.Get(planet->TrueName())->FinishLoading(wormholes);
+		}
 	}
 }
 
@@ -0,0 +1,305 @@
+/* Etc2Encoder.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Etc2Encoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace {
+	// The EAC alpha modifiers, as in Etc2RGBA.
+	const int ALPHA_MODIFIERS[16][8] = {
+		{-3, -6, -9, -15, 2, 5, 8, 14},
+		{-3, -7, -10, -13, 2, 6, 9, 12},
+		{-2, -5, -8, -13, 1, 4, 7, 12},
+		{-2, -4, -6, -13, 1, 3, 5, 12},
+		{-3, -6, -8, -12, 2, 5, 7, 11},
+		{-3, -7, -9, -11, 2, 6, 8, 10},
+		{-4, -7, -8, -11, 3, 6, 7, 10},
+		{-3, -5, -8, -11, 2, 4, 7, 10},
+		{-2, -6, -8, -10, 1, 5, 7, 9},
+		{-2, -5, -8, -10, 1, 4, 7, 9},
+		{-2, -4, -8, -10, 1, 3, 7, 9},
+		{-2, -5, -7, -10, 1, 4, 6, 9},
+		{-3, -4, -7, -10, 2, 3, 6, 9},
+		{-1, -2, -3, -10, 0, 1, 2, 9},
+		{-4, -6, -8, -9, 3, 5, 7, 8},
+		{-3, -5, -7, -9, 2, 4, 6, 8},
+	};
+	// The ETC1 color modifiers. A pixel's 2-bit index selects +a, +b, -a or -b.
+	const int COLOR_MODIFIERS[8][4] = {
+		{2, 8, -2, -8},
+		{5, 17, -5, -17},
+		{9, 29, -9, -29},
+		{13, 42, -13, -42},
+		{18, 60, -18, -60},
+		{24, 80, -24, -80},
+		{33, 106, -33, -106},
+		{47, 183, -47, -183},
+	};
+
+	int Clamp(int value)
+	{
+		return max(0, min(255, value));
+	}
+
+	// Blocks store their pixels column by column.
+	int Index(int x, int y)
+	{
+		return x * 4 + y;
+	}
+
+	// Choose the EAC base value, multiplier and modifier table that best match
+	// the given alpha values.
+	uint64_t EncodeAlpha(const int alpha[16])
+	{
+		int low = *min_element(alpha, alpha + 16);
+		int high = *max_element(alpha, alpha + 16);
+		// A constant alpha (which most blocks of a sprite are) can be stored
+		// exactly using a table with a zero modifier.
+		if(low == high)
+		{
+			uint64_t bits = static_cast<uint64_t>(low) << 56 | 1ull << 52 | 13ull << 48;
+			for(int i = 0; i < 16; ++i)
+				bits |= 4ull << ((15 - i) * 3);
+			return bits;
+		}
+
+		uint64_t bestBits = 0;
+		int bestError = numeric_limits<int>::max();
+		for(int table = 0; table < 16; ++table)
+		{
+			const int *modifiers = ALPHA_MODIFIERS[table];
+			int range = modifiers[7] - modifiers[3];
+			int estimate = lround(static_cast<double>(high - low) / range);
+			for(int multiplier = max(1, estimate - 1); multiplier <= min(15, estimate + 1); ++multiplier)
+			{
+				// Center the range of the modifiers on the range of the values.
+				int base = Clamp(lround((low + high - (modifiers[7] + modifiers[3]) * multiplier) * .5));
+				int values[8];
+				for(int i = 0; i < 8; ++i)
+					values[i] = Clamp(base + modifiers[i] * multiplier);
+
+				int error = 0;
+				uint64_t bits = static_cast<uint64_t>(base) << 56
+					| static_cast<uint64_t>(multiplier) << 52 | static_cast<uint64_t>(table) << 48;
+				for(int i = 0; i < 16 && error < bestError; ++i)
+				{
+					int best = 0;
+					int bestPixelError = numeric_limits<int>::max();
+					for(int j = 0; j < 8; ++j)
+					{
+						int pixelError = (values[j] - alpha[i]) * (values[j] - alpha[i]);
+						if(pixelError < bestPixelError)
+						{
+							best = j;
+							bestPixelError = pixelError;
+						}
+					}
+					error += bestPixelError;
+					bits |= static_cast<uint64_t>(best) << ((15 - i) * 3);
+				}
+				if(error < bestError)
+				{
+					bestError = error;
+					bestBits = bits;
+				}
+			}
+		}
+		return bestBits;
+	}
+
+	// Find the modifier table and pixel indices that best match the given
+	// pixels to the given base color. Return the error, and add the table and
+	// indices to the block's bits.
+	int EncodeSubblock(const int color[16][3], const int *pixels, const int base[3],
+		int tableShift, uint64_t &bits)
+	{
+		uint64_t bestBits = 0;
+		int bestError = numeric_limits<int>::max();
+		for(int table = 0; table < 8; ++table)
+		{
+			uint64_t tableBits = static_cast<uint64_t>(table) << tableShift;
+			int error = 0;
+			for(int i = 0; i < 8 && error < bestError; ++i)
+			{
+				const int *pixel = color[pixels[i]];
+				int best = 0;
+				int bestPixelError = numeric_limits<int>::max();
+				for(int j = 0; j < 4; ++j)
+				{
+					int modifier = COLOR_MODIFIERS[table][j];
+					int pixelError = 0;
+					for(int c = 0; c < 3; ++c)
+					{
+						int difference = Clamp(base[c] + modifier) - pixel[c];
+						pixelError += difference * difference;
+					}
+					if(pixelError < bestPixelError)
+					{
+						best = j;
+						bestPixelError = pixelError;
+					}
+				}
+				error += bestPixelError;
+				// The high bit of each index is stored in the upper half of the
+				// index bits, and the low bit in the lower half.
+				tableBits |= static_cast<uint64_t>(best >> 1) << (16 + pixels[i])
+					| static_cast<uint64_t>(best & 1) << pixels[i];
+			}
+			if(error < bestError)
+			{
+				bestError = error;
+				bestBits = tableBits;
+			}
+		}
+		bits |= bestBits;
+		return bestError;
+	}
+
+	// Encode the color of a block using the ETC1 "individual" or "differential"
+	// modes, whichever gives the smaller error for either way of splitting the
+	// block into two halves.
+	uint64_t EncodeColor(const int color[16][3])
+	{
+		uint64_t bestBits = 0;
+		int bestError = numeric_limits<int>::max();
+		for(int flip = 0; flip < 2; ++flip)
+		{
+			// Without the flip bit, the halves are the left and right 2x4
+			// pixels. With it, they are the top and bottom 4x2 pixels.
+			int pixels[2][8];
+			double average[2][3] = {};
+			for(int half = 0; half < 2; ++half)
+			{
+				int count = 0;
+				for(int a = 0; a < 2; ++a)
+					for(int b = 0; b < 4; ++b)
+					{
+						int index = flip ? Index(b, 2 * half + a) : Index(2 * half + a, b);
+						pixels[half][count++] = index;
+						for(int c = 0; c < 3; ++c)
+							average[half][c] += color[index][c] * (1. / 8.);
+					}
+			}
+
+			// Individual mode: each half has its own 4-bit base color.
+			{
+				uint64_t bits = static_cast<uint64_t>(flip) << 32;
+				int error = 0;
+				for(int half = 0; half < 2; ++half)
+				{
+					int base[3];
+					for(int c = 0; c < 3; ++c)
+					{
+						int quantized = lround(average[half][c] * 15. / 255.);
+						base[c] = quantized * 17;
+						bits |= static_cast<uint64_t>(quantized) << (60 - 8 * c - 4 * half);
+					}
+					error += EncodeSubblock(color, pixels[half], base, 37 - 3 * half, bits);
+				}
+				if(error < bestError)
+				{
+					bestError = error;
+					bestBits = bits;
+				}
+			}
+
+			// Differential mode: the first half has a 5-bit base color, and the
+			// second is stored as a 3-bit signed difference from it. This only
+			// works if the two colors are close enough together.
+			int quantized[2][3];
+			bool fits = true;
+			for(int c = 0; c < 3; ++c)
+			{
+				quantized[0][c] = lround(average[0][c] * 31. / 255.);
+				quantized[1][c] = lround(average[1][c] * 31. / 255.);
+				int difference = quantized[1][c] - quantized[0][c];
+				fits &= (difference >= -4 && difference <= 3);
+			}
+			if(fits)
+			{
+				uint64_t bits = static_cast<uint64_t>(flip) << 32 | 1ull << 33;
+				for(int c = 0; c < 3; ++c)
+				{
+					int difference = quantized[1][c] - quantized[0][c];
+					bits |= static_cast<uint64_t>(quantized[0][c]) << (59 - 8 * c)
+						| static_cast<uint64_t>(difference & 7) << (56 - 8 * c);
+				}
+				int error = 0;
+				for(int half = 0; half < 2; ++half)
+				{
+					int base[3];
+					for(int c = 0; c < 3; ++c)
+						base[c] = (quantized[half][c] << 3) | (quantized[half][c] >> 2);
+					error += EncodeSubblock(color, pixels[half], base, 37 - 3 * half, bits);
+				}
+				if(error < bestError)
+				{
+					bestError = error;
+					bestBits = bits;
+				}
+			}
+		}
+		return bestBits;
+	}
+
+	void Append(uint64_t bits, string &data)
+	{
+		// Blocks are stored in big endian order.
+		for(int shift = 56; shift >= 0; shift -= 8)
+			data += static_cast<char>((bits >> shift) & 0xFF);
+	}
+}
+
+
+
+// Compress one frame of RGBA pixels, stored as they are in an ImageBuffer,
+// and append the blocks to the given data.
+void Etc2Encoder::Encode(const uint32_t *pixels, int width, int height, string &data)
+{
+	data.reserve(data.size() + Size(width, height));
+	for(int by = 0; by < height; by += 4)
+		for(int bx = 0; bx < width; bx += 4)
+		{
+			int alpha[16];
+			int color[16][3];
+			for(int x = 0; x < 4; ++x)
+				for(int y = 0; y < 4; ++y)
+				{
+					// Blocks that extend past the edge of the image repeat its
+					// last row or column, so that they do not affect the fit.
+					uint32_t pixel = pixels[min(by + y, height - 1) * width + min(bx + x, width - 1)];
+					int index = Index(x, y);
+					alpha[index] = pixel >> 24;
+					color[index][0] = pixel & 0xFF;
+					color[index][1] = (pixel >> 8) & 0xFF;
+					color[index][2] = (pixel >> 16) & 0xFF;
+				}
+			Append(EncodeAlpha(alpha), data);
+			Append(EncodeColor(color), data);
+		}
+}
+
+
+
+// Get the number of bytes one frame of the given size compresses to.
+size_t Etc2Encoder::Size(int width, int height)
+{
+	return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 16;
+}
@@ -0,0 +1,40 @@
+/* Etc2Encoder.h
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ETC2_ENCODER_H_
+#define ETC2_ENCODER_H_
+
+#include <cstdint>
+#include <string>
+
+
+
+// Compresses images into the ETC2 RGBA8 format (GL_COMPRESSED_RGBA8_ETC2_EAC)
+// that Etc2RGBA decodes. Every 4x4 block of pixels becomes 8 bytes of EAC
+// alpha followed by 8 bytes of color. Only the ETC1-compatible color modes are
+// used, which is enough for sprites and keeps the encoder simple, at the cost
+// of some quality compared to a full ETC2 encoder.
+class Etc2Encoder {
+public:
+	// Compress one frame of RGBA pixels, stored as they are in an ImageBuffer,
+	// and append the blocks to the given data.
+	static void Encode(const uint32_t *pixels, int width, int height, std::string &data);
+	// Get the number of bytes one frame of the given size compresses to.
+	static size_t Size(int width, int height);
+};
+
+
+
+#endif
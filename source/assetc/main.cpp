@@ -0,0 +1,387 @@
+/* main.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// es-assetc: the offline asset compiler. This converts the images of the game
+// and of any plugins into ETC2 compressed textures (KTX files), which load much
+// faster and use a quarter of the memory of the decoded images. Each texture
+// includes the smaller mipmap levels that "Reduced graphics" mode uses, and the
+// collision mask outlines of ship and asteroid sprites, so that they do not
+// need to be traced when the game starts.
+
+#include "Etc2Encoder.h"
+
+#include "../Files.h"
+#include "../ImageBuffer.h"
+#include "../ImageCache.h"
+#include "../ImageSet.h"
+#include "../Logger.h"
+#include "../Mask.h"
+#include "../Plugins.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// GL_COMPRESSED_RGBA8_ETC2_EAC and GL_RGBA.
+	constexpr uint32_t INTERNAL_FORMAT = 0x9278;
+	constexpr uint32_t BASE_INTERNAL_FORMAT = 0x1908;
+
+	// The file name suffixes for the 1x, @2x, mask and @2x mask images.
+	const string SUFFIX[4] = {"", "@2x", "@sw", "@sw@2x"};
+
+	// A sprite to compile, the directory its images are in, and the directory
+	// the compiled images go in.
+	struct Job {
+		shared_ptr<ImageSet> images;
+		string sourceDirectory;
+		string outputDirectory;
+	};
+
+	mutex directoryMutex;
+	atomic<int> compiled(0);
+	atomic<int> failed(0);
+
+
+	void PrintHelp()
+	{
+		cerr << endl;
+		cerr << "Command line options:" << endl;
+		cerr << "    -h, --help: print this help message." << endl;
+		cerr << "    -o, --output <path>: write the compiled images under this directory." << endl;
+		cerr << "    -r, --resources <path>: compile the game resources in this directory." << endl;
+		cerr << "    -j, --jobs <count>: number of threads to use (default: one per core)." << endl;
+		cerr << "    -f, --force: compile all images, even if they have not changed." << endl;
+		cerr << "    <path>: also compile the images of the plugin in this directory." << endl;
+		cerr << endl;
+		cerr << "The output directory mirrors the layout of the resources, with the game's images in" << endl;
+		cerr << "images/ and each plugin's in plugins/<name>/images/." << endl;
+		cerr << endl;
+	}
+
+
+	string WithSlash(string path)
+	{
+		if(!path.empty() && path.back() != '/')
+			path += '/';
+		return path;
+	}
+
+
+	bool IsKTX(const string &path)
+	{
+		return path.length() >= 4 && (!path.compare(path.length() - 4, 4, ".ktx")
+			|| !path.compare(path.length() - 4, 4, ".KTX"));
+	}
+
+
+	// Find all the sprites in the given source directory, just as the game does.
+	void AddSource(const string &source, const string &output, vector<Job> &jobs)
+	{
+		string directoryPath = source + "images/";
+		size_t start = directoryPath.size();
+
+		map<string, shared_ptr<ImageSet>> images;
+		for(string &path : Files::RecursiveList(directoryPath))
+			if(ImageSet::IsImage(path))
+			{
+				string name = ImageSet::Name(path.substr(start));
+
+				shared_ptr<ImageSet> &imageSet = images[name];
+				if(!imageSet)
+					imageSet.reset(new ImageSet(name));
+				imageSet->Add(std::move(path));
+			}
+
+		for(auto &it : images)
+			jobs.push_back(Job{std::move(it.second), directoryPath, output + "images/"});
+	}
+
+
+	// Create the directory that the given file will be written to.
+	bool MakeDirectory(const string &path)
+	{
+		string directory = path.substr(0, path.rfind('/'));
+		lock_guard<mutex> lock(directoryMutex);
+		return Files::Exists(directory) || Files::MakeDir(directory);
+	}
+
+
+	// Write the given data to the given path. It is written to a temporary file
+	// first, so that an interrupted build never leaves behind a file that looks
+	// newer than its source images.
+	bool Write(const string &path, const string &data)
+	{
+		if(!MakeDirectory(path))
+			return false;
+
+		// A failed write, like one to a full disk, may still leave part of the
+		// file behind.
+		const string temporary = path + ".tmp";
+		if(!Files::Write(temporary, data))
+		{
+			Files::Delete(temporary);
+			return false;
+		}
+		Files::Move(temporary, path);
+		return Files::Exists(path);
+	}
+
+
+	void AppendValue(string &data, uint32_t value)
+	{
+		data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+
+
+	// Compress the given buffer into a KTX file, including all its frames as
+	// an array texture, and as many mipmap levels as requested.
+	string MakeKTX(ImageBuffer &buffer, bool withMipmaps, const string &maskData)
+	{
+		// Encode the mipmap levels first, because the header needs to say how
+		// many there are. Each level can be made from the one above it.
+		vector<string> levels;
+		const int width = buffer.Width();
+		const int height = buffer.Height();
+		while(true)
+		{
+			levels.emplace_back();
+			for(int frame = 0; frame < buffer.Frames(); ++frame)
+				Etc2Encoder::Encode(buffer.Begin(0, frame), buffer.Width(), buffer.Height(), levels.back());
+
+			if(!withMipmaps || buffer.Width() < 2 || buffer.Height() < 2)
+				break;
+			buffer.ShrinkToHalfSize();
+		}
+
+		// Each key / value pair is preceded by its size, and padded to 4 bytes.
+		string keyValueData;
+		if(!maskData.empty())
+		{
+			string pair = string("es_masks") + '\0' + maskData;
+			AppendValue(keyValueData, pair.size());
+			keyValueData += pair;
+			keyValueData.append(3 - (pair.size() + 3) % 4, '\0');
+		}
+
+		static const char MAGIC[] = {
+			'\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n'
+		};
+		string data(MAGIC, sizeof(MAGIC));
+		AppendValue(data, 0x04030201);
+		// Compressed textures have no type or format, and a type size of 1.
+		AppendValue(data, 0);
+		AppendValue(data, 1);
+		AppendValue(data, 0);
+		AppendValue(data, INTERNAL_FORMAT);
+		AppendValue(data, BASE_INTERNAL_FORMAT);
+		AppendValue(data, width);
+		AppendValue(data, height);
+		// Depth, array elements, faces, and mipmap levels.
+		AppendValue(data, 0);
+		AppendValue(data, buffer.Frames() > 1 ? buffer.Frames() : 0);
+		AppendValue(data, 1);
+		AppendValue(data, levels.size());
+		AppendValue(data, keyValueData.size());
+		data += keyValueData;
+		// ETC2 blocks are 16 bytes, so the levels never need padding.
+		for(const string &level : levels)
+		{
+			AppendValue(data, level.size());
+			data += level;
+		}
+		return data;
+	}
+
+
+	// Compile one sprite, unless its compiled images are newer than its sources.
+	void Compile(Job &job, bool force)
+	{
+		ImageSet &images = *job.images;
+		string prefix = job.outputDirectory + images.Name();
+		try {
+			images.ValidateFrames();
+		}
+		catch(const exception &e)
+		{
+			Logger::LogError(e.what());
+			++failed;
+			return;
+		}
+
+		// Images that are already compressed are copied as they are.
+		bool isCompressed = false;
+		time_t newestSource = 0;
+		for(int i = 0; i < 4; ++i)
+			for(const string &path : images.Paths(i))
+			{
+				isCompressed |= IsKTX(path);
+				newestSource = max(newestSource, Files::Timestamp(path));
+			}
+
+		auto IsUpToDate = [&](const string &output) -> bool {
+			return !force && Files::Exists(output) && Files::Timestamp(output) >= newestSource;
+		};
+
+		if(isCompressed)
+		{
+			for(int i = 0; i < 4; ++i)
+				for(const string &path : images.Paths(i))
+				{
+					string output = job.outputDirectory + path.substr(job.sourceDirectory.length());
+					if(IsUpToDate(output))
+						continue;
+					if(MakeDirectory(output))
+						Files::Copy(path, output);
+					else
+						++failed;
+				}
+			return;
+		}
+
+		bool upToDate = true;
+		for(int i = 0; i < 4; ++i)
+			if(!images.Paths(i).empty())
+				upToDate &= IsUpToDate(prefix + SUFFIX[i] + ".ktx");
+		if(upToDate)
+			return;
+
+		try {
+			images.Load();
+		}
+		catch(const exception &e)
+		{
+			Logger::LogError(e.what());
+			++failed;
+			return;
+		}
+
+		// The game never shrinks the user interface sprites, so they do not
+		// need smaller mipmap levels.
+		bool withMipmaps = images.Name().compare(0, 3, "ui/") != 0;
+		for(int i = 0; i < 4; ++i)
+		{
+			ImageBuffer &buffer = images.Buffer(i);
+			if(!buffer.Pixels() || buffer.CompressedFormat())
+				continue;
+
+			string maskData = (i || images.Masks().empty()) ? string() : ImageCache::MaskData(images.Masks());
+			if(!Write(prefix + SUFFIX[i] + ".ktx", MakeKTX(buffer, withMipmaps, maskData)))
+			{
+				Logger::LogError("Unable to write \"" + prefix + SUFFIX[i] + ".ktx\".");
+				++failed;
+				return;
+			}
+			buffer.Clear();
+		}
+		++compiled;
+	}
+}
+
+
+
+int main(int argc, char *argv[])
+{
+	string output;
+	vector<string> plugins;
+	unsigned jobCount = thread::hardware_concurrency();
+	bool force = false;
+	for(const char *const *it = argv + 1; *it; ++it)
+	{
+		string arg = *it;
+		if(arg == "-h" || arg == "--help")
+		{
+			PrintHelp();
+			return 0;
+		}
+		else if((arg == "-o" || arg == "--output") && it[1])
+			output = WithSlash(*++it);
+		else if((arg == "-j" || arg == "--jobs") && it[1])
+			jobCount = max(1, atoi(*++it));
+		else if(arg == "-f" || arg == "--force")
+			force = true;
+		// These are handled by Files::Init().
+		else if((arg == "-r" || arg == "--resources" || arg == "-c" || arg == "--config") && it[1])
+			++it;
+		else
+			plugins.push_back(WithSlash(arg));
+	}
+	if(output.empty())
+	{
+		cerr << "No output directory given." << endl;
+		PrintHelp();
+		return 1;
+	}
+
+	// The images are only loaded once, so caching them would just fill up the
+	// user's config directory.
+	ImageCache::Disable();
+
+	vector<Job> jobs;
+	try {
+		Files::Init(argv);
+
+		AddSource(Files::Resources(), output, jobs);
+		for(const string &path : Files::ListDirectories(Files::Resources() + "plugins/"))
+			if(Plugins::IsPlugin(path))
+				plugins.push_back(path);
+		for(const string &path : plugins)
+		{
+			if(!Plugins::IsPlugin(path))
+			{
+				Logger::LogError("\"" + path + "\" is not a plugin directory.");
+				return 1;
+			}
+			AddSource(path, output + "plugins/" + Files::Name(path.substr(0, path.length() - 1)) + "/", jobs);
+		}
+	}
+	catch(const runtime_error &error)
+	{
+		Logger::LogError(error.what());
+		return 1;
+	}
+
+	// Compile the sprites on all cores. Each thread takes the next sprite that
+	// nobody has started yet, since they vary greatly in size.
+	atomic<size_t> next(0);
+	auto Work = [&jobs, &next, force]() {
+		for(size_t i = next++; i < jobs.size(); i = next++)
+			Compile(jobs[i], force);
+	};
+	vector<thread> threads;
+	for(unsigned i = 1; i < jobCount; ++i)
+		threads.emplace_back(Work);
+	Work();
+	for(thread &it : threads)
+		it.join();
+
+	cout << "Compiled " << compiled << " of " << jobs.size() << " sprites";
+	if(failed)
+		cout << " (" << failed << " failed)";
+	cout << "." << endl;
+	return failed ? 1 : 0;
+}
@@ -36,6 +36,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Plugins.h"
 #include "Preferences.h"
 #include "PrintData.h"
+#include "SaveWriter.h"
 #include "Screen.h"
 #include "SpriteSet.h"
 #include "SpriteShader.h"
@@ -49,10 +50,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <SDL_events.h>
 #include <SDL_scancode.h>
 #include <chrono>
+#include <ctime>
 #include <iostream>
 #include <map>
+#include <set>
+#include <sstream>
 #include <thread>
 
+#include <algorithm>
 #include <cassert>
 #include <future>
 #include <stdexcept>
@@ -68,6 +73,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 namespace {
 	// The delay in frames when debugging the integration tests.
 	constexpr int UI_DELAY = 60;
+	// When nothing on the screen has changed for this many frames, the game
+	// stops drawing at the full frame rate, and only checks for input every
+	// IDLE_TICK milliseconds.
+	constexpr int IDLE_DELAY = 30;
+	constexpr Uint32 IDLE_TICK = 100;
+	// Even when idle, redraw the screen every this many ticks, in case a static
+	// panel has changed without asking to be redrawn.
+	constexpr int IDLE_REDRAW = 10;
+	// In debug mode, report how much of the time was spent drawing this often.
+	constexpr double PACING_REPORT_SECONDS = 10.;
 }
 
 using namespace std;
@@ -77,6 +92,7 @@ void PrintVersion();
 void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRun, bool debugMode);
 Conversation LoadConversation();
 void PrintTestsTable();
+int ParseSaves(const string &directory);
 #ifdef _WIN32
 void InitConsole();
 #endif
@@ -98,6 +114,7 @@ int main(int argc, char *argv[])
 	bool printData = false;
 	bool noTestMute = false;
 	string testToRunName = "";
+	string saveDirectory;
 
 	// Ensure that we log errors to the errors.txt file.
 	Logger::SetLogErrorCallback([](const string &errorMessage) { Files::LogErrorToFile(errorMessage); });
@@ -121,6 +138,11 @@ int main(int argc, char *argv[])
 			debugMode = true;
 		else if(arg == "-p" || arg == "--parse-save")
 			loadOnly = true;
+		else if(arg == "--parse-saves" && *++it)
+		{
+			loadOnly = true;
+			saveDirectory = *it;
+		}
 		else if(arg == "--test" && *++it)
 			testToRunName = *it;
 		else if(arg == "--tests")
@@ -172,6 +194,9 @@ int main(int argc, char *argv[])
 			GameData::FinishLoading();
 			CrashState::Set(CrashState::LOADED);
 
+			if(!saveDirectory.empty())
+				return ParseSaves(saveDirectory);
+
 			// Reference check the universe, as known to the player. If no player found,
 			// then check the default state of the universe.
 			if(!player.LoadRecent())
@@ -215,6 +240,8 @@ int main(int argc, char *argv[])
 
 		// This is the main loop where all the action begins.
 		GameLoop(player, conversation, testToRunName, debugMode);
+		// Make sure the last save is on the disk before anything is shut down.
+		SaveWriter::Wait();
 	}
 	catch(Test::known_failure_tag)
 	{
@@ -260,6 +287,9 @@ int EventFilter(void* userdata, SDL_Event* event)
 	if (event->type == SDL_APP_DIDENTERBACKGROUND)
 	{
 		Audio::Pause();
+		// The app may be killed at any time while it is in the background, so
+		// finish writing any saves now.
+		SaveWriter::Wait();
 	}
 	else if (event->type == SDL_APP_DIDENTERFOREGROUND)
 	{
@@ -318,6 +348,16 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 	// Limit how quickly full-screen mode can be toggled.
 	int toggleTimeout = 0;
 
+	// Count the frames in which nothing changed, so that static screens are not
+	// drawn again, and the game can wait for input at a low rate.
+	int quietFrames = 0;
+	// In debug mode, measure the CPU time used by the game, and how many of
+	// the frames were drawn.
+	FrameTimer pacingTimer;
+	clock_t pacingClock = clock();
+	int drawnFrames = 0;
+	int skippedFrames = 0;
+
 	// Data to track progress of testing if/when a test is running.
 	TestContext testContext;
 	if(!testToRunName.empty())
@@ -332,8 +372,10 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 
 		// Handle any events that occurred in this frame.
 		SDL_Event event;
+		bool hadEvents = false;
 		while(SDL_PollEvent(&event))
 		{
+			hadEvents = true;
 			UI &activeUI = (menuPanels.IsEmpty() ? gamePanels : menuPanels);
 
 			// If the mouse moves, reset the cursor movement timeout.
@@ -474,6 +516,22 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 			isFastForward = false;
 		}
 
+		// The main menu is shown before all the sprites are loaded. Keep uploading
+		// them while in the menus, and make sure they are all done before the
+		// player starts flying.
+		bool spritesChanged = true;
+		if(dataFinishedLoading && !GameData::IsLoaded())
+		{
+			if(menuPanels.IsEmpty())
+				GameData::FinishLoadingSprites();
+			else
+				GameData::ProcessSprites();
+		}
+		// After that, keep uploading any landscapes that are preloaded, and any
+		// sprites that are loaded again after being unloaded to save memory.
+		else if(dataFinishedLoading)
+			spritesChanged = GameData::ProcessSprites();
+
 		// Tell all the panels to step forward, then draw them.
 		((!isPaused && menuPanels.IsEmpty()) ? gamePanels : menuPanels).StepAll();
 
@@ -539,17 +597,45 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 
 		// Events in this frame may have cleared out the menu, in which case
 		// we should draw the game panels instead:
-		(menuPanels.IsEmpty() ? gamePanels : menuPanels).DrawAll();
-		if(isFastForward)
-			SpriteShader::Draw(SpriteSet::Get("ui/fast forward"), Screen::TopLeft() + Point(10., 10.));
+		UI &drawnUI = (menuPanels.IsEmpty() ? gamePanels : menuPanels);
+		// If all the panels on the screen are static, and nothing has happened
+		// to change them, the last frame that was drawn is still up to date.
+		bool isQuiet = !hadEvents && !spritesChanged && !isFastForward && !testContext.CurrentTest()
+			&& !drawnUI.NeedsDraw();
+		quietFrames = isQuiet ? quietFrames + 1 : 0;
+		bool isIdle = (quietFrames > IDLE_DELAY);
+		if(!isQuiet || (isIdle && !((quietFrames - IDLE_DELAY) % IDLE_REDRAW)))
+		{
+			drawnUI.DrawAll();
+			if(isFastForward)
+				SpriteShader::Draw(SpriteSet::Get("ui/fast forward"), Screen::TopLeft() + Point(10., 10.));
 
-		GameWindow::Step();
+			GameWindow::Step();
+			++drawnFrames;
+		}
+		else
+			++skippedFrames;
 
 		// When we perform automated testing, then we run the game by default as quickly as possible.
-		// Except when debug-mode is set.
-		if(!testContext.CurrentTest() || debugMode)
+		// Except when debug-mode is set. When idle, wake up as soon as there is
+		// any input, but otherwise only check for it a few times a second.
+		if(isIdle)
+			SDL_WaitEventTimeout(nullptr, IDLE_TICK);
+		else if(!testContext.CurrentTest() || debugMode)
 			timer.Wait();
 
+		if(debugMode && pacingTimer.Time() >= PACING_REPORT_SECONDS)
+		{
+			double cpuTime = static_cast<double>(clock() - pacingClock) / CLOCKS_PER_SEC;
+			cerr << "Frame pacing: drew " << drawnFrames << " of " << (drawnFrames + skippedFrames)
+				<< " frames, using " << static_cast<int>(100. * cpuTime / pacingTimer.Time())
+				<< "% CPU time." << endl;
+			pacingTimer = FrameTimer();
+			pacingClock = clock();
+			drawnFrames = 0;
+			skippedFrames = 0;
+		}
+
 		// If the player ended this frame in-game, count the elapsed time as played time.
 		if(menuPanels.IsEmpty())
 			player.AddPlayTime(chrono::steady_clock::now() - start);
@@ -573,6 +659,7 @@ void PrintHelp()
 	cerr << "    -c, --config <path>: save user's files to given directory." << endl;
 	cerr << "    -d, --debug: turn on debugging features (e.g. Caps Lock slows down instead of speeds up)." << endl;
 	cerr << "    -p, --parse-save: load the most recent saved game and inspect it for content errors." << endl;
+	cerr << "    --parse-saves <path>: load every saved game in the given directory and inspect each one." << endl;
 	cerr << "    --tests: print table of available tests, then exit." << endl;
 	cerr << "    --test <name>: run given test from resources directory." << endl;
 	cerr << "    --nomute: don't mute the game while running tests." << endl;
@@ -645,6 +732,77 @@ void PrintTestsTable()
 
 
 
+// Load each saved game in the given directory with a fresh player, reporting
+// the errors found in each one and how long it took. The game data is only
+// loaded once, and the universe is reverted between saves. Return a nonzero
+// exit code if any saved game had errors.
+int ParseSaves(const string &directory)
+{
+	vector<string> messages;
+	Logger::SetLogErrorCallback([&messages](const string &errorMessage) { messages.push_back(errorMessage); });
+
+	// Problems with the game data itself are the same for every saved game, so
+	// they are reported once, before any saved game is loaded, and are not
+	// counted against any of them.
+	GameData::CheckReferences();
+	GameData::StoreReferences();
+	const set<string> dataErrors(messages.begin(), messages.end());
+	for(const string &message : messages)
+		Files::LogErrorToFile(message);
+
+	vector<string> paths = Files::List(directory);
+	sort(paths.begin(), paths.end());
+	int parsed = 0;
+	int failed = 0;
+	chrono::steady_clock::time_point totalStart = chrono::steady_clock::now();
+	for(const string &path : paths)
+	{
+		if(path.length() < 4 || path.compare(path.length() - 4, 4, ".txt"))
+			continue;
+
+		cout << path << endl;
+		messages.clear();
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		{
+			// The errors are printed below, leaving out the ones about the game data.
+			ostringstream logged;
+			streambuf *console = cerr.rdbuf(logged.rdbuf());
+			PlayerInfo player;
+			player.Load(path);
+			cerr.rdbuf(console);
+		}
+		chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+
+		// Anything this saved game referred to that is not defined must be
+		// reported again if the next one refers to it.
+		GameData::Revert();
+		GameData::ForgetNewReferences();
+
+		int errors = 0;
+		for(const string &message : messages)
+			if(!dataErrors.count(message))
+			{
+				++errors;
+				cerr << message << endl;
+				Files::LogErrorToFile(message);
+			}
+
+		++parsed;
+		if(errors)
+			++failed;
+		cout << "    " << (errors ? to_string(errors) + " errors" : "no errors")
+			<< " (" << static_cast<int>(elapsed.count()) << " ms)" << endl;
+	}
+	chrono::duration<double> totalElapsed = chrono::steady_clock::now() - totalStart;
+
+	Logger::SetLogErrorCallback([](const string &errorMessage) { Files::LogErrorToFile(errorMessage); });
+	cout << "Parsed " << parsed << " saved games in " << totalElapsed.count() << " s; "
+		<< failed << " had errors." << endl;
+	return failed ? 1 : 0;
+}
+
+
+
 #ifdef _WIN32
 void InitConsole()
 {
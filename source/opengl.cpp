@@ -25,6 +25,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <cstring>
 
+namespace {
+	int drawCalls = 0;
+	int lastFrameDrawCalls = 0;
+}
+
 #if defined(ES_GLES) || defined(_WIN32)
 namespace {
 	bool HasOpenGLExtension(const char *name)
@@ -62,3 +67,42 @@ bool OpenGL::HasAdaptiveVSyncSupport()
 	return GLX_EXT_swap_control_tear;
 #endif
 }
+
+
+
+bool OpenGL::HasInstancingSupport()
+{
+#if defined(__APPLE__) || defined(ES_GLES)
+	// Instanced drawing is part of OpenGL ES 3.0 and of every core profile
+	// that macOS provides.
+	return true;
+#else
+	// glVertexAttribDivisor() is new in OpenGL 3.3.
+	return GLEW_VERSION_3_3;
+#endif
+}
+
+
+
+// Count the draw calls made each frame, so that the CPU / GPU load display
+// can show how many draw calls the last complete frame needed.
+void OpenGL::CountDrawCall()
+{
+	++drawCalls;
+}
+
+
+
+int OpenGL::DrawCalls()
+{
+	return lastFrameDrawCalls;
+}
+
+
+
+// Mark the end of a frame, once it has been drawn.
+void OpenGL::EndFrame()
+{
+	lastFrameDrawCalls = drawCalls;
+	drawCalls = 0;
+}
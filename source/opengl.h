@@ -32,6 +32,14 @@ class OpenGL
 {
 public:
 	static bool HasAdaptiveVSyncSupport();
+	static bool HasInstancingSupport();
+
+	// Count the draw calls made each frame, so that the CPU / GPU load display
+	// can show how many draw calls the last complete frame needed.
+	static void CountDrawCall();
+	static int DrawCalls();
+	// Mark the end of a frame, once it has been drawn.
+	static void EndFrame();
 };
 
 
@@ -32,51 +32,54 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 using namespace std;
 
 namespace {
+	const PreferenceFlag ALWAYS_UNDERLINE_SHORTCUTS("Always underline shortcuts");
+
 	bool showUnderlines = false;
 
 	const char *vertexCode =
 		"// vertex font shader\n"
 		// "scale" maps pixel coordinates to GL coordinates (-1 to 1).
 		"uniform vec2 scale;\n"
-		// The (x, y) coordinates of the top left corner of the glyph.
-		"uniform vec2 position;\n"
-		// The glyph to draw. (ASCII value - 32).
-		"uniform int glyph;\n"
-		// Aspect ratio of rendered glyph (unity by default).
-		"uniform float aspect;\n"
-
-		// Inputs from the VBO.
+
+		// Inputs from the VBO: the corner of a glyph in pixel coordinates, the
+		// corresponding point in the font texture, and the text color.
 		"in vec2 vert;\n"
 		"in vec2 corner;\n"
+		"in vec4 color;\n"
 
 		// Output to the fragment shader.
 		"out vec2 texCoord;\n"
+		"out vec4 fragColor;\n"
 
-		// Pick the proper glyph out of the texture.
 		"void main() {\n"
-		"  texCoord = vec2((float(glyph) + corner.x) / 98.f, corner.y);\n"
-		"  gl_Position = vec4((aspect * vert.x + position.x) * scale.x, (vert.y + position.y) * scale.y, 0.f, 1.f);\n"
+		"  texCoord = corner;\n"
+		"  fragColor = color;\n"
+		"  gl_Position = vec4(vert * scale, 0.f, 1.f);\n"
 		"}\n";
 
 	const char *fragmentCode =
 		"// fragment font shader\n"
 		"precision mediump float;\n"
-		// The user must supply a texture and a color (white by default).
+		// The user must supply a texture.
 		"uniform sampler2D tex;\n"
-		"uniform vec4 color;\n"
 
 		// This comes from the vertex shader.
 		"in vec2 texCoord;\n"
+		"in vec4 fragColor;\n"
 
 		// Output color.
 		"out vec4 finalColor;\n"
 
 		// Multiply the texture by the user-specified color (including alpha).
 		"void main() {\n"
-		"  finalColor = texture(tex, texCoord).a * color;\n"
+		"  finalColor = texture(tex, texCoord).a * fragColor;\n"
 		"}\n";
 
 	const int KERN = 2;
+	// Each glyph is drawn as two triangles, and each of their corners has an
+	// (x, y) position, an (s, t) texture coordinate and an RGBA color.
+	const int VERTEX_SIZE = 8;
+	const int GLYPH_SIZE = 6 * VERTEX_SIZE;
 }
 
 
@@ -138,21 +141,8 @@ void Font::Draw(const string &str, const Point &point, const Color &color) const
 
 void Font::DrawAliased(const string &str, double x, double y, const Color &color) const
 {
-	glUseProgram(shader.Object());
-	glBindTexture(GL_TEXTURE_2D, texture);
-	glBindVertexArray(vao);
-
-	glUniform4fv(colorI, 1, color.Get());
-
-	// Update the scale, only if the screen size has changed.
-	if(Screen::Width() != screenWidth || Screen::Height() != screenHeight)
-	{
-		screenWidth = Screen::Width();
-		screenHeight = Screen::Height();
-		GLfloat scale[2] = {2.f / screenWidth, -2.f / screenHeight};
-		glUniform2fv(scaleI, 1, scale);
-	}
-
+	// Add a quad for each of the glyphs to the vertex data, and only draw them
+	// once this string (or the whole batch it is part of) is done.
 	GLfloat textPos[2] = {
 		static_cast<float>(x - 1.),
 		static_cast<float>(y)};
@@ -178,31 +168,39 @@ void Font::DrawAliased(const string &str, double x, double y, const Color &color
 			continue;
 		}
 
-		glUniform1i(glyphI, glyph);
-		glUniform1f(aspectI, 1.f);
-
 		textPos[0] += advance[previous * GLYPHS + glyph] + KERN;
-		glUniform2fv(positionI, 1, textPos);
-
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		AddGlyph(glyph, textPos, 1.f, color);
 
 		if(underlineChar)
 		{
-			glUniform1i(glyphI, underscoreGlyph);
-			glUniform1f(aspectI, static_cast<float>(advance[glyph * GLYPHS] + KERN)
-				/ (advance[underscoreGlyph * GLYPHS] + KERN));
-
-			glUniform2fv(positionI, 1, textPos);
-
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			AddGlyph(underscoreGlyph, textPos, static_cast<float>(advance[glyph * GLYPHS] + KERN)
+				/ (advance[underscoreGlyph * GLYPHS] + KERN), color);
 			underlineChar = false;
 		}
 
 		previous = glyph;
 	}
 
-	glBindVertexArray(0);
-	glUseProgram(0);
+	if(!batchDepth)
+		Flush();
+}
+
+
+
+// While a batch is open, text drawn with this font is collected rather than
+// drawn, and all of it is drawn with a single draw call once the outermost
+// batch is closed. Nothing else may be drawn until then.
+void Font::BeginBatch() const
+{
+	++batchDepth;
+}
+
+
+
+void Font::EndBatch() const
+{
+	if(batchDepth && !--batchDepth)
+		Flush();
 }
 
 
@@ -239,7 +237,7 @@ int Font::Space() const noexcept
 
 void Font::ShowUnderlines(bool show) noexcept
 {
-	showUnderlines = show || Preferences::Has("Always underline shortcuts");
+	showUnderlines = show || ALWAYS_UNDERLINE_SHORTCUTS.Has();
 }
 
 
@@ -347,31 +345,24 @@ void Font::CalculateAdvances(ImageBuffer &image)
 
 void Font::SetUpShader(float glyphW, float glyphH)
 {
-	glyphW *= .5f;
-	glyphH *= .5f;
+	glyphWidth = glyphW * .5f;
+	glyphHeight = glyphH * .5f;
 
 	shader = Shader(vertexCode, fragmentCode);
 	glUseProgram(shader.Object());
 	glUniform1i(shader.Uniform("tex"), 0);
 	glUseProgram(0);
 
-	// Create the VAO and VBO.
+	// Create the VAO and VBO. The vertex data is streamed into the VBO each
+	// time text is drawn.
 	glGenVertexArrays(1, &vao);
 	glBindVertexArray(vao);
 
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
-	GLfloat vertices[] = {
-		   0.f,    0.f, 0.f, 0.f,
-		   0.f, glyphH, 0.f, 1.f,
-		glyphW,    0.f, 1.f, 0.f,
-		glyphW, glyphH, 1.f, 1.f
-	};
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
 	// Connect the xy to the "vert" attribute of the vertex shader.
-	constexpr auto stride = 4 * sizeof(GLfloat);
+	constexpr auto stride = VERTEX_SIZE * sizeof(GLfloat);
 	glEnableVertexAttribArray(shader.Attrib("vert"));
 	glVertexAttribPointer(shader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, stride, nullptr);
 
@@ -379,6 +370,10 @@ void Font::SetUpShader(float glyphW, float glyphH)
 	glVertexAttribPointer(shader.Attrib("corner"), 2, GL_FLOAT, GL_FALSE,
 		stride, reinterpret_cast<const GLvoid *>(2 * sizeof(GLfloat)));
 
+	glEnableVertexAttribArray(shader.Attrib("color"));
+	glVertexAttribPointer(shader.Attrib("color"), 4, GL_FLOAT, GL_FALSE,
+		stride, reinterpret_cast<const GLvoid *>(4 * sizeof(GLfloat)));
+
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
 
@@ -386,11 +381,70 @@ void Font::SetUpShader(float glyphW, float glyphH)
 	screenWidth = 0;
 	screenHeight = 0;
 
-	colorI = shader.Uniform("color");
 	scaleI = shader.Uniform("scale");
-	glyphI = shader.Uniform("glyph");
-	aspectI = shader.Uniform("aspect");
-	positionI = shader.Uniform("position");
+}
+
+
+
+// Add the vertices for one glyph, with its top left corner at the given
+// position and its width scaled by the given aspect ratio.
+void Font::AddGlyph(int glyph, const GLfloat position[2], float aspect, const Color &color) const
+{
+	const float left = position[0];
+	const float right = position[0] + aspect * glyphWidth;
+	const float top = position[1];
+	const float bottom = position[1] + glyphHeight;
+	// Pick the proper glyph out of the texture.
+	const float sLeft = static_cast<float>(glyph) / GLYPHS;
+	const float sRight = static_cast<float>(glyph + 1) / GLYPHS;
+	const float *rgba = color.Get();
+
+	const GLfloat corners[6][4] = {
+		{left, top, sLeft, 0.f},
+		{left, bottom, sLeft, 1.f},
+		{right, top, sRight, 0.f},
+		{right, top, sRight, 0.f},
+		{left, bottom, sLeft, 1.f},
+		{right, bottom, sRight, 1.f},
+	};
+	vertices.reserve(vertices.size() + GLYPH_SIZE);
+	for(const GLfloat *corner : corners)
+	{
+		vertices.insert(vertices.end(), corner, corner + 4);
+		vertices.insert(vertices.end(), rgba, rgba + 4);
+	}
+}
+
+
+
+// Draw all the glyphs that have been added since the last time.
+void Font::Flush() const
+{
+	if(vertices.empty())
+		return;
+
+	glUseProgram(shader.Object());
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	// Update the scale, only if the screen size has changed.
+	if(Screen::Width() != screenWidth || Screen::Height() != screenHeight)
+	{
+		screenWidth = Screen::Width();
+		screenHeight = Screen::Height();
+		GLfloat scale[2] = {2.f / screenWidth, -2.f / screenHeight};
+		glUniform2fv(scaleI, 1, scale);
+	}
+
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STREAM_DRAW);
+	glDrawArrays(GL_TRIANGLES, 0, vertices.size() / VERTEX_SIZE);
+	OpenGL::CountDrawCall();
+	vertices.clear();
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+	glUseProgram(0);
 }
 
 
@@ -21,6 +21,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "../opengl.h"
 
 #include <string>
+#include <vector>
 
 class Color;
 class DisplayText;
@@ -46,6 +47,11 @@ public:
 	// Draw the given text string, e.g. post-formatting (or without regard to formatting).
 	void Draw(const std::string &str, const Point &point, const Color &color) const;
 	void DrawAliased(const std::string &str, double x, double y, const Color &color) const;
+	// While a batch is open, text drawn with this font is collected rather than
+	// drawn, and all of it is drawn with a single draw call once the outermost
+	// batch is closed. Nothing else may be drawn until then.
+	void BeginBatch() const;
+	void EndBatch() const;
 
 	// Determine the string's width, without considering formatting.
 	int Width(const std::string &str, char after = ' ') const;
@@ -64,6 +70,11 @@ private:
 	void LoadTexture(ImageBuffer &image);
 	void CalculateAdvances(ImageBuffer &image);
 	void SetUpShader(float glyphW, float glyphH);
+	// Add the vertices for one glyph, with its top left corner at the given
+	// position and its width scaled by the given aspect ratio.
+	void AddGlyph(int glyph, const GLfloat position[2], float aspect, const Color &color) const;
+	// Draw all the glyphs that have been added since the last time.
+	void Flush() const;
 
 	int WidthRawString(const char *str, char after = ' ') const noexcept;
 
@@ -79,11 +90,12 @@ private:
 	GLuint vao = 0;
 	GLuint vbo = 0;
 
-	GLint colorI = 0;
 	GLint scaleI = 0;
-	GLint glyphI = 0;
-	GLint aspectI = 0;
-	GLint positionI = 0;
+
+	float glyphWidth = 0.f;
+	float glyphHeight = 0.f;
+	mutable std::vector<GLfloat> vertices;
+	mutable int batchDepth = 0;
 
 	int height = 0;
 	int space = 0;
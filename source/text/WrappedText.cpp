@@ -157,6 +157,8 @@ void WrappedText::Draw(const Point &topLeft, const Color &color) const
 	
 	animateScrollY.Step(scrollY);
 
+	// All the words are drawn together, with a single draw call.
+	font->BeginBatch();
 	if(truncate == Truncate::NONE)
 	{
 		double maxY = visibleHeight + topLeft.Y() - font->Height();
@@ -187,6 +189,7 @@ void WrappedText::Draw(const Point &topLeft, const Color &color) const
 			h = w.y;
 		}
 	}
+	font->EndBatch();
 }
 
 
@@ -86,6 +86,9 @@ public:
 	void DoScroll(int dY) { SetScroll(scrollY + dY); }
 	bool CanScrollUp() const { return scrollY > 0; }
 	bool CanScrollDown() const { return visibleHeight != -1 && scrollY < height - visibleHeight; }
+	// Check if the text is still moving towards the last scroll position, and
+	// so must be drawn again.
+	bool IsScrolling() const { return animateScrollY.IsAnimating(); }
 
 private:
 	void SetText(const char *it, size_t length);
@@ -0,0 +1,62 @@
+/* temporary-directory.hpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ES_TEST_HELPER_TEMPORARY_DIRECTORY_HPP_
+#define ES_TEST_HELPER_TEMPORARY_DIRECTORY_HPP_
+
+#include "../../../source/Files.h"
+
+#include <cstdlib>
+#include <random>
+#include <string>
+
+class TemporaryDirectory {
+public:
+	// Create an empty directory in the system's temporary directory, for tests
+	// that need to read and write real files.
+	TemporaryDirectory()
+	{
+		const char *base = std::getenv("TMPDIR");
+		if(!base)
+			base = std::getenv("TEMP");
+		path = std::string(base ? base : "/tmp");
+		if(path.back() != '/' && path.back() != '\\')
+			path += '/';
+		path += "endless-sky-test-" + std::to_string(std::random_device()()) + "/";
+		Files::CreateFolder(path);
+	}
+
+	// Delete the directory and the files in it.
+	~TemporaryDirectory()
+	{
+		for(const std::string &file : Files::RecursiveList(path))
+			Files::Delete(file);
+		Files::RmDir(path);
+	}
+	// No moves/copies.
+	TemporaryDirectory(const TemporaryDirectory &) = delete;
+	TemporaryDirectory(TemporaryDirectory &&) = delete;
+
+	// Get the path of the directory, ending in a slash.
+	const std::string &Path() const { return path; }
+
+
+private:
+	std::string path;
+};
+
+
+
+#endif
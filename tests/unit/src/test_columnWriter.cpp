@@ -0,0 +1,126 @@
+/* test_columnWriter.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/ColumnWriter.h"
+
+// ... and any system includes needed for the test file.
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+
+// Read the values back out of a file, in the way another program would.
+class Reader {
+public:
+	explicit Reader(const std::string &data) : data(data) {}
+
+	std::string Bytes(size_t count)
+	{
+		std::string result = data.substr(pos, count);
+		pos += count;
+		return result;
+	}
+	uint8_t Byte()
+	{
+		return static_cast<uint8_t>(data[pos++]);
+	}
+	uint32_t Uint32()
+	{
+		uint32_t value = 0;
+		for(int i = 0; i < 4; ++i)
+			value |= static_cast<uint32_t>(Byte()) << (8 * i);
+		return value;
+	}
+	double Float64()
+	{
+		uint64_t bits = 0;
+		for(int i = 0; i < 8; ++i)
+			bits |= static_cast<uint64_t>(Byte()) << (8 * i);
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+	std::string String()
+	{
+		return Bytes(Uint32());
+	}
+	bool AtEnd() const
+	{
+		return pos == data.size();
+	}
+
+private:
+	const std::string &data;
+	size_t pos = 0;
+};
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Writing tables column by column", "[ColumnWriter]" ) {
+	GIVEN( "a file with two tables" ) {
+		ColumnWriter writer(2);
+		writer.BeginTable("ships", 2, 2);
+		writer.WriteColumn("model", std::vector<std::string>{"Shuttle", "Bactrian"});
+		writer.WriteColumn("cost", std::vector<double>{180000., -.5});
+		writer.BeginTable("outfits", 0, 1);
+		writer.WriteColumn("name", std::vector<std::string>{});
+
+		WHEN( "the file is read back" ) {
+			Reader reader(writer.Data());
+			THEN( "it starts with the magic string and the number of tables" ) {
+				CHECK( reader.Bytes(8) == "ESTABLE1" );
+				CHECK( reader.Uint32() == 2 );
+			}
+			AND_THEN( "each table holds the columns that were written" ) {
+				reader.Bytes(8);
+				reader.Uint32();
+
+				CHECK( reader.String() == "ships" );
+				CHECK( reader.Uint32() == 2 );
+				CHECK( reader.Uint32() == 2 );
+				CHECK( reader.String() == "model" );
+				CHECK( reader.Byte() == ColumnWriter::TEXT );
+				CHECK( reader.String() == "Shuttle" );
+				CHECK( reader.String() == "Bactrian" );
+				CHECK( reader.String() == "cost" );
+				CHECK( reader.Byte() == ColumnWriter::NUMBER );
+				CHECK( reader.Float64() == 180000. );
+				CHECK( reader.Float64() == -.5 );
+
+				CHECK( reader.String() == "outfits" );
+				CHECK( reader.Uint32() == 0 );
+				CHECK( reader.Uint32() == 1 );
+				CHECK( reader.String() == "name" );
+				CHECK( reader.Byte() == ColumnWriter::TEXT );
+				CHECK( reader.AtEnd() );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,152 @@
+/* test_dataStream.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/DataStream.h"
+
+// Include helpers for capturing traces and creating files to read.
+#include "output-capture.hpp"
+#include "temporary-directory.hpp"
+#include "../../../source/DataFile.h"
+#include "../../../source/DataNode.h"
+#include "../../../source/GzipFile.h"
+
+// ... and any system includes needed for the test file.
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+
+const std::string text = R"(# A comment before the first node.
+pilot "Test Pilot"
+date 16 11 3013
+
+ship Shuttle
+	name "Bad Idea"
+	# A comment inside a node.
+	attributes
+		category Transport
+		"hull repair rate" 0.5
+
+	outfits
+		"Hyperdrive"
+account
+	credits 12345
+)";
+
+// Print the trace of the given node and of each of its children, which shows
+// their tokens and line numbers and those of all their parents.
+void Trace(const DataNode &node, OutputSink &traces, std::vector<std::string> &result)
+{
+	node.PrintTrace();
+	result.push_back(traces.Flush());
+	for(const DataNode &child : node)
+		Trace(child, traces, result);
+}
+
+// Get the traces of all the nodes in the given file.
+std::vector<std::string> Trace(const DataFile &file)
+{
+	OutputSink traces(std::cerr);
+	std::vector<std::string> result;
+	for(const DataNode &node : file)
+		Trace(node, traces, result);
+	return result;
+}
+
+// Get the traces of all the nodes in the given stream.
+std::vector<std::string> Trace(DataStream &stream)
+{
+	OutputSink traces(std::cerr);
+	std::vector<std::string> result;
+	while(stream.Next())
+		Trace(stream.Node(), traces, result);
+	return result;
+}
+
+// Make a file that is much larger than the blocks it is read in.
+std::string MakeLargeText()
+{
+	std::string result = text;
+	for(int i = 0; i < 500; ++i)
+		result += "ship \"Ship " + std::to_string(i) + "\"\n\tattributes\n\t\tmass " + std::to_string(i) + "\n";
+	return result;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Reading a data file one top-level node at a time", "[DataStream]" ) {
+	GIVEN( "text that is already in memory" ) {
+		std::istringstream in(text);
+		DataFile file(in);
+		DataStream stream(text.data(), text.size());
+		THEN( "the nodes and their children match those read by DataFile" ) {
+			std::vector<std::string> expected = Trace(file);
+			REQUIRE( expected.size() == 11 );
+			std::vector<std::string> result = Trace(stream);
+			CHECK( result == expected );
+			AND_THEN( "nested nodes know their parents and line numbers" ) {
+				REQUIRE( result.size() == 11 );
+				CHECK( result[6] == "L5:   ship Shuttle\nL8:     attributes\nL10:       \"hull repair rate\" 0.5\n" );
+			}
+		}
+	}
+	GIVEN( "a file that is read in many blocks" ) {
+		TemporaryDirectory directory;
+		const std::string path = directory.Path() + "save.txt";
+		const std::string largeText = MakeLargeText();
+		REQUIRE( Files::Write(path, largeText) );
+
+		THEN( "the nodes and their children match those read by DataFile" ) {
+			DataFile file(path);
+			DataStream stream(path);
+			CHECK( Trace(stream) == Trace(file) );
+		}
+		AND_THEN( "the same is true if the file is compressed" ) {
+			REQUIRE( GzipFile::Write(path, largeText) );
+			DataFile file(path);
+			DataStream stream(path);
+			CHECK( Trace(stream) == Trace(file) );
+		}
+	}
+	GIVEN( "nodes that are skipped" ) {
+		DataStream stream(text.data(), text.size());
+		THEN( "only nodes with the given key are skipped" ) {
+			CHECK_FALSE( stream.Skip("ship") );
+			REQUIRE( stream.Next() );
+			CHECK( stream.Node().Token(0) == "pilot" );
+			REQUIRE( stream.Next() );
+			CHECK( stream.Node().Token(0) == "date" );
+			CHECK( stream.Skip("ship") );
+			REQUIRE( stream.Next() );
+			CHECK( stream.Node().Token(0) == "account" );
+			CHECK_FALSE( stream.Next() );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,107 @@
+/* test_etc2Encoder.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/assetc/Etc2Encoder.h"
+
+// ... and the decoder that the encoded textures are checked with.
+#include "../../../source/Etc2RGBA.h"
+
+// ... and any system includes needed for the test file.
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+
+// Make a frame whose alpha is given by the given function, with some color
+// that the alpha must not depend on.
+template <class F>
+std::vector<uint32_t> MakeFrame(int width, int height, F alpha)
+{
+	std::vector<uint32_t> pixels(width * height);
+	for(int y = 0; y < height; ++y)
+		for(int x = 0; x < width; ++x)
+			pixels[x + y * width] = static_cast<uint32_t>(alpha(x, y)) << 24
+				| static_cast<uint32_t>(x * 37 & 0xFF) << 16 | static_cast<uint32_t>(y * 53 & 0xFF) << 8 | 0x40;
+	return pixels;
+}
+
+// Get the largest difference between the alpha of the given pixels and the
+// alpha decoded from the given frame of the texture.
+int MaxAlphaError(const std::vector<uint32_t> &pixels, const Etc2RGBA &etc, int frame, int width, int height)
+{
+	int error = 0;
+	for(int y = 0; y < height; ++y)
+		for(int x = 0; x < width; ++x)
+			error = std::max(error, std::abs(etc.Alpha(frame, x, y) - static_cast<int>(pixels[x + y * width] >> 24)));
+	return error;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Encoding the alpha channel of an ETC2 texture", "[Etc2Encoder]" ) {
+	GIVEN( "two frames whose size is not a multiple of the block size" ) {
+		const int width = 7;
+		const int height = 5;
+
+		// The first frame has transparent, opaque and partly transparent blocks.
+		std::vector<uint32_t> constant = MakeFrame(width, height,
+			[](int x, int y) -> int { return x < 4 ? (y < 4 ? 0 : 255) : 128; });
+		// The second frame is a smooth gradient.
+		std::vector<uint32_t> gradient = MakeFrame(width, height,
+			[](int x, int y) -> int { return 20 * x + 10 * y; });
+
+		std::string data;
+		Etc2Encoder::Encode(constant.data(), width, height, data);
+		Etc2Encoder::Encode(gradient.data(), width, height, data);
+
+		THEN( "each frame is the expected size" ) {
+			CHECK( Etc2Encoder::Size(width, height) == 2 * 2 * 16 );
+			CHECK( data.size() == 2 * Etc2Encoder::Size(width, height) );
+		}
+		WHEN( "the texture is decoded again" ) {
+			Etc2RGBA etc(data.data(), width, height);
+			THEN( "blocks with a single alpha value are decoded exactly" ) {
+				CHECK( MaxAlphaError(constant, etc, 0, width, height) == 0 );
+			}
+			AND_THEN( "blocks with varying alpha are decoded closely" ) {
+				// Each block of the gradient spans 90 alpha values, and only has
+				// eight values to choose from.
+				CHECK( MaxAlphaError(gradient, etc, 1, width, height) <= 8 );
+			}
+			AND_THEN( "decoding the whole frame gives the same result" ) {
+				std::vector<uint8_t> plane(width * height);
+				etc.AlphaPlane(1, plane.data());
+				for(int y = 0; y < height; ++y)
+					for(int x = 0; x < width; ++x)
+						CHECK( plane[x + y * width] == etc.Alpha(1, x, y) );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
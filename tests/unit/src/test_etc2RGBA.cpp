@@ -0,0 +1,117 @@
+/* test_etc2RGBA.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/Etc2RGBA.h"
+
+// ... and any system includes needed for the test file.
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+
+// Decode a single EAC alpha value directly from the specification, to check
+// the decoder's results against.
+int ReferenceAlpha(const std::vector<uint8_t> &data, int blockWidth, int blockHeight, int frame, int x, int y)
+{
+	static const int modifiers[16][8] = {
+		{ -3,  -6,  -9, -15,  2,  5,  8, 14 },
+		{ -3,  -7, -10, -13,  2,  6,  9, 12 },
+		{ -2,  -5,  -8, -13,  1,  4,  7, 12 },
+		{ -2,  -4,  -6, -13,  1,  3,  5, 12 },
+		{ -3,  -6,  -8, -12,  2,  5,  7, 11 },
+		{ -3,  -7,  -9, -11,  2,  6,  8, 10 },
+		{ -4,  -7,  -8, -11,  3,  6,  7, 10 },
+		{ -3,  -5,  -8, -11,  2,  4,  7, 10 },
+		{ -2,  -6,  -8, -10,  1,  5,  7,  9 },
+		{ -2,  -5,  -8, -10,  1,  4,  7,  9 },
+		{ -2,  -4,  -8, -10,  1,  3,  7,  9 },
+		{ -2,  -5,  -7, -10,  1,  4,  6,  9 },
+		{ -3,  -4,  -7, -10,  2,  3,  6,  9 },
+		{ -1,  -2,  -3, -10,  0,  1,  2,  9 },
+		{ -4,  -6,  -8,  -9,  3,  5,  7,  8 },
+		{ -3,  -5,  -7,  -9,  2,  4,  6,  8 },
+	};
+	// Each block is 16 bytes: 8 bytes of big-endian alpha, then 8 of color.
+	const uint8_t *block = data.data() + 16 * (blockWidth * blockHeight * frame + blockWidth * (y / 4) + x / 4);
+	uint64_t bits = 0;
+	for(int i = 0; i < 8; ++i)
+		bits = (bits << 8) | block[i];
+
+	int base = block[0];
+	int multiplier = block[1] >> 4;
+	int table = block[1] & 0xF;
+	int index = (bits >> (45 - 3 * (4 * (x % 4) + y % 4))) & 7;
+	int value = base + modifiers[table][index] * multiplier;
+	return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Decoding the alpha channel of an ETC2 texture", "[Etc2RGBA]" ) {
+	GIVEN( "a two-frame texture whose size is not a multiple of the block size" ) {
+		const int width = 7;
+		const int height = 5;
+		const int frames = 2;
+		const int blockWidth = 2;
+		const int blockHeight = 2;
+
+		std::mt19937 random(12345);
+		std::uniform_int_distribution<int> byte(0, 255);
+		std::vector<uint8_t> data(16 * blockWidth * blockHeight * frames);
+		for(uint8_t &b : data)
+			b = byte(random);
+		// Make sure the extreme values are clamped.
+		data[0] = 0;
+		data[16] = 255;
+		data[17] = 0xF0;
+
+		Etc2RGBA etc(data.data(), width, height);
+
+		WHEN( "decoding one pixel at a time" ) {
+			THEN( "every pixel matches the specification" ) {
+				for(int frame = 0; frame < frames; ++frame)
+					for(int y = 0; y < height; ++y)
+						for(int x = 0; x < width; ++x)
+							CHECK( etc.Alpha(frame, x, y) == ReferenceAlpha(data, blockWidth, blockHeight, frame, x, y) );
+			}
+		}
+		WHEN( "decoding a whole frame at once" ) {
+			THEN( "every pixel of the plane matches the specification" ) {
+				for(int frame = 0; frame < frames; ++frame)
+				{
+					std::vector<uint8_t> plane(width * height);
+					etc.AlphaPlane(frame, plane.data());
+					for(int y = 0; y < height; ++y)
+						for(int x = 0; x < width; ++x)
+							CHECK( plane[x + y * width] == ReferenceAlpha(data, blockWidth, blockHeight, frame, x, y) );
+				}
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
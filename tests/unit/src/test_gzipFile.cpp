@@ -0,0 +1,94 @@
+/* test_gzipFile.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include a helper for creating files to read.
+#include "temporary-directory.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/GzipFile.h"
+
+// ... and any system includes needed for the test file.
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+
+// Make some text that looks like a saved game, and is long enough to be
+// compressed and read in more than one block.
+std::string MakeText()
+{
+	std::string text = "pilot Test Pilot\ndate 16 11 3013\n";
+	for(int i = 0; i < 5000; ++i)
+		text += "ship \"Ship " + std::to_string(i) + "\"\n\tattributes\n\t\tmass " + std::to_string(i * 7 % 1000) + "\n";
+	return text;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Reading files that may be compressed", "[GzipFile]" ) {
+	TemporaryDirectory directory;
+	const std::string path = directory.Path() + "save.txt";
+	const std::string text = MakeText();
+
+	GIVEN( "a file written with compression" ) {
+		REQUIRE( GzipFile::Write(path, text) );
+		THEN( "the file is compressed" ) {
+			std::string contents = Files::Read(path);
+			REQUIRE( contents.size() >= 2 );
+			CHECK( static_cast<unsigned char>(contents[0]) == 0x1F );
+			CHECK( static_cast<unsigned char>(contents[1]) == 0x8B );
+			CHECK( contents.size() < text.size() );
+		}
+		THEN( "reading it gives back the same text" ) {
+			CHECK( GzipFile::Read(path) == text );
+		}
+		THEN( "reading it in small pieces gives back the same text" ) {
+			GzipFile file(path);
+			std::string result;
+			char buffer[1000];
+			while(size_t count = file.Read(buffer, sizeof(buffer)))
+				result.append(buffer, count);
+			CHECK( result == text );
+		}
+	}
+	GIVEN( "a file written as plain text" ) {
+		REQUIRE( Files::Write(path, text) );
+		THEN( "reading it gives back the same text" ) {
+			CHECK( GzipFile::Read(path) == text );
+		}
+	}
+	GIVEN( "an empty file" ) {
+		REQUIRE( Files::Write(path, "") );
+		THEN( "reading it gives back nothing" ) {
+			CHECK( GzipFile::Read(path).empty() );
+		}
+	}
+	GIVEN( "a file that does not exist" ) {
+		THEN( "reading it gives back nothing" ) {
+			CHECK( GzipFile::Read(directory.Path() + "missing.txt").empty() );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,154 @@
+/* test_imageCache.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/ImageCache.h"
+
+// Include helpers for creating the files to read.
+#include "temporary-directory.hpp"
+#include "../../../source/Files.h"
+#include "../../../source/ImageBuffer.h"
+
+// ... and any system includes needed for the test file.
+#include <cstdint>
+#include <ctime>
+#include <string>
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+namespace { // test namespace
+
+// #region mock data
+
+// The cache is kept in the config directory, so the game's directories must
+// be set up, with the bare minimum of resources.
+void InitFiles(const TemporaryDirectory &directory)
+{
+	const std::string resources = directory.Path() + "resources/";
+	const std::string config = directory.Path() + "config/";
+	Files::CreateFolder(resources);
+	Files::CreateFolder(resources + "data/");
+	Files::CreateFolder(resources + "images/");
+	Files::CreateFolder(resources + "sounds/");
+	Files::Write(resources + "credits.txt", "");
+	Files::CreateFolder(config);
+
+	const char *argv[] = {"endless-sky-tests", "--resources", resources.c_str(), "--config", config.c_str(), nullptr};
+	Files::Init(argv);
+}
+
+// Store an image whose pixels are all the given value.
+void WriteImage(uint64_t key, uint32_t value)
+{
+	ImageBuffer buffer;
+	buffer.Allocate(16, 8);
+	for(int y = 0; y < buffer.Height(); ++y)
+		for(int x = 0; x < buffer.Width(); ++x)
+			buffer.Begin(y)[x] = value;
+	ImageCache::Write(key, buffer, 0);
+}
+
+// Check whether the given key is a cache hit, with the right pixels.
+bool ReadImage(uint64_t key, uint32_t value)
+{
+	ImageBuffer buffer;
+	if(!ImageCache::Read(key, buffer, 0))
+		return false;
+	return buffer.Width() == 16 && buffer.Height() == 8 && buffer.Begin(7)[15] == value;
+}
+
+// Make every cache entry look like it was last used when the game was last
+// launched, a day ago.
+void EndLaunch()
+{
+	std::time_t yesterday = std::time(nullptr) - 24 * 60 * 60;
+	utimbuf times;
+	times.actime = yesterday;
+	times.modtime = yesterday;
+	for(const std::string &path : Files::RecursiveList(Files::Config() + "cache/"))
+		utime(path.c_str(), &times);
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Reusing cached images on the next launch", "[ImageCache]" ) {
+	// The cache only looks up its directory once, so every run through this
+	// scenario must share one, with images of its own.
+	static TemporaryDirectory directory;
+	InitFiles(directory);
+	static uint64_t nextKey = 1;
+	const uint64_t keys[] = {nextKey, nextKey + 1, nextKey + 2, nextKey + 3};
+	nextKey += 4;
+
+	GIVEN( "a launch that decodes and caches some images" ) {
+		for(uint64_t key : keys)
+		{
+			REQUIRE_FALSE( ReadImage(key, 0) );
+			WriteImage(key, key * 0x01010101);
+		}
+		// Even with no space at all for unused entries, none of these are pruned.
+		ImageCache::Prune(0);
+		EndLaunch();
+
+		WHEN( "the game is launched again with the same images" ) {
+			THEN( "every image is a cache hit" ) {
+				for(uint64_t key : keys)
+					CHECK( ReadImage(key, key * 0x01010101) );
+			}
+			AND_WHEN( "the cache is pruned" ) {
+				for(uint64_t key : keys)
+					REQUIRE( ReadImage(key, key * 0x01010101) );
+				ImageCache::Prune(0);
+				EndLaunch();
+				THEN( "the launch after that gets only hits too" ) {
+					for(uint64_t key : keys)
+						CHECK( ReadImage(key, key * 0x01010101) );
+				}
+			}
+		}
+		WHEN( "the next launch only uses some of the images" ) {
+			REQUIRE( ReadImage(keys[0], keys[0] * 0x01010101) );
+			REQUIRE( ReadImage(keys[1], keys[1] * 0x01010101) );
+			ImageCache::Prune(0);
+			THEN( "only the unused ones are pruned" ) {
+				CHECK( ReadImage(keys[0], keys[0] * 0x01010101) );
+				CHECK( ReadImage(keys[1], keys[1] * 0x01010101) );
+				CHECK_FALSE( ReadImage(keys[2], keys[2] * 0x01010101) );
+				CHECK_FALSE( ReadImage(keys[3], keys[3] * 0x01010101) );
+			}
+		}
+		WHEN( "there is room for the unused images" ) {
+			REQUIRE( ReadImage(keys[0], keys[0] * 0x01010101) );
+			ImageCache::Prune();
+			THEN( "none of them are pruned" ) {
+				for(uint64_t key : keys)
+					CHECK( ReadImage(key, key * 0x01010101) );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,138 @@
+/* test_savedGame.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/SavedGame.h"
+
+// Include helpers for creating the files to read.
+#include "temporary-directory.hpp"
+#include "../../../source/Files.h"
+#include "../../../source/SaveWriter.h"
+
+// ... and any system includes needed for the test file.
+#include <ctime>
+#include <string>
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+namespace { // test namespace
+
+// #region mock data
+
+std::string SaveText(const std::string &pilot)
+{
+	return "pilot " + pilot + "\nsystem Sol\nplanet Earth\naccount\n\tcredits 1000\n";
+}
+
+void SetTimestamp(const std::string &path, std::time_t timestamp)
+{
+	utimbuf times;
+	times.actime = timestamp;
+	times.modtime = timestamp;
+	utime(path.c_str(), &times);
+}
+
+// The index is kept in the config directory, so the game's directories must
+// be set up, with the bare minimum of resources.
+void InitFiles(const TemporaryDirectory &directory)
+{
+	const std::string resources = directory.Path() + "resources/";
+	const std::string config = directory.Path() + "config/";
+	Files::CreateFolder(resources);
+	Files::CreateFolder(resources + "data/");
+	Files::CreateFolder(resources + "images/");
+	Files::CreateFolder(resources + "sounds/");
+	Files::Write(resources + "credits.txt", "");
+	Files::CreateFolder(config);
+
+	const char *argv[] = {"endless-sky-tests", "--resources", resources.c_str(), "--config", config.c_str(), nullptr};
+	Files::Init(argv);
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Loading saved games through the index", "[SavedGame]" ) {
+	TemporaryDirectory directory;
+	InitFiles(directory);
+	const std::string path = Files::Saves() + "Test Pilot.txt";
+
+	GIVEN( "a saved game that is in the index" ) {
+		REQUIRE( Files::Write(path, SaveText("Test Pilot")) );
+		// Give the index different contents than the file has, so that it is
+		// possible to tell which of them a saved game was loaded from.
+		SavedGame::AddToIndex(path, SaveText("Indexed Pilot"));
+		const std::time_t timestamp = Files::Timestamp(path);
+
+		WHEN( "the file has not changed" ) {
+			SavedGame save(path);
+			THEN( "the index is used" ) {
+				CHECK( save.IsLoaded() );
+				CHECK( save.Name() == "Indexed Pilot" );
+			}
+		}
+		WHEN( "the file changes size" ) {
+			REQUIRE( Files::Write(path, SaveText("Test Pilots")) );
+			SetTimestamp(path, timestamp);
+			SavedGame save(path);
+			THEN( "the file is read instead" ) {
+				CHECK( save.Name() == "Test Pilots" );
+			}
+		}
+		WHEN( "the file changes modification time" ) {
+			REQUIRE( Files::Write(path, SaveText("Best Pilot")) );
+			SetTimestamp(path, timestamp + 10);
+			SavedGame save(path);
+			THEN( "the file is read instead" ) {
+				CHECK( save.Name() == "Best Pilot" );
+			}
+		}
+		WHEN( "a new version of the file cannot be written" ) {
+			// A directory in the way of the temporary file makes the write fail.
+			Files::CreateFolder(path + ".tmp");
+			const bool written = SaveWriter::Write(path, SaveText("Best Pilot"));
+			Files::RmDir(path + ".tmp");
+			if(written)
+				SavedGame::AddToIndex(path, SaveText("Best Pilot"));
+			SavedGame save(path);
+			THEN( "the old file and its index entry are kept" ) {
+				CHECK_FALSE( written );
+				CHECK( Files::Read(path) == SaveText("Test Pilot") );
+				CHECK( save.Name() == "Indexed Pilot" );
+			}
+		}
+		WHEN( "the file is deleted" ) {
+			Files::Delete(path);
+			SavedGame save(path);
+			THEN( "nothing is loaded" ) {
+				CHECK_FALSE( save.IsLoaded() );
+			}
+		}
+	}
+	// The index may be written in the background after a miss.
+	SaveWriter::Wait();
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -167,6 +167,67 @@ SCENARIO( "A Set can be reverted to an earlier state", "[Set]" ) {
 				}
 			}
 		}
+
+		AND_GIVEN( "another Set<T> that tracks its changes" ) {
+			auto instance = original;
+			instance.TrackChanges();
+			REQUIRE_FALSE( instance.HasChanges() );
+			instance.Get("A")->a = 5;
+			instance.Get("D")->a = 3;
+			// A change that does not go through Get() is not tracked.
+			for(auto &it : instance)
+				if(it.first == "C")
+					it.second.a = 7;
+			// Neither is one made through FindUntracked().
+			instance.FindUntracked("B")->a = 4;
+			REQUIRE( instance.FindUntracked("E") == nullptr );
+			REQUIRE_FALSE( instance.Has("E") );
+			REQUIRE( instance.HasChanges() );
+
+			WHEN( "Revert is called on the instance with the original" ) {
+				instance.Revert(original);
+				THEN( "only the changed objects are reverted" ) {
+					CHECK( instance.Find("A")->a == 0 );
+					CHECK( instance.Find("B")->a == 4 );
+					CHECK( instance.Find("C")->a == 7 );
+					CHECK_FALSE( instance.Has("D") );
+					CHECK( instance.size() == original.size() );
+				}
+				THEN( "the changes are forgotten" ) {
+					CHECK_FALSE( instance.HasChanges() );
+				}
+			}
+			WHEN( "Revert is told to revert everything" ) {
+				instance.Get("B")->a = 6;
+				instance.Revert(original, true);
+				THEN( "every object is reverted" ) {
+					CHECK( instance.Find("A")->a == 0 );
+					CHECK( instance.Find("B")->a == 0 );
+					CHECK( instance.Find("C")->a == 0 );
+				}
+			}
+		}
+	}
+}
+
+SCENARIO( "Objects can be removed from a Set by name", "[Set]" ) {
+	GIVEN( "a Set<T> with some objects" ) {
+		auto instance = Set<T>{};
+		instance.Get("A")->a = 2;
+		instance.Get("B");
+		instance.Get("C");
+
+		WHEN( "only some of the names are retained" ) {
+			instance.Retain({"A", "C", "D"});
+			THEN( "the other objects are removed" ) {
+				CHECK( instance.size() == 2 );
+				CHECK_FALSE( instance.Has("B") );
+				CHECK_FALSE( instance.Has("D") );
+			}
+			THEN( "the retained objects are unchanged" ) {
+				CHECK( instance.Find("A")->a == 2 );
+			}
+		}
 	}
 }
 // #endregion unit tests
@@ -0,0 +1,147 @@
+/* test_setRef.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/SetRef.h"
+
+// ... and any system includes needed for the test file.
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+class T {
+public:
+	int a = 1;
+};
+
+// Count how many times the handles go to the set to look something up.
+int lookups = 0;
+Set<T> objects;
+
+const Set<T> &Objects()
+{
+	++lookups;
+	return objects;
+}
+
+using TRef = SetRef<T, &Objects>;
+
+// The names of the colors that Engine::Draw() used to look up by name each frame.
+const std::vector<std::string> FRAME_NAMES = {
+	"ship target outline player", "ship target outline friendly", "ship target outline unfriendly",
+	"ship target outline hostile", "ship target outline special", "ship target outline blink",
+	"ship target outline inactive", "planet target pointer friendly", "planet target pointer restricted",
+	"planet target pointer hostile", "planet target pointer dominated", "planet target pointer unfriendly",
+	"ship target pointer player", "ship target pointer friendly", "ship target pointer unfriendly",
+	"ship target pointer hostile", "ship target pointer special", "ship target pointer blink",
+	"ship target pointer inactive", "minable target pointer selected", "minable target pointer unselected",
+	"message importance default", "flagship highlight", "medium"
+};
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "a SetRef refers to one named object in a Set", "[SetRef]" ) {
+	GIVEN( "a handle to an object" ) {
+		lookups = 0;
+		const TRef ref("handle test");
+
+		THEN( "nothing is looked up until it is used" ) {
+			CHECK( lookups == 0 );
+		}
+		WHEN( "it is used" ) {
+			const T *object = ref.Get();
+			THEN( "it refers to the object with that name" ) {
+				CHECK( object == objects.Get("handle test") );
+				CHECK( &*ref == object );
+				CHECK( ref->a == 1 );
+			}
+			THEN( "the name is only looked up once" ) {
+				ref.Get();
+				ref.Get();
+				CHECK( lookups == 1 );
+			}
+		}
+		WHEN( "the object is changed after the handle is used" ) {
+			ref.Get();
+			objects.Get("handle test")->a = 5;
+			THEN( "the handle sees the change" ) {
+				CHECK( ref->a == 5 );
+			}
+		}
+	}
+}
+
+SCENARIO( "handles remove the per-frame lookups", "[SetRef]" ) {
+	GIVEN( "one handle for each name drawn in a frame" ) {
+		std::vector<std::unique_ptr<TRef>> refs;
+		for(const std::string &name : FRAME_NAMES)
+			refs.emplace_back(new TRef(name.c_str()));
+		const int frames = 60;
+
+		WHEN( "the objects are looked up by name every frame" ) {
+			lookups = 0;
+			for(int frame = 0; frame < frames; ++frame)
+				for(const std::string &name : FRAME_NAMES)
+					Objects().Get(name);
+			THEN( "there is one lookup per name per frame" ) {
+				CHECK( lookups == static_cast<int>(frames * FRAME_NAMES.size()) );
+			}
+		}
+		WHEN( "the objects are used through the handles every frame" ) {
+			lookups = 0;
+			for(int frame = 0; frame < frames; ++frame)
+				for(const auto &ref : refs)
+					ref->Get();
+			THEN( "there is only one lookup per name" ) {
+				CHECK( lookups == static_cast<int>(FRAME_NAMES.size()) );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark one frame of named lookups", "[!benchmark][SetRef]" ) {
+	std::vector<std::unique_ptr<TRef>> refs;
+	for(const std::string &name : FRAME_NAMES)
+		refs.emplace_back(new TRef(name.c_str()));
+
+	BENCHMARK( "Set::Get() by name" ) {
+		int sum = 0;
+		for(const std::string &name : FRAME_NAMES)
+			sum += Objects().Get(name)->a;
+		return sum;
+	};
+	BENCHMARK( "SetRef handles" ) {
+		int sum = 0;
+		for(const auto &ref : refs)
+			sum += (*ref)->a;
+		return sum;
+	};
+}
+#endif
+// #endregion benchmarks
+
+
+
+} // test namespace
@@ -0,0 +1,84 @@
+/* test_shelfPacker.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/ShelfPacker.h"
+
+namespace { // test namespace
+
+// #region unit tests
+SCENARIO( "Packing rectangles into shelves", "[ShelfPacker]" ) {
+	GIVEN( "an empty page with one pixel of padding" ) {
+		ShelfPacker packer(64, 1);
+		int x = -1;
+		int y = -1;
+
+		THEN( "the first rectangle is placed inside the padding of the top left corner" ) {
+			REQUIRE( packer.Place(10, 8, x, y) );
+			CHECK( x == 1 );
+			CHECK( y == 1 );
+		}
+		THEN( "a rectangle that only fits without the padding is refused" ) {
+			CHECK_FALSE( packer.Place(63, 10, x, y) );
+			CHECK( packer.Place(62, 10, x, y) );
+		}
+		WHEN( "a rectangle has been placed" ) {
+			packer.Place(10, 8, x, y);
+			THEN( "the next one on that shelf is placed after both their paddings" ) {
+				REQUIRE( packer.Place(6, 8, x, y) );
+				CHECK( x == 13 );
+				CHECK( y == 1 );
+			}
+			AND_THEN( "a shorter one also goes on that shelf" ) {
+				REQUIRE( packer.Place(6, 4, x, y) );
+				CHECK( y == 1 );
+			}
+			AND_THEN( "a taller one starts a new shelf below it" ) {
+				REQUIRE( packer.Place(6, 9, x, y) );
+				CHECK( x == 1 );
+				CHECK( y == 11 );
+			}
+			AND_THEN( "one that does not fit on the rest of the shelf starts a new shelf" ) {
+				REQUIRE( packer.Place(60, 8, x, y) );
+				CHECK( x == 1 );
+				CHECK( y == 11 );
+			}
+		}
+		WHEN( "there are shelves of different heights" ) {
+			packer.Place(50, 20, x, y);
+			packer.Place(20, 8, x, y);
+			THEN( "a rectangle goes on the shortest shelf that it fits on" ) {
+				REQUIRE( packer.Place(10, 6, x, y) );
+				CHECK( x == 23 );
+				CHECK( y == 23 );
+			}
+		}
+		WHEN( "the page is full" ) {
+			// Four shelves of 14 + 2 pixels fill the page exactly.
+			for(int i = 0; i < 4; ++i)
+				REQUIRE( packer.Place(62, 14, x, y) );
+			THEN( "nothing else fits on it" ) {
+				CHECK_FALSE( packer.Place(1, 1, x, y) );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,191 @@
+/* test_textureBudget.cpp
+Copyright (c) 2026 by the Endless Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/TextureBudget.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+
+// The budget never looks inside the sprites, so any distinct addresses will do.
+// The step in which each of them was last drawn is kept here instead.
+char storage[3];
+std::map<const Sprite *, uint64_t> lastUse;
+const Sprite *const first = reinterpret_cast<const Sprite *>(&storage[0]);
+const Sprite *const second = reinterpret_cast<const Sprite *>(&storage[1]);
+const Sprite *const third = reinterpret_cast<const Sprite *>(&storage[2]);
+
+bool Always(const Sprite *)
+{
+	return true;
+}
+
+uint64_t LastUse(const Sprite *sprite)
+{
+	return lastUse[sprite];
+}
+
+void Use(const TextureBudget &budget, const Sprite *sprite)
+{
+	lastUse[sprite] = budget.Step();
+}
+
+// Let enough frames pass that no sprite counts as recently drawn. The limit is
+// lifted meanwhile, so that nothing is evicted and no evictions are put off.
+void Wait(TextureBudget &budget)
+{
+	size_t limit = budget.Limit();
+	budget.SetLimit(0);
+	for(int i = 0; i < 200; ++i)
+		budget.Evict(Always, LastUse);
+	budget.SetLimit(limit);
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Keeping track of the memory used by textures", "[TextureBudget]" ) {
+	GIVEN( "a budget with some sprites loaded" ) {
+		TextureBudget budget;
+		budget.Add(first, 100);
+		budget.Add(first, 300);
+		budget.Add(second, 200);
+		THEN( "the textures of each sprite are added up" ) {
+			CHECK( budget.ResidentBytes() == 600 );
+		}
+		WHEN( "a sprite is unloaded" ) {
+			budget.Remove(first);
+			THEN( "all of its textures are subtracted" ) {
+				CHECK( budget.ResidentBytes() == 200 );
+			}
+			AND_THEN( "removing it again does nothing" ) {
+				budget.Remove(first);
+				CHECK( budget.ResidentBytes() == 200 );
+			}
+		}
+		WHEN( "there is no limit" ) {
+			Wait(budget);
+			THEN( "nothing is evicted" ) {
+				CHECK( budget.Evict(Always, LastUse).empty() );
+				CHECK( budget.EvictionsPerMinute() == 0 );
+			}
+		}
+	}
+}
+
+SCENARIO( "Evicting the least recently drawn sprites", "[TextureBudget]" ) {
+	GIVEN( "three sprites that use more memory than the limit" ) {
+		lastUse.clear();
+		TextureBudget budget;
+		budget.SetLimit(150);
+		budget.Add(first, 100);
+		budget.Add(second, 100);
+		budget.Add(third, 100);
+		WHEN( "the sprites were all drawn recently" ) {
+			Use(budget, first);
+			Use(budget, second);
+			Use(budget, third);
+			THEN( "none of them are evicted" ) {
+				CHECK( budget.Evict(Always, LastUse).empty() );
+				CHECK( budget.ResidentBytes() == 300 );
+			}
+		}
+		WHEN( "one of them was drawn recently" ) {
+			Wait(budget);
+			Use(budget, second);
+			std::vector<const Sprite *> evicted = budget.Evict(Always, LastUse);
+			THEN( "the others are evicted until the textures fit the limit" ) {
+				REQUIRE( evicted.size() == 2 );
+				CHECK( std::find(evicted.begin(), evicted.end(), second) == evicted.end() );
+				CHECK( budget.ResidentBytes() == 100 );
+				CHECK( budget.EvictionsPerMinute() == 2 );
+			}
+		}
+		WHEN( "the least recently drawn sprite cannot be evicted" ) {
+			budget.SetLimit(0);
+			Wait(budget);
+			Use(budget, third);
+			Wait(budget);
+			Use(budget, second);
+			Wait(budget);
+			budget.SetLimit(150);
+			std::vector<const Sprite *> evicted = budget.Evict(
+				[](const Sprite *sprite) -> bool { return sprite != first; }, LastUse);
+			THEN( "the next least recently drawn one is evicted instead" ) {
+				REQUIRE( evicted.size() == 2 );
+				CHECK( evicted[0] == third );
+				CHECK( evicted[1] == second );
+				CHECK( budget.ResidentBytes() == 100 );
+			}
+		}
+		WHEN( "the limit is raised" ) {
+			Wait(budget);
+			budget.SetLimit(300);
+			THEN( "nothing needs to be evicted" ) {
+				CHECK( budget.Evict(Always, LastUse).empty() );
+			}
+		}
+		WHEN( "a sprite is drawn again after the textures went over the limit" ) {
+			Wait(budget);
+			Use(budget, first);
+			Wait(budget);
+			std::vector<const Sprite *> evicted = budget.Evict(Always, LastUse);
+			THEN( "it is evicted after the sprites that were not" ) {
+				REQUIRE( evicted.size() == 2 );
+				CHECK( evicted[0] == second );
+				CHECK( evicted[1] == third );
+				CHECK( budget.ResidentBytes() == 100 );
+			}
+		}
+		WHEN( "none of the sprites can be evicted" ) {
+			Wait(budget);
+			int checked = 0;
+			auto Counted = [&checked](const Sprite *) -> bool { ++checked; return false; };
+			REQUIRE( budget.Evict(Counted, LastUse).empty() );
+			REQUIRE( checked == 3 );
+			THEN( "the sprites are not checked again for a while" ) {
+				for(int i = 0; i < 50; ++i)
+					budget.Evict(Counted, LastUse);
+				CHECK( checked == 3 );
+			}
+			THEN( "they are checked again later" ) {
+				for(int i = 0; i < 100; ++i)
+					budget.Evict(Counted, LastUse);
+				CHECK( checked > 3 );
+				CHECK( checked < 3 * 100 );
+			}
+			THEN( "changing the limit checks them right away" ) {
+				budget.SetLimit(200);
+				CHECK( budget.Evict(Always, LastUse).size() == 1 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace